@@ -29,6 +29,7 @@
 /* USER CODE BEGIN Includes */
 #include "FreeRTOS.h"
 #include "SEGGER_SYSVIEW.h"
+#include "capture.h"
 #include "gps.h"
 #include "gps_app.h"
 #include "gsm_app.h"
@@ -111,6 +112,7 @@ void initThread(void *pvParameter) {
 	flash_params_set_ntrip_pw("1234");
 
   led_init();
+  capture_init();
   gps_init_all();
   
   if(config->board == BOARD_TYPE_BASE_F9P || config->board == BOARD_TYPE_BASE_UM982)
@@ -6,27 +6,51 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../lib/gps/gps.c \
+../lib/gps/gps_coord.c \
+../lib/gps/gps_crc.c \
+../lib/gps/gps_evt_queue.c \
 ../lib/gps/gps_nmea.c \
-../lib/gps/gps_parse.c \
+../lib/gps/gps_snapshot.c \
 ../lib/gps/gps_ubx.c \
 ../lib/gps/gps_unicore.c \
-../lib/gps/rtcm.c 
+../lib/gps/rtcm.c \
+../lib/gps/rtcm_fec.c \
+../lib/gps/rtcm_msm.c \
+../lib/gps/rtcm_reasm.c \
+../lib/gps/rtcm_sched.c \
+../lib/gps/rtcm_station.c 
 
 OBJS += \
 ./lib/gps/gps.o \
+./lib/gps/gps_coord.o \
+./lib/gps/gps_crc.o \
+./lib/gps/gps_evt_queue.o \
 ./lib/gps/gps_nmea.o \
-./lib/gps/gps_parse.o \
+./lib/gps/gps_snapshot.o \
 ./lib/gps/gps_ubx.o \
 ./lib/gps/gps_unicore.o \
-./lib/gps/rtcm.o 
+./lib/gps/rtcm.o \
+./lib/gps/rtcm_fec.o \
+./lib/gps/rtcm_msm.o \
+./lib/gps/rtcm_reasm.o \
+./lib/gps/rtcm_sched.o \
+./lib/gps/rtcm_station.o 
 
 C_DEPS += \
 ./lib/gps/gps.d \
+./lib/gps/gps_coord.d \
+./lib/gps/gps_crc.d \
+./lib/gps/gps_evt_queue.d \
 ./lib/gps/gps_nmea.d \
-./lib/gps/gps_parse.d \
+./lib/gps/gps_snapshot.d \
 ./lib/gps/gps_ubx.d \
 ./lib/gps/gps_unicore.d \
-./lib/gps/rtcm.d 
+./lib/gps/rtcm.d \
+./lib/gps/rtcm_fec.d \
+./lib/gps/rtcm_msm.d \
+./lib/gps/rtcm_reasm.d \
+./lib/gps/rtcm_sched.d \
+./lib/gps/rtcm_station.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -36,7 +60,7 @@ lib/gps/%.o lib/gps/%.su lib/gps/%.cyclo: ../lib/gps/%.c lib/gps/subdir.mk
 clean: clean-lib-2f-gps
 
 clean-lib-2f-gps:
-	-$(RM) ./lib/gps/gps.cyclo ./lib/gps/gps.d ./lib/gps/gps.o ./lib/gps/gps.su ./lib/gps/gps_nmea.cyclo ./lib/gps/gps_nmea.d ./lib/gps/gps_nmea.o ./lib/gps/gps_nmea.su ./lib/gps/gps_parse.cyclo ./lib/gps/gps_parse.d ./lib/gps/gps_parse.o ./lib/gps/gps_parse.su ./lib/gps/gps_ubx.cyclo ./lib/gps/gps_ubx.d ./lib/gps/gps_ubx.o ./lib/gps/gps_ubx.su ./lib/gps/gps_unicore.cyclo ./lib/gps/gps_unicore.d ./lib/gps/gps_unicore.o ./lib/gps/gps_unicore.su ./lib/gps/rtcm.cyclo ./lib/gps/rtcm.d ./lib/gps/rtcm.o ./lib/gps/rtcm.su
+	-$(RM) ./lib/gps/gps.cyclo ./lib/gps/gps.d ./lib/gps/gps.o ./lib/gps/gps.su ./lib/gps/gps_coord.cyclo ./lib/gps/gps_coord.d ./lib/gps/gps_coord.o ./lib/gps/gps_coord.su ./lib/gps/gps_crc.cyclo ./lib/gps/gps_crc.d ./lib/gps/gps_crc.o ./lib/gps/gps_crc.su ./lib/gps/gps_evt_queue.cyclo ./lib/gps/gps_evt_queue.d ./lib/gps/gps_evt_queue.o ./lib/gps/gps_evt_queue.su ./lib/gps/gps_nmea.cyclo ./lib/gps/gps_nmea.d ./lib/gps/gps_nmea.o ./lib/gps/gps_nmea.su ./lib/gps/gps_snapshot.cyclo ./lib/gps/gps_snapshot.d ./lib/gps/gps_snapshot.o ./lib/gps/gps_snapshot.su ./lib/gps/gps_ubx.cyclo ./lib/gps/gps_ubx.d ./lib/gps/gps_ubx.o ./lib/gps/gps_ubx.su ./lib/gps/gps_unicore.cyclo ./lib/gps/gps_unicore.d ./lib/gps/gps_unicore.o ./lib/gps/gps_unicore.su ./lib/gps/rtcm.cyclo ./lib/gps/rtcm.d ./lib/gps/rtcm.o ./lib/gps/rtcm.su ./lib/gps/rtcm_fec.cyclo ./lib/gps/rtcm_fec.d ./lib/gps/rtcm_fec.o ./lib/gps/rtcm_fec.su ./lib/gps/rtcm_msm.cyclo ./lib/gps/rtcm_msm.d ./lib/gps/rtcm_msm.o ./lib/gps/rtcm_msm.su ./lib/gps/rtcm_reasm.cyclo ./lib/gps/rtcm_reasm.d ./lib/gps/rtcm_reasm.o ./lib/gps/rtcm_reasm.su ./lib/gps/rtcm_sched.cyclo ./lib/gps/rtcm_sched.d ./lib/gps/rtcm_sched.o ./lib/gps/rtcm_sched.su ./lib/gps/rtcm_station.cyclo ./lib/gps/rtcm_station.d ./lib/gps/rtcm_station.o ./lib/gps/rtcm_station.su
 
 .PHONY: clean-lib-2f-gps
 
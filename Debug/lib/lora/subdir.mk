@@ -5,13 +5,19 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../lib/lora/lora.c 
+../lib/lora/lora.c \
+../lib/lora/lora_airtime.c \
+../lib/lora/lora_line.c 
 
 OBJS += \
-./lib/lora/lora.o 
+./lib/lora/lora.o \
+./lib/lora/lora_airtime.o \
+./lib/lora/lora_line.o 
 
 C_DEPS += \
-./lib/lora/lora.d 
+./lib/lora/lora.d \
+./lib/lora/lora_airtime.d \
+./lib/lora/lora_line.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -21,7 +27,7 @@ lib/lora/%.o lib/lora/%.su lib/lora/%.cyclo: ../lib/lora/%.c lib/lora/subdir.mk
 clean: clean-lib-2f-lora
 
 clean-lib-2f-lora:
-	-$(RM) ./lib/lora/lora.cyclo ./lib/lora/lora.d ./lib/lora/lora.o ./lib/lora/lora.su
+	-$(RM) ./lib/lora/lora.cyclo ./lib/lora/lora.d ./lib/lora/lora.o ./lib/lora/lora.su ./lib/lora/lora_airtime.cyclo ./lib/lora/lora_airtime.d ./lib/lora/lora_airtime.o ./lib/lora/lora_airtime.su ./lib/lora/lora_line.cyclo ./lib/lora/lora_line.d ./lib/lora/lora_line.o ./lib/lora/lora_line.su
 
 .PHONY: clean-lib-2f-lora
 
@@ -5,12 +5,15 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../lib/parser/nmea_index.c \
 ../lib/parser/parser.c 
 
 OBJS += \
+./lib/parser/nmea_index.o \
 ./lib/parser/parser.o 
 
 C_DEPS += \
+./lib/parser/nmea_index.d \
 ./lib/parser/parser.d 
 
 
@@ -21,7 +24,7 @@ lib/parser/%.o lib/parser/%.su lib/parser/%.cyclo: ../lib/parser/%.c lib/parser/
 clean: clean-lib-2f-parser
 
 clean-lib-2f-parser:
-	-$(RM) ./lib/parser/parser.cyclo ./lib/parser/parser.d ./lib/parser/parser.o ./lib/parser/parser.su
+	-$(RM) ./lib/parser/nmea_index.cyclo ./lib/parser/nmea_index.d ./lib/parser/nmea_index.o ./lib/parser/nmea_index.su ./lib/parser/parser.cyclo ./lib/parser/parser.d ./lib/parser/parser.o ./lib/parser/parser.su
 
 .PHONY: clean-lib-2f-parser
 
@@ -29,6 +29,7 @@ config \
 lib/gps \
 lib/gsm \
 lib/led \
+lib/log \
 lib/lora \
 lib/parser \
 lib/rs485 \
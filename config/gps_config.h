@@ -3,7 +3,98 @@
 
 #define USE_STORE_RAW_GGA
 
+/*
+ * NMEA 문장별 디코더 (GGA, THS 는 항상 사용)
+ * 정의하지 않은 문장은 디코더와 저장 공간이 빌드에서 빠지고, 주소 필드 비교만 한다.
+ * RMC 는 정의하지 않아도 기존처럼 이벤트만 발생한다.
+ */
+// #define USE_GPS_NMEA_RMC
+// #define USE_GPS_NMEA_GST
+// #define USE_GPS_NMEA_GSA
+// #define USE_GPS_NMEA_GSV
+// #define USE_GPS_NMEA_VTG
+// #define USE_GPS_NMEA_ZDA
+
+/*
+ * UBX 메시지별 디코더 (HPPOSLLH, RELPOSNED 는 항상 사용)
+ * 정의하지 않은 메시지는 이벤트만 발생하고 저장 공간이 빌드에서 빠진다.
+ */
+// #define USE_GPS_UBX_NAV_PVT
+// #define USE_GPS_UBX_NAV_SAT
+// #define USE_GPS_UBX_NAV_SIG
+// #define USE_GPS_UBX_NAV_SVIN
+// #define USE_GPS_UBX_RXM_RTCM
+
+/*
+ * UNICORE 바이너리 로그별 디코더 (BESTNAVB 는 항상 사용)
+ * 정의하지 않은 로그는 이벤트만 발생하고 저장 공간이 빌드에서 빠진다.
+ * HEADING 을 정의하면 UM982 rover 는 GPTHS 대신 HEADINGB 로 방위를 받는다.
+ */
+// #define USE_GPS_UNICORE_HEADING
+// #define USE_GPS_UNICORE_PVTSLN
+// #define USE_GPS_UNICORE_OBSVM
+// #define USE_GPS_UNICORE_BESTNAVXYZ
+
 // #define USE_GPS_UBLOX
 // #define USE_GPS_UNICORE
 
+/*
+ * 프레임 수신 도중 이 시간(ms) 이상 데이터가 없으면 미완성 프레임을 버리고
+ * 버퍼에 남은 바이트에서 다시 동기한다. 0 이면 사용하지 않음.
+ */
+#define GPS_FRAME_STALL_MS 1000
+
+#define USE_GPS_PARSE_CYCLES ///< 이벤트 핸들러 처리 시간을 DWT 사이클 카운터로 측정
+
+#define USE_GPS_HW_CRC32 ///< UNICORE 바이너리 CRC32 를 STM32 CRC 유닛으로 계산
+
+/*
+ * 기지국 RTCM MSM 을 LoRa 로 보내기 전에 epoch 당 바이트 예산에 맞춘다.
+ * 넘치면 MSM5~7 을 MSM4 로 내리고, 같은 대역의 중복 신호, CNR 이 낮은 위성 순으로 뺀다.
+ * 최소 위성 수까지 줄여도 넘치는 메시지는 버린다.
+ *
+ * GPS_RTCM_EPOCH_BUDGET 이 0 이면 현재 P2P 설정에서 118 byte fragment 하나를 보내는
+ * 시간 (lora_p2p_send_ms, 실측 하한 포함) 으로 GPS_RTCM_EPOCH_MS 동안 보낼 수 있는
+ * 바이트의 GPS_RTCM_EPOCH_LINK_PCT % 를 쓴다. SF7/BW500 실측 350ms/118 byte 이면
+ * 약 337 byte/s 이므로 320 이 된다.
+ *
+ * GPS_RTCM_MSM_PRIORITY 의 시스템 (RTCM_MSM_SYS_* bit) 은 몫이 작아도 최소 위성 수
+ * MSM4 는 보내고, 예산이 모자라면 다른 시스템이 먼저 버려진다.
+ */
+#define USE_GPS_RTCM_MSM_TRIM
+#define GPS_RTCM_EPOCH_BUDGET 0 ///< epoch 당 바이트 (0: LoRa 설정으로 계산)
+#define GPS_RTCM_EPOCH_MS 1000 ///< MSM 출력 주기 (1Hz)
+#define GPS_RTCM_EPOCH_LINK_PCT 95
+#define GPS_RTCM_MSM_TO_MSM4 1
+#define GPS_RTCM_MSM_PRIORITY 0x01 ///< GPS
+
+/*
+ * LoRa TX 큐가 쌓이거나 점유율이 높으면 MSM 을 시스템별로 돌아가며 보내고
+ * 스테이션 메시지 (1005/1006/1033) 간격을 늘린다. 주기 표는 gps_app.c 에 있다.
+ */
+#define USE_GPS_RTCM_SCHED
+
+/*
+ * rover 는 LoRa 로 받은 1005/1006/1033 을 보관해 GPS_RTCM_STATION_INJECT_MS 마다
+ * GPS 로 다시 넣는다. 기지국은 (USE_GPS_RTCM_SCHED) 내용이 바뀔 때와
+ * GPS_RTCM_STATION_INTERVAL_MS 마다만 보낸다. 새로 켜진 rover 는 이 주기 안에 받는다.
+ */
+#define USE_GPS_RTCM_STATION_CACHE
+#define GPS_RTCM_STATION_INJECT_MS 10000
+#define GPS_RTCM_STATION_INTERVAL_MS 60000
+#define GPS_RTCM_STATION_MAX_AGE_MS 300000 ///< 이 시간 동안 다시 받지 못하면 재주입 중단
+
+/*
+ * 기지국은 epoch 단위 RTCM 블록 뒤에 XOR parity fragment 를 붙여 보내고 (데이터 대비
+ * GPS_RTCM_FEC_PARITY_PCT %), rover 는 재전송 없이 잃은 fragment 를 복구한다.
+ * FEC 를 켠 기지국에는 FEC 를 켠 rover 가 필요하다 (rover 는 FEC 없는 fragment 도 받는다).
+ * FEC 를 끈 rover 는 FEC 패킷을 버리고, FEC 이전 펌웨어의 rover 는 받지 못한다.
+ *
+ * 기본은 끔. fec_bench.c 기준으로 손실이 낮은 링크에서는 parity 만큼 airtime 과
+ * MSM 예산 (GPS_RTCM_EPOCH_BUDGET) 을 잃는 쪽이 더 크다. 현장에서 fragment 손실을
+ * 측정해 (AT+LORARX? 의 crc_fail/partial_drops) 이득이 확인된 뒤에 켠다.
+ */
+// #define USE_GPS_RTCM_FEC
+#define GPS_RTCM_FEC_PARITY_PCT 25
+
 #endif
\ No newline at end of file
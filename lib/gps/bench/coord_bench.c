@@ -0,0 +1,199 @@
+/**
+ * @file coord_bench.c
+ * @brief gps_coord 고정소수점 좌표 벤치마크 (펌웨어 빌드에서 제외)
+ *
+ * 한 epoch = GGA 위도/경도/고도 파싱 + "+GPS,..." 위치 문자열 포맷.
+ * 기존 double 경로(gps_parse_double, parse_lat_lon, sprintf %.9lf)와 비교한다.
+ *
+ * @note 호스트 빌드/실행 (lib/gps/bench 에서)
+ * gcc -O2 -I.. -I../../parser coord_bench.c ../gps_coord.c -o coord_bench && ./coord_bench
+ * @note 타겟: coord_bench.c 와 gps_coord.c 를 임시로 빌드에 넣고 태스크에서
+ * coord_bench_main() 을 호출하면 DWT 사이클 카운터로 측정해 printf 로 출력한다.
+ */
+#include "gps_coord.h"
+#include "parser.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(STM32F405xx)
+#include "stm32f4xx.h"
+#define BENCH_ITER 200
+#define BENCH_UNIT "cycles"
+
+static void bench_init(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t bench_now(void) { return DWT->CYCCNT; }
+#else
+#include <time.h>
+#define BENCH_ITER 200000
+#define BENCH_UNIT "ns"
+
+static void bench_init(void) {}
+
+static inline uint32_t bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+#endif
+
+typedef struct {
+  const char *lat;
+  const char *lon;
+  const char *alt;
+} gga_term_t;
+
+static const gga_term_t terms[] = {
+    {"4717.11399", "00833.91590", "499.6"},
+    {"3724.81689452", "12707.52734374", "62.0923"},
+    {"0000.00000001", "17959.99999999", "-12.345"},
+    {"8959.99999", "00000.00001", "8848.86"},
+    {"3330.12345678", "07030.87654321", "0.001"},
+};
+
+#define TERM_CNT (sizeof(terms) / sizeof(terms[0]))
+
+/**
+ * @brief 기존 gps_parse.c 의 gps_parse_double
+ */
+static double parse_double_ref(const char *term) {
+  double val = 0;
+  double power = 1;
+  double sign = 1;
+
+  if (*term == '-') {
+    sign = -1;
+    ++term;
+  }
+  while (PARSER_CHAR_IS_NUM(*term)) {
+    val = val * (double)10 + PARSER_CHAR_DEC_TO_NUM(*term);
+    ++term;
+  }
+  if (*term == '.') {
+    ++term;
+  }
+  while (PARSER_CHAR_IS_NUM(*term)) {
+    val = val * (double)10 + PARSER_CHAR_DEC_TO_NUM(*term);
+    power *= (double)10;
+    ++term;
+  }
+
+  return sign * val / power;
+}
+
+/**
+ * @brief 기존 gps_nmea.c 의 parse_lat_lon
+ */
+static double parse_lat_lon_ref(const char *term) {
+  double val, deg, min;
+
+  val = parse_double_ref(term);
+  deg = (double)((int)(((int)val / 100)));
+  min = val - (deg * (double)100);
+  val = deg + (min / (double)(60));
+
+  return val;
+}
+
+static volatile int sink;
+
+/* gps_nmea.c field_lat_lon() 과 같은 경로 (nmea_field_fixed + ddmm 변환) */
+static int64_t parse_nmea(const char *str) {
+  return gps_coord_ndeg_from_ddmm(gps_coord_parse_fixed(str, 9, NULL));
+}
+
+static int epoch_double(const gga_term_t *t, char *buf) {
+  double lat = parse_lat_lon_ref(t->lat);
+  double lon = parse_lat_lon_ref(t->lon);
+  double alt = parse_double_ref(t->alt);
+
+  return sprintf(buf, "+GPS,%.9lf,N,%.9lf,E,%.4lf,%.4lf,%.5lf,%d,%d\r", lat,
+                 lon, alt, alt, 123.45678, 4, 20);
+}
+
+static int epoch_fixed(const gga_term_t *t, char *buf) {
+  char lat_str[24], lon_str[24], alt_str[20], heading_str[16];
+  int64_t lat = parse_nmea(t->lat);
+  int64_t lon = parse_nmea(t->lon);
+  int64_t alt = gps_coord_parse_fixed(t->alt, 3, NULL);
+
+  gps_coord_format_fixed(lat_str, sizeof(lat_str), lat, 9, 9);
+  gps_coord_format_fixed(lon_str, sizeof(lon_str), lon, 9, 9);
+  gps_coord_format_fixed(alt_str, sizeof(alt_str), alt, 3, 4);
+  gps_coord_format_fixed(heading_str, sizeof(heading_str), 12345678, 5, 5);
+
+  return sprintf(buf, "+GPS,%s,N,%s,E,%s,%s,%s,%d,%d\r", lat_str, lon_str,
+                 alt_str, alt_str, heading_str, 4, 20);
+}
+
+static int verify(void) {
+  char a[128], b[128];
+
+  for (size_t i = 0; i < TERM_CNT; i++) {
+    int64_t lat = parse_nmea(terms[i].lat);
+    double ref = parse_lat_lon_ref(terms[i].lat);
+
+    /* double 경로는 1e-9 deg 근처에서 반올림 오차가 있으므로 2 ndeg 까지 허용 */
+    if (fabs((double)lat - ref * 1e9) > 2.0) {
+      printf("lat mismatch: %s %lld vs %.3f\r\n", terms[i].lat, (long long)lat,
+             ref * 1e9);
+      return 1;
+    }
+
+    epoch_double(&terms[i], a);
+    epoch_fixed(&terms[i], b);
+    printf("double: %s\nfixed : %s\n", a, b);
+  }
+
+  gps_coord_format_fixed(a, sizeof(a), -5, 9, 9);
+  if (strcmp(a, "-0.000000005") != 0) {
+    printf("negative format mismatch: %s\r\n", a);
+    return 1;
+  }
+  if (gps_coord_parse_fixed("-12.3456", 3, NULL) != -12346 ||
+      gps_coord_parse_fixed("7", 3, NULL) != 7000) {
+    printf("fixed parse mismatch\r\n");
+    return 1;
+  }
+
+  printf("verify OK\r\n");
+  return 0;
+}
+
+static uint32_t bench(int (*fn)(const gga_term_t *, char *)) {
+  char buf[128];
+  uint32_t start = bench_now();
+
+  for (int i = 0; i < BENCH_ITER; i++) {
+    sink += fn(&terms[i % TERM_CNT], buf);
+  }
+
+  return (bench_now() - start) / BENCH_ITER;
+}
+
+#if defined(STM32F405xx)
+int coord_bench_main(void)
+#else
+int main(void)
+#endif
+{
+  bench_init();
+
+  if (verify()) {
+    return 1;
+  }
+
+  uint32_t t_double = bench(epoch_double);
+  uint32_t t_fixed = bench(epoch_fixed);
+
+  printf("double epoch: %lu %s\r\n", (unsigned long)t_double, BENCH_UNIT);
+  printf("fixed  epoch: %lu %s\r\n", (unsigned long)t_fixed, BENCH_UNIT);
+
+  return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file fec_bench.c
+ * @brief rtcm_fec 손실 주입 호스트 테스트 (펌웨어 빌드에서 제외)
+ *
+ * 기지국 1Hz RTCM 스트림 (trim 된 MSM4 4종 + 10 epoch 마다 1006) 을 FEC 블록으로 보내고
+ * 패킷 손실 패턴 (독립 손실, Gilbert-Elliott 버스트) 을 넣어 rover 에서 CRC 가 맞는
+ * 프레임 전달률과 소비한 airtime 을 비교한다. "raw" 는 FEC 헤더 없이 프레임별로
+ * 118 byte 씩 나눠 보내는 기존 방식 (fragment 하나만 잃어도 프레임 손실) 이다.
+ *
+ * airtime 은 기지국 설정 (SF7, BW500kHz, CR4/5, Preamble 8) 의 Semtech ToA 식으로 센다.
+ *
+ * @note 빌드/실행 (lib/gps/bench 에서)
+ * gcc -O2 -I.. -I../../lora -I../../../config fec_bench.c ../rtcm_fec.c ../gps_crc.c ../../lora/lora_airtime.c -o fec_bench && ./fec_bench
+ */
+#include "gps_crc.h"
+#include "lora_airtime.h"
+#include "rtcm_fec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_EPOCHS 20000
+#define BENCH_RAW_FRAG 118
+
+typedef struct {
+  const char *name;
+  double p_gb; ///< good -> bad 전이 확률
+  double p_bg; ///< bad -> good 전이 확률
+  double loss_good;
+  double loss_bad;
+} loss_model_t;
+
+static const loss_model_t models[] = {
+  {"iid 1%", 0, 1, 0.01, 0},
+  {"iid 5%", 0, 1, 0.05, 0},
+  {"iid 10%", 0, 1, 0.10, 0},
+  {"iid 20%", 0, 1, 0.20, 0},
+  {"burst 5% (len 3)", 0.0175, 0.333, 0, 1.0},
+  {"burst 10% (len 3)", 0.037, 0.333, 0, 1.0},
+};
+
+static const int parity_pcts[] = {-1, 0, 25, 50, 100}; // -1: raw
+
+static const uint16_t epoch_types[] = {1074, 1084, 1094, 1124};
+// GPS_RTCM_EPOCH_BUDGET 320 으로 trim 된 뒤의 크기
+static const uint16_t epoch_sizes[] = {110, 80, 90, 60};
+
+static uint64_t rnd_state = 88172645463325252ULL;
+
+static double rnd01(void) {
+  rnd_state ^= rnd_state << 13;
+  rnd_state ^= rnd_state >> 7;
+  rnd_state ^= rnd_state << 17;
+  return (rnd_state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+typedef struct {
+  const loss_model_t *model;
+  bool bad;
+} channel_t;
+
+static bool channel_lost(channel_t *ch) {
+  const loss_model_t *m = ch->model;
+
+  if (ch->bad) {
+    if (rnd01() < m->p_bg) {
+      ch->bad = false;
+    }
+  } else if (rnd01() < m->p_gb) {
+    ch->bad = true;
+  }
+  return rnd01() < (ch->bad ? m->loss_bad : m->loss_good);
+}
+
+static const lora_phy_params_t phy = {7, 2, 1, 8, true, false};
+
+static uint32_t toa_us(size_t len) { return lora_toa_us(&phy, len); }
+
+static size_t make_frame(uint8_t *f, uint16_t type, uint16_t size, uint32_t seq) {
+  uint16_t plen = size - 6;
+
+  f[0] = 0xD3;
+  f[1] = (plen >> 8) & 0x03;
+  f[2] = plen & 0xFF;
+  f[3] = type >> 4;
+  f[4] = (type & 0x0F) << 4;
+  for (uint16_t i = 5; i < plen + 3; i++) {
+    f[i] = (uint8_t)(seq * 31 + i * 7);
+  }
+  uint32_t crc = gps_crc24q(f, plen + 3);
+  f[plen + 3] = crc >> 16;
+  f[plen + 4] = crc >> 8;
+  f[plen + 5] = crc;
+  return size;
+}
+
+/**
+ * @brief 복구된 블록을 프레임 단위로 검사
+ */
+static uint32_t count_frames(const uint8_t *data, size_t len) {
+  uint32_t n = 0;
+  size_t off = 0;
+
+  while (off + 6 <= len && data[off] == 0xD3) {
+    size_t flen = (((data[off + 1] & 0x03) << 8) | data[off + 2]) + 6;
+    if (off + flen > len) {
+      break;
+    }
+    uint32_t crc = gps_crc24q(&data[off], flen - 3);
+    if (data[off + flen - 3] == ((crc >> 16) & 0xFF) &&
+        data[off + flen - 2] == ((crc >> 8) & 0xFF) &&
+        data[off + flen - 1] == (crc & 0xFF)) {
+      n++;
+    }
+    off += flen;
+  }
+  return n;
+}
+
+typedef struct {
+  uint32_t frames;
+  uint32_t delivered;
+  uint64_t airtime_us;
+  uint32_t pkts;
+} result_t;
+
+static rtcm_fec_tx_t tx;
+static rtcm_fec_rx_t rx;
+
+static void fec_send_block(channel_t *ch, result_t *r) {
+  static uint8_t out[RTCM_FEC_OUT_MAX];
+  uint8_t pkt[RTCM_FEC_PKT_MAX];
+  uint8_t n = rtcm_fec_tx_finish(&tx);
+
+  for (uint8_t i = 0; i < n; i++) {
+    size_t len = rtcm_fec_tx_packet(&tx, i, pkt);
+    r->airtime_us += toa_us(len);
+    r->pkts++;
+    if (channel_lost(ch)) {
+      continue;
+    }
+    size_t dlen = rtcm_fec_rx_push(&rx, pkt, len, out, sizeof(out));
+    if (dlen) {
+      r->delivered += count_frames(out, dlen);
+    }
+  }
+  rtcm_fec_tx_next(&tx);
+}
+
+static void run(const loss_model_t *model, int pct, result_t *r) {
+  channel_t ch = {model, false};
+  uint8_t frame[1029];
+
+  memset(r, 0, sizeof(*r));
+  rnd_state = 88172645463325252ULL;
+  if (pct >= 0) {
+    rtcm_fec_tx_init(&tx, (uint8_t)pct);
+    rtcm_fec_rx_init(&rx);
+  }
+
+  for (uint32_t e = 0; e < BENCH_EPOCHS; e++) {
+    size_t cnt = sizeof(epoch_types) / sizeof(epoch_types[0]);
+    for (size_t i = 0; i <= cnt; i++) {
+      size_t len;
+      if (i == cnt) {
+        if (e % 10) {
+          continue;
+        }
+        len = make_frame(frame, 1006, 27, e);
+      } else {
+        len = make_frame(frame, epoch_types[i], epoch_sizes[i], e);
+      }
+      r->frames++;
+
+      if (pct < 0) {
+        bool ok = true;
+        for (size_t off = 0; off < len; off += BENCH_RAW_FRAG) {
+          size_t flen = len - off > BENCH_RAW_FRAG ? BENCH_RAW_FRAG : len - off;
+          r->airtime_us += toa_us(flen);
+          r->pkts++;
+          if (channel_lost(&ch)) {
+            ok = false;
+          }
+        }
+        r->delivered += ok;
+        continue;
+      }
+
+      if (!rtcm_fec_tx_add(&tx, frame, len)) {
+        fec_send_block(&ch, r);
+        rtcm_fec_tx_add(&tx, frame, len);
+      }
+    }
+    if (pct >= 0) {
+      fec_send_block(&ch, r); // epoch 끝에서 블록을 닫는다 (묶음이 비면)
+    }
+  }
+}
+
+static int self_test(void) {
+  static uint8_t out[RTCM_FEC_OUT_MAX];
+  uint8_t frame[1029];
+  uint8_t pkt[RTCM_FEC_HDR_SIZE + RTCM_FEC_PAYLOAD];
+  int err = 0;
+
+  // 최대 프레임 한 개, parity 50%: 모든 연속 손실 패턴 (m 개 이하) 복구
+  for (uint8_t drop_len = 1; drop_len <= 5; drop_len++) {
+    for (uint8_t start = 0; start < 15; start++) {
+      rtcm_fec_tx_init(&tx, 50);
+      rtcm_fec_rx_init(&rx);
+      size_t len = make_frame(frame, 1077, 1029, start);
+      rtcm_fec_tx_add(&tx, frame, len);
+      uint8_t n = rtcm_fec_tx_finish(&tx);
+      size_t dlen = 0;
+      for (uint8_t i = 0; i < n; i++) {
+        size_t plen = rtcm_fec_tx_packet(&tx, i, pkt);
+        if (i >= start && i < start + drop_len) {
+          continue;
+        }
+        size_t r = rtcm_fec_rx_push(&rx, pkt, plen, out, sizeof(out));
+        dlen = r ? r : dlen;
+      }
+      if (dlen != len || memcmp(out, frame, len) != 0) {
+        printf("self test: k=%u m=%u drop %u@%u failed\r\n", tx.k, tx.m,
+               drop_len, start);
+        err++;
+      }
+    }
+  }
+
+  // 다른 버전의 패킷은 블록을 시작하지 않고 버린다
+  rtcm_fec_tx_init(&tx, 50);
+  rtcm_fec_rx_init(&rx);
+  rtcm_fec_tx_add(&tx, frame, make_frame(frame, 1077, 200, 0));
+  rtcm_fec_tx_finish(&tx);
+  size_t plen = rtcm_fec_tx_packet(&tx, 0, pkt);
+  pkt[0] = RTCM_FEC_MAGIC | ((RTCM_FEC_VERSION + 1) & ~RTCM_FEC_MAGIC_MASK);
+  if (!rtcm_fec_is_packet(pkt, plen) ||
+      rtcm_fec_rx_push(&rx, pkt, plen, out, sizeof(out)) != 0 ||
+      rx.stats.pkts_version != 1 || rx.stats.blocks != 0) {
+    printf("self test: version mismatch not rejected\r\n");
+    err++;
+  }
+  return err;
+}
+
+int main(void) {
+  int err = self_test();
+  printf("self test (burst up to m=6 in 10+6 packets): %s\r\n",
+         err ? "FAIL" : "OK");
+
+  printf("%-18s %6s %9s %10s %8s %12s\r\n", "loss", "parity", "delivery",
+         "air/epoch", "pkts", "frames/air-s");
+  for (size_t mi = 0; mi < sizeof(models) / sizeof(models[0]); mi++) {
+    for (size_t pi = 0; pi < sizeof(parity_pcts) / sizeof(parity_pcts[0]); pi++) {
+      result_t r;
+      char label[12];
+
+      run(&models[mi], parity_pcts[pi], &r);
+      if (parity_pcts[pi] < 0) {
+        snprintf(label, sizeof(label), "raw");
+      } else {
+        snprintf(label, sizeof(label), "%d%%", parity_pcts[pi]);
+      }
+      printf("%-18s %6s %8.3f%% %8.1fms %8.2f %12.2f\r\n", models[mi].name,
+             label, 100.0 * r.delivered / r.frames,
+             r.airtime_us / 1000.0 / BENCH_EPOCHS, (double)r.pkts / BENCH_EPOCHS,
+             r.delivered / (r.airtime_us / 1e6));
+    }
+  }
+  return err ? 1 : 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 호스트 벤치마크용 FreeRTOS 대체 헤더 (펌웨어 빌드에서 제외)
+ *
+ * lib/gps 를 단일 스레드로 호스트에서 빌드할 때 필요한 타입과 매크로만 둔다.
+ * -Ihost 를 FreeRTOS include 경로보다 앞에 두고 사용한다.
+ */
+#ifndef BENCH_HOST_FREERTOS_H
+#define BENCH_HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS ((TickType_t)1)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file semphr.h
+ * @brief 호스트 벤치마크용 FreeRTOS semaphore API 대체 (펌웨어 빌드에서 제외)
+ */
+#ifndef BENCH_HOST_SEMPHR_H
+#define BENCH_HOST_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  return (SemaphoreHandle_t)1;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem,
+                                        TickType_t ticks) {
+  (void)sem;
+  (void)ticks;
+  return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  (void)sem;
+  return pdTRUE;
+}
+
+#endif
@@ -0,0 +1,12 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief 호스트 벤치마크용 HAL 대체 (log.h 의 HAL_GetTick 만 제공)
+ */
+#ifndef BENCH_HOST_STM32F4XX_HAL_H
+#define BENCH_HOST_STM32F4XX_HAL_H
+
+#include <stdint.h>
+
+static inline uint32_t HAL_GetTick(void) { return 0; }
+
+#endif
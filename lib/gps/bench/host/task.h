@@ -0,0 +1,18 @@
+/**
+ * @file task.h
+ * @brief 호스트 벤치마크용 FreeRTOS task API 대체 (펌웨어 빌드에서 제외)
+ *
+ * 함수 정의는 벤치마크 파일이 둔다 (task.h 를 include 하지 않고 쓰는 소스가 있다).
+ */
+#ifndef BENCH_HOST_TASK_H
+#define BENCH_HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(const TickType_t ticks);
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#endif
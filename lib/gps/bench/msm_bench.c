@@ -0,0 +1,238 @@
+/**
+ * @file msm_bench.c
+ * @brief rtcm_msm 호스트 검증/벤치마크 (펌웨어 빌드에서 제외)
+ *
+ * 합성 MSM7 (GPS 1077, Galileo 1097, BDS 1127) 프레임으로
+ * - 같은 레벨 재인코딩이 원본과 바이트 단위로 같은지
+ * - MSM4 변환 후 다시 디코딩한 값이 양자화 오차 안인지
+ * - epoch 예산에 맞춘 크기가 예산을 넘지 않는지와 처리 시간
+ * - 우선 시스템 (GPS, GPS+Galileo) 메시지가 버려지지 않는지
+ * 를 확인한다.
+ *
+ * @note 빌드/실행 (lib/gps/bench 에서)
+ * gcc -O2 -I.. -I../../../config msm_bench.c ../rtcm_msm.c ../gps_crc.c -o msm_bench && ./msm_bench [budget]
+ */
+#include "gps_crc.h"
+#include "rtcm_msm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ITER 20000
+#define BENCH_EPOCHS 4
+
+typedef struct {
+  uint16_t msg_type;
+  uint8_t nsat;
+  uint8_t sigs[3];
+} bench_sys_t;
+
+static const bench_sys_t bench_sys[] = {
+  {1077, 12, {2, 16, 23}}, // GPS L1C, L2L, L5Q
+  {1097, 10, {2, 15, 22}}, // GAL E1C, E5bQ, E5aI
+  {1127, 14, {2, 8, 22}},  // BDS B1I, B3I, B2a
+};
+
+#define BENCH_SYS_CNT (sizeof(bench_sys) / sizeof(bench_sys[0]))
+
+static uint8_t frames[BENCH_EPOCHS][BENCH_SYS_CNT][1029];
+static size_t lens[BENCH_EPOCHS][BENCH_SYS_CNT];
+
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void) {
+  rnd_state = rnd_state * 1103515245u + 12345u;
+  return rnd_state >> 8;
+}
+
+static int32_t rnd_range(int32_t lim) {
+  return (int32_t)(rnd() % (2u * (uint32_t)lim + 1u)) - lim;
+}
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static size_t make_msm7(const bench_sys_t *sys, uint32_t epoch, bool multi,
+                        uint8_t *frame, size_t size) {
+  static rtcm_msm_t msm;
+
+  memset(&msm, 0, sizeof(msm));
+  msm.msg_type = sys->msg_type;
+  msm.level = 7;
+  msm.multi = multi;
+  msm.ref_id = 1234;
+  msm.epoch = epoch;
+
+  uint8_t sat = 1;
+  for (uint8_t s = 0; s < sys->nsat; s++) {
+    sat += 1 + rnd() % 3;
+    rtcm_msm_sat_t *ps = &msm.sat[sat - 1];
+    ps->rough_ms = 64 + rnd() % 20;
+    ps->ext = rnd() % 16;
+    ps->rough_mod = rnd() % 1024;
+    ps->rate = rnd_range(8191);
+
+    uint16_t base_cnr = (30 + rnd() % 22) << 4;
+    for (uint8_t g = 0; g < 3; g++) {
+      rtcm_msm_cell_t *c = &msm.cell[msm.ncell++];
+      c->sat = sat;
+      c->sig = sys->sigs[g];
+      c->pr = rnd_range(524287);
+      c->cp = rnd_range(8388607);
+      c->lock = (g == 2 && s % 4 == 0) ? 0 : 1000u * (1 + rnd() % 600);
+      c->half = rnd() & 1;
+      c->cnr = base_cnr - (g * 3u << 4) + rnd() % 16;
+      c->rate = rnd_range(16383);
+    }
+  }
+  return rtcm_msm_encode(&msm, 7, frame, size);
+}
+
+static bool check_frame(const uint8_t *frame, size_t len) {
+  uint32_t crc = gps_crc24q(frame, len - 3);
+  return frame[len - 3] == ((crc >> 16) & 0xFF) &&
+         frame[len - 2] == ((crc >> 8) & 0xFF) && frame[len - 1] == (crc & 0xFF);
+}
+
+static int check_roundtrip(const uint8_t *frame, size_t len) {
+  static rtcm_msm_t a, b;
+  uint8_t out[1029];
+  int err = 0;
+
+  if (!rtcm_msm_decode(frame, len, &a)) {
+    printf("  decode fail\r\n");
+    return 1;
+  }
+
+  size_t n = rtcm_msm_encode(&a, a.level, out, sizeof(out));
+  if (n != len || memcmp(out, frame, len) != 0) {
+    printf("  MSM%u re-encode mismatch (%zu/%zu)\r\n", a.level, n, len);
+    err++;
+  }
+
+  n = rtcm_msm_encode(&a, 4, out, sizeof(out));
+  if (n == 0 || !check_frame(out, n) || !rtcm_msm_decode(out, n, &b) ||
+      b.level != 4 || b.ncell != a.ncell) {
+    printf("  MSM4 encode fail\r\n");
+    return err + 1;
+  }
+
+  for (uint8_t c = 0; c < a.ncell; c++) {
+    const rtcm_msm_cell_t *x = &a.cell[c];
+    const rtcm_msm_cell_t *y = &b.cell[c];
+    if (x->sat != y->sat || x->sig != y->sig || x->half != y->half ||
+        abs(x->pr - y->pr) > 16 + 16 || abs(x->cp - y->cp) > 2 + 2 ||
+        abs((int)x->cnr - (int)y->cnr) > 8 || y->lock > x->lock) {
+      printf("  MSM4 cell %u mismatch\r\n", c);
+      err++;
+    }
+  }
+  return err;
+}
+
+static int run_fit(uint16_t budget, uint8_t prio) {
+  static rtcm_msm_fit_t fit;
+  uint8_t out[1029];
+  int err = 0;
+
+  rtcm_msm_fit_init(&fit, budget, true, prio);
+  printf("budget %u bytes/epoch, MSM7 -> MSM4 allowed, priority 0x%02X\r\n",
+         budget, prio);
+  for (int e = 0; e < BENCH_EPOCHS; e++) {
+    size_t in_sum = 0, out_sum = 0;
+    for (size_t s = 0; s < BENCH_SYS_CNT; s++) {
+      size_t sent;
+      rtcm_msm_fit_result_t r = rtcm_msm_fit(&fit, frames[e][s], lens[e][s],
+                                             out, sizeof(out), &sent);
+      if (r == RTCM_MSM_FIT_DROP) {
+        sent = 0;
+        if (prio & (1u << (bench_sys[s].msg_type - 1071) / 10)) {
+          printf("  priority type %u dropped\r\n", bench_sys[s].msg_type);
+          err++;
+        }
+      } else if (r == RTCM_MSM_FIT_TRIMMED &&
+                 (!check_frame(out, sent) || !rtcm_msm_decode(out, sent, &fit.msm) ||
+                  fit.msm.multi != (s + 1 < BENCH_SYS_CNT))) {
+        printf("  fit output invalid\r\n");
+        err++;
+      }
+      printf("  epoch %d type %u: %4zu -> %4zu bytes%s\r\n", e,
+             bench_sys[s].msg_type, lens[e][s], sent,
+             r == RTCM_MSM_FIT_PASS ? " (as is)"
+             : r == RTCM_MSM_FIT_DROP ? " (dropped)" : "");
+      in_sum += lens[e][s];
+      out_sum += sent;
+    }
+    printf("  epoch %d total: %zu -> %zu bytes\r\n", e, in_sum, out_sum);
+    if (budget && out_sum > budget) {
+      printf("  epoch %d over budget\r\n", e);
+      err++;
+    }
+  }
+  printf("trimmed %u msgs, dropped %u cells, dropped %u msgs\r\n",
+         (unsigned)fit.trimmed, (unsigned)fit.cells_dropped,
+         (unsigned)fit.dropped);
+  return err;
+}
+
+int main(int argc, char *argv[]) {
+  uint16_t budget = argc > 1 ? (uint16_t)atoi(argv[1]) : 320;
+  int err = 0;
+
+  for (int e = 0; e < BENCH_EPOCHS; e++) {
+    for (size_t s = 0; s < BENCH_SYS_CNT; s++) {
+      lens[e][s] = make_msm7(&bench_sys[s], 1000u * e, s + 1 < BENCH_SYS_CNT,
+                             frames[e][s], sizeof(frames[e][s]));
+      if (lens[e][s] == 0 || !check_frame(frames[e][s], lens[e][s])) {
+        printf("synth fail\r\n");
+        return 1;
+      }
+      err += check_roundtrip(frames[e][s], lens[e][s]);
+    }
+  }
+  printf("roundtrip: %s (%d errors)\r\n", err ? "FAIL" : "OK", err);
+
+  // epoch 예산 맞춤
+  static rtcm_msm_fit_t fit;
+  uint8_t out[1029];
+
+  err += run_fit(budget, RTCM_MSM_SYS_GPS);
+  err += run_fit(budget, RTCM_MSM_SYS_GPS | RTCM_MSM_SYS_GAL);
+
+  // 처리 시간
+  static rtcm_msm_t msm;
+  volatile size_t sink = 0;
+  double t0 = now_sec();
+  for (int i = 0; i < BENCH_ITER; i++) {
+    sink += rtcm_msm_decode(frames[0][0], lens[0][0], &msm);
+  }
+  double t_dec = (now_sec() - t0) / BENCH_ITER;
+
+  t0 = now_sec();
+  for (int i = 0; i < BENCH_ITER; i++) {
+    sink += rtcm_msm_encode(&msm, 4, out, sizeof(out));
+  }
+  double t_enc = (now_sec() - t0) / BENCH_ITER;
+
+  t0 = now_sec();
+  for (int i = 0; i < BENCH_ITER; i++) {
+    rtcm_msm_fit_init(&fit, budget, true, RTCM_MSM_SYS_GPS);
+    for (size_t s = 0; s < BENCH_SYS_CNT; s++) {
+      size_t n;
+      sink += rtcm_msm_fit(&fit, frames[0][s], lens[0][s], out, sizeof(out), &n);
+      sink += n;
+    }
+  }
+  double t_fit = (now_sec() - t0) / BENCH_ITER;
+
+  printf("decode MSM7 %zu B: %6.2f us, encode MSM4: %6.2f us, "
+         "fit epoch: %6.2f us\r\n",
+         lens[0][0], t_dec * 1e6, t_enc * 1e6, t_fit * 1e6);
+  (void)sink;
+
+  return err ? 1 : 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file nmea_bench.c
+ * @brief NMEA 문장 인덱스 + 디코더 처리량 벤치마크 (펌웨어 빌드에서 제외)
+ *
+ * 한 epoch = 20Hz 출력에서 수신기가 내보내는 전체 문장
+ * (GGA, RMC, GST, VTG, ZDA, THS, GSA x4, GSV x10).
+ * 문장마다 gps.c 의 parse_nmea_line 과 같은 nmea_index_build +
+ * gps_parse_nmea_sentence 를 수행한다.
+ *
+ * @note 호스트 빌드/실행 (lib/gps/bench 에서, 전체 디코더 사용)
+ * gcc -O2 -I.. -I../../parser -I../../../config -DUSE_GPS_NMEA_RMC
+ * -DUSE_GPS_NMEA_GST -DUSE_GPS_NMEA_GSA -DUSE_GPS_NMEA_GSV -DUSE_GPS_NMEA_VTG
+ * -DUSE_GPS_NMEA_ZDA nmea_bench.c ../gps_nmea.c ../gps_coord.c
+ * ../../parser/nmea_index.c -o nmea_bench && ./nmea_bench
+ * @note -D 없이 빌드하면 꺼진 문장은 주소 비교만 하므로 그 비용을 볼 수 있다.
+ * @note 타겟: 위 소스를 임시로 빌드에 넣고 nmea_bench_main() 을 호출하면
+ * DWT 사이클 카운터로 측정한다.
+ */
+#include "gps_nmea.h"
+#include "nmea_index.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(STM32F405xx)
+#include "stm32f4xx.h"
+#define BENCH_ITER 50
+#define BENCH_UNIT "cycles"
+#define BENCH_UNIT_PER_SEC 168000000ULL
+
+static void bench_init(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t bench_now(void) { return DWT->CYCCNT; }
+#else
+#include <time.h>
+#define BENCH_ITER 20000
+#define BENCH_UNIT "ns"
+#define BENCH_UNIT_PER_SEC 1000000000ULL
+
+static void bench_init(void) {}
+
+static inline uint32_t bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+#endif
+
+#define EPOCH_HZ 20
+
+/* 체크섬은 epoch_build() 에서 붙임 */
+static const char *const epoch_body[] = {
+    "GNGGA,092725.00,3724.81689452,N,12707.52734374,E,4,32,0.55,62.0923,M,"
+    "18.1234,M,1.0,0123",
+    "GNRMC,092725.00,A,3724.81689452,N,12707.52734374,E,0.012,123.45,181026,"
+    ",,R,V",
+    "GNGST,092725.00,0.012,0.010,0.008,45.0,0.009,0.008,0.015",
+    "GNVTG,123.45,T,,M,0.012,N,0.022,K,R",
+    "GNZDA,092725.00,18,10,2026,00,00",
+    "GNTHS,271.12345,A",
+    "GNGSA,A,3,02,05,07,09,13,15,18,20,24,29,,,0.98,0.55,0.81,1",
+    "GNGSA,A,3,65,66,72,81,82,88,,,,,,,0.98,0.55,0.81,2",
+    "GNGSA,A,3,03,05,13,15,21,26,33,,,,,,0.98,0.55,0.81,3",
+    "GNGSA,A,3,06,09,16,19,21,22,26,39,42,45,,,0.98,0.55,0.81,4",
+    "GPGSV,3,1,11,02,45,123,45,05,30,045,42,07,60,300,48,09,12,210,36,1",
+    "GPGSV,3,2,11,13,77,010,50,15,25,160,40,18,05,330,30,20,40,080,44,1",
+    "GPGSV,3,3,11,24,35,250,43,29,15,100,38,30,02,020,,1",
+    "GLGSV,2,1,07,65,40,030,44,66,70,120,47,72,20,300,38,81,33,200,41,1",
+    "GLGSV,2,2,07,82,55,250,45,88,10,100,33,87,03,070,,1",
+    "GAGSV,2,1,07,03,50,060,46,05,20,140,40,13,65,220,48,15,30,310,42,7",
+    "GAGSV,2,2,07,21,45,020,45,26,10,180,35,33,25,280,41,7",
+    "GBGSV,3,1,10,06,55,090,45,09,40,200,43,16,30,120,41,19,75,330,49,1",
+    "GBGSV,3,2,10,21,20,010,39,22,35,060,42,26,60,240,47,39,15,150,37,1",
+    "GBGSV,3,3,10,42,25,280,40,45,50,030,45,1",
+};
+
+#define EPOCH_CNT (sizeof(epoch_body) / sizeof(epoch_body[0]))
+
+static char epoch_line[EPOCH_CNT][GPS_NMEA_LINE_SIZE];
+static size_t epoch_len[EPOCH_CNT];
+static size_t epoch_bytes;
+
+static gps_nmea_data_t data;
+static volatile uint32_t sink;
+
+/**
+ * @brief '$' 와 "\r\n" 을 뺀 문장에 체크섬을 붙임
+ */
+static void epoch_build(void) {
+  for (size_t i = 0; i < EPOCH_CNT; i++) {
+    uint8_t crc = 0;
+
+    for (const char *p = epoch_body[i]; *p; p++) {
+      crc ^= (uint8_t)*p;
+    }
+    epoch_len[i] = (size_t)snprintf(epoch_line[i], sizeof(epoch_line[i]),
+                                    "%s*%02X", epoch_body[i], crc);
+    epoch_bytes += epoch_len[i] + 3; // '$' + "\r\n"
+  }
+}
+
+static gps_nmea_msg_t process_line(size_t i) {
+  nmea_index_t idx;
+
+  if (!nmea_index_build(&idx, epoch_line[i], epoch_len[i])) {
+    return GPS_NMEA_MSG_INVALID;
+  }
+
+  return gps_parse_nmea_sentence(&data, &idx);
+}
+
+static int verify(void) {
+  for (size_t i = 0; i < EPOCH_CNT; i++) {
+    if (process_line(i) == GPS_NMEA_MSG_INVALID) {
+      printf("checksum fail: %s\r\n", epoch_line[i]);
+      return 1;
+    }
+  }
+
+  if (data.gga.lat != 37413614909LL || data.gga.alt != 62092 ||
+      data.gga.diff_station != 123 || data.ths.heading != 27112345) {
+    printf("GGA/THS mismatch: %lld %ld %d %ld\r\n", (long long)data.gga.lat,
+           (long)data.gga.alt, data.gga.diff_station, (long)data.ths.heading);
+    return 1;
+  }
+
+#if defined(USE_GPS_NMEA_RMC)
+  if (data.rmc.speed != 12 || data.rmc.course != 12345000 ||
+      data.rmc.year != 26 || data.rmc.mode != 'R') {
+    printf("RMC mismatch\r\n");
+    return 1;
+  }
+#endif
+#if defined(USE_GPS_NMEA_GST)
+  if (data.gst.std_lat != 9 || data.gst.std_alt != 15) {
+    printf("GST mismatch\r\n");
+    return 1;
+  }
+#endif
+#if defined(USE_GPS_NMEA_GSA)
+  if (gps_nmea_gsa_sv_used(&data) != 33 || data.gsa[4].sv_cnt != 10) {
+    printf("GSA mismatch: %u\r\n", gps_nmea_gsa_sv_used(&data));
+    return 1;
+  }
+#endif
+#if defined(USE_GPS_NMEA_GSV)
+  if (data.gsv.sat_cnt != 35) {
+    printf("GSV mismatch: %u\r\n", data.gsv.sat_cnt);
+    return 1;
+  }
+  /* 같은 묶음을 다시 받아도 위성 수는 그대로 */
+  process_line(EPOCH_CNT - 3);
+  process_line(EPOCH_CNT - 2);
+  process_line(EPOCH_CNT - 1);
+  if (data.gsv.sat_cnt != 35) {
+    printf("GSV refresh mismatch: %u\r\n", data.gsv.sat_cnt);
+    return 1;
+  }
+#endif
+#if defined(USE_GPS_NMEA_VTG)
+  if (data.vtg.speed_kmh != 22 || data.vtg.course_mag != -1) {
+    printf("VTG mismatch\r\n");
+    return 1;
+  }
+#endif
+#if defined(USE_GPS_NMEA_ZDA)
+  if (data.zda.year != 2026 || data.zda.day != 18 || data.zda.sec != 25) {
+    printf("ZDA mismatch\r\n");
+    return 1;
+  }
+#endif
+
+  printf("verify OK (%u sentences, %u bytes/epoch)\r\n", (unsigned)EPOCH_CNT,
+         (unsigned)epoch_bytes);
+  return 0;
+}
+
+static gps_nmea_msg_t index_line(size_t i) {
+  nmea_index_t idx;
+
+  return nmea_index_build(&idx, epoch_line[i], epoch_len[i])
+             ? (gps_nmea_msg_t)idx.cnt
+             : GPS_NMEA_MSG_INVALID;
+}
+
+/**
+ * @brief epoch 전체 처리 시간
+ *
+ * @note GSV 는 묶음 단위로 표를 갱신하므로 문장 하나만 반복 측정하지 않는다.
+ */
+static uint32_t bench_epoch(gps_nmea_msg_t (*fn)(size_t)) {
+  uint32_t start = bench_now();
+
+  for (int k = 0; k < BENCH_ITER; k++) {
+    for (size_t i = 0; i < EPOCH_CNT; i++) {
+      sink += fn(i);
+    }
+  }
+
+  return (bench_now() - start) / BENCH_ITER;
+}
+
+#if defined(STM32F405xx)
+int nmea_bench_main(void)
+#else
+int main(void)
+#endif
+{
+  bench_init();
+  epoch_build();
+
+  if (verify()) {
+    return 1;
+  }
+
+  uint32_t t_index = bench_epoch(index_line);
+  uint32_t t_epoch = bench_epoch(process_line);
+  unsigned long long per_sec = (unsigned long long)t_epoch * EPOCH_HZ;
+  unsigned long long load = per_sec * 100000ULL / BENCH_UNIT_PER_SEC;
+
+  printf("index only      : %lu %s/epoch\r\n", (unsigned long)t_index,
+         BENCH_UNIT);
+  printf("index + decode  : %lu %s/epoch\r\n", (unsigned long)t_epoch,
+         BENCH_UNIT);
+  printf("%d Hz throughput: %llu bytes/s, %llu.%03llu%% load\r\n", EPOCH_HZ,
+         (unsigned long long)epoch_bytes * EPOCH_HZ, load / 1000, load % 1000);
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file sched_bench.c
+ * @brief rtcm_sched 혼잡 판단 호스트 검증 (펌웨어 빌드에서 제외)
+ *
+ * 1Hz epoch (GPS/Galileo/BDS MSM + 10초마다 1005) 를 초당 정해진 바이트만
+ * 내보내는 링크 모델에 넣고, 남은 메시지 수를 깊이로 rtcm_sched 에 준다.
+ * TX 점유율은 load_high 아래로 고정해 깊이만으로
+ * - 링크가 느려지면 혼잡으로 바뀌고 MSM 을 건너뛰는지
+ * - 링크가 돌아오면 해제되는지
+ * - 여유 구간에서는 혼잡이 되지 않는지
+ * 를 확인한다. 설정값은 gps_app.c 의 rtcm_sched_cfg 와 같다.
+ *
+ * @note 빌드/실행 (lib/gps/bench 에서)
+ * gcc -O2 -I.. -I../../../config sched_bench.c ../rtcm_sched.c ../rtcm_msm.c ../gps_crc.c -o sched_bench && ./sched_bench
+ */
+#include "rtcm_sched.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_FIFO 64
+#define BENCH_MSG_BYTES 110 // epoch 예산에 맞춘 MSM 하나 크기
+#define BENCH_LOAD_PCT 50   // 점유율 (load_high 아래)
+
+static const rtcm_sched_cfg_t cfg = {
+  //          GPS GLO GAL SBAS QZS BDS NavIC
+  .period = {  1,  3,  2,  0,   1,  2,  1 },
+  .phase  = {  0,  0,  0,  0,   0,  1,  0 },
+  .station_ms = 10000,
+  .station_max_ms = 60000,
+  .depth_high = 8,
+  .depth_low = 2,
+  .load_high = 90,
+  .load_low = 70,
+};
+
+/* 링크 모델: 보내지 못한 메시지 크기 FIFO */
+static struct {
+  uint16_t len[BENCH_FIFO];
+  uint8_t rd, wr;
+  uint32_t sent_part; ///< 맨 앞 메시지에서 이미 보낸 바이트
+  uint32_t dropped;
+} link;
+
+static uint8_t link_depth(void) {
+  return (uint8_t)(link.wr - link.rd);
+}
+
+static void link_push(uint16_t len) {
+  if (link_depth() >= BENCH_FIFO) {
+    link.dropped++;
+    return;
+  }
+  link.len[link.wr++ % BENCH_FIFO] = len;
+}
+
+static void link_drain(uint32_t bytes) {
+  while (bytes > 0 && link_depth() > 0) {
+    uint32_t rest = link.len[link.rd % BENCH_FIFO] - link.sent_part;
+    if (bytes < rest) {
+      link.sent_part += bytes;
+      return;
+    }
+    bytes -= rest;
+    link.sent_part = 0;
+    link.rd++;
+  }
+}
+
+static void frame_for(uint16_t type, uint8_t *frame) {
+  // 스테이션 메시지는 CRC 만 비교하므로 고정 값
+  memset(frame, 0, 6);
+  frame[0] = 0xD3;
+  frame[3] = type >> 4;
+  frame[4] = (type & 0x0F) << 4;
+}
+
+typedef struct {
+  const char *name;
+  int secs;
+  uint32_t link_bps;  ///< 링크가 1초에 내보내는 바이트
+  bool expect_congested_any;
+  bool expect_congested_end;
+} bench_phase_t;
+
+static const bench_phase_t phases[] = {
+  {"fast", 30, 480, false, false}, // epoch 330 B + 1005 여유
+  {"slow", 30, 200, true, true},   // 절반 남짓만 나감
+  {"fast", 30, 480, true, false},  // 밀린 것을 비우고 해제
+};
+
+int main(void) {
+  static const uint16_t msm[] = {1077, 1097, 1127};
+  rtcm_sched_t sched;
+  uint8_t frame[6];
+  uint32_t now_ms = 0;
+  int err = 0;
+
+  rtcm_sched_init(&sched, &cfg);
+  memset(&link, 0, sizeof(link));
+
+  for (size_t p = 0; p < sizeof(phases) / sizeof(phases[0]); p++) {
+    const bench_phase_t *ph = &phases[p];
+    bool any = false;
+    uint8_t depth_max = 0;
+    uint32_t skipped = 0;
+
+    for (int t = 0; t < ph->secs; t++, now_ms += 1000) {
+      uint16_t types[4];
+      uint8_t n = 0;
+
+      for (size_t i = 0; i < sizeof(msm) / sizeof(msm[0]); i++) {
+        types[n++] = msm[i];
+      }
+      if (now_ms % 10000 == 0) {
+        types[n++] = 1005;
+      }
+
+      for (uint8_t i = 0; i < n; i++) {
+        uint8_t depth = link_depth();
+        if (depth > depth_max) {
+          depth_max = depth;
+        }
+        rtcm_sched_update_link(&sched, now_ms + i, depth,
+                               (now_ms + i) * BENCH_LOAD_PCT / 100);
+        any |= sched.congested;
+
+        frame_for(types[i], frame);
+        if (rtcm_sched_accept(&sched, types[i], frame, sizeof(frame),
+                              now_ms + i)) {
+          link_push(types[i] == 1005 ? 25 : BENCH_MSG_BYTES);
+        } else {
+          skipped++;
+        }
+      }
+      link_drain(ph->link_bps);
+    }
+
+    bool ok = any == ph->expect_congested_any &&
+              sched.congested == ph->expect_congested_end &&
+              sched.load < cfg.load_high;
+    printf("%-4s %3u B/s: depth max %2u, congested %s (end %s), "
+           "skipped %3u, load %u%% %s\r\n",
+           ph->name, (unsigned)ph->link_bps, depth_max, any ? "yes" : "no",
+           sched.congested ? "yes" : "no", (unsigned)skipped, sched.load,
+           ok ? "OK" : "FAIL");
+    err += !ok;
+  }
+
+  printf("link dropped %u msgs\r\n", (unsigned)link.dropped);
+  printf("verify %s\r\n", err ? "FAIL" : "OK");
+  return err ? 1 : 0;
+}
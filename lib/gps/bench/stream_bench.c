@@ -0,0 +1,397 @@
+/**
+ * @file stream_bench.c
+ * @brief GNSS UART 스트림 재생 벤치마크 (펌웨어 빌드에서 제외)
+ *
+ * 캡처한 UART 로그(또는 내장 F9P/UM982 합성 스트림)를 여러 청크 크기로
+ * gps_parse_process() 에 넣어 처리량과 이벤트 수를 측정한다.
+ * 청크 크기는 DMA IDLE 인터럽트 한 번에 받는 바이트 수에 해당한다.
+ *
+ * 출력: MB/s, ns/byte, frames/s, 프로토콜별 이벤트/체크섬 에러,
+ * Cortex-M4 168MHz 기준 cycles/byte 추정치
+ *
+ * @note 호스트 빌드/실행 (lib/gps/bench 에서). host/ 의 FreeRTOS, HAL 대체 헤더를 쓴다.
+ * gcc -O2 -Ihost -I.. -I../../parser -I../../log -I../../../config stream_bench.c
+ *   ../gps.c ../gps_nmea.c ../gps_ubx.c ../gps_unicore.c ../gps_crc.c
+ *   ../gps_coord.c ../gps_snapshot.c ../../parser/nmea_index.c
+ *   ../../parser/parser.c -o stream_bench
+ * ./stream_bench                  내장 F9P, UM982 합성 스트림
+ * ./stream_bench f9p.bin um.bin   캡처 파일 (UART 원시 바이트)
+ * ./stream_bench dump.gcap        장비 캡처 (capture.h 포맷, GPS 소스 레코드만 재생)
+ * @note 환경변수 BENCH_HOST_GHZ(기본 3.0), BENCH_M4_CPI(기본 2.5) 로 추정 계수를 바꾼다.
+ * M4 추정치 = ns/byte * 호스트 GHz * M4_CPI. 호스트 대비 M4 의 클럭당 처리량
+ * 비율을 곱한 값이므로 참고용이며, 최종 확인은 타겟의 handler_max 와 DWT 로 한다.
+ * @note GCAP 파일은 환경변수 BENCH_CAPTURE_SRC(기본 0: GPS base) 소스의 레코드를
+ * 이어 붙여 재생하고, 기록된 DMA 구간 그대로 나눈 "cap" 행을 추가로 측정한다.
+ * @note 파서의 LOG_* 출력이 측정에 섞이지 않도록 stdout 은 /dev/null 로 돌리고
+ * 결과는 stderr 로 출력한다.
+ */
+#include "gps.h"
+#include "capture.h"
+#include "gps_crc.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_STREAM_MAX (4u * 1024u * 1024u)
+#define BENCH_MIN_BYTES (32u * 1024u * 1024u) ///< 청크 크기별 최소 처리 바이트
+#define BENCH_M4_HZ 168000000.0
+
+#define BENCH_CHUNK_ALL 0          ///< 스트림 전체 한 번에
+#define BENCH_CHUNK_CAPTURE SIZE_MAX ///< 캡처 레코드 구간 그대로
+
+static const size_t chunk_sizes[] = {1,   16, 64, 256, 1024, BENCH_CHUNK_ALL,
+                                     BENCH_CHUNK_CAPTURE};
+
+typedef struct {
+  uint32_t events;
+  uint32_t proto[GPS_PROTOCOL_CNT];
+} bench_count_t;
+
+static bench_count_t count;
+
+/**
+ * @brief host/task.h 대체 함수
+ *
+ * tick 은 0 으로 고정이므로 수신 끊김 검사(GPS_FRAME_STALL_MS)는 동작하지 않는다.
+ */
+TickType_t xTaskGetTickCount(void) { return 0; }
+
+void vTaskDelay(const TickType_t ticks) { (void)ticks; }
+
+static void bench_handler(gps_t *gps, gps_event_t event,
+                          gps_procotol_t protocol, gps_msg_t msg) {
+  (void)gps;
+  (void)event;
+  (void)msg;
+
+  count.events++;
+  if (protocol < GPS_PROTOCOL_CNT) {
+    count.proto[protocol]++;
+  }
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ---------------------------------------------------------------------------
+ * 합성 스트림
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+  uint8_t *buf;
+  size_t len;
+  uint16_t *rec;  ///< 캡처 레코드 길이 (GCAP 파일만)
+  size_t rec_cnt;
+} stream_t;
+
+static uint32_t rng_state = 0x12345678;
+
+static uint8_t rng8(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return (uint8_t)rng_state;
+}
+
+static void put(stream_t *s, const void *data, size_t len) {
+  memcpy(s->buf + s->len, data, len);
+  s->len += len;
+}
+
+static void put_nmea(stream_t *s, const char *body) {
+  char buf[128];
+  uint8_t cs = 0;
+
+  for (const char *p = body; *p; p++) {
+    cs ^= (uint8_t)*p;
+  }
+  put(s, buf, (size_t)snprintf(buf, sizeof(buf), "$%s*%02X\r\n", body, cs));
+}
+
+/**
+ * @brief UNICORE 명령 응답. 체크섬은 ':' 까지만 계산한다.
+ */
+static void put_unicore_resp(stream_t *s, const char *cmd, const char *resp) {
+  char buf[128];
+  uint8_t cs = 0;
+  int n = snprintf(buf, sizeof(buf), "$command,%s,response:", cmd);
+
+  for (int i = 1; i < n; i++) {
+    cs ^= (uint8_t)buf[i];
+  }
+  n += snprintf(buf + n, sizeof(buf) - (size_t)n, " %s*%02X\r\n", resp, cs);
+  put(s, buf, (size_t)n);
+}
+
+static void put_ubx(stream_t *s, uint8_t class, uint8_t id,
+                    const void *payload, uint16_t len) {
+  uint8_t hdr[6] = {0xB5, 0x62, class, id, (uint8_t)len, (uint8_t)(len >> 8)};
+  const uint8_t *p = payload;
+  uint8_t ck[2] = {0, 0};
+
+  for (size_t i = 2; i < sizeof(hdr); i++) {
+    ck[0] += hdr[i];
+    ck[1] += ck[0];
+  }
+  for (uint16_t i = 0; i < len; i++) {
+    ck[0] += p[i];
+    ck[1] += ck[0];
+  }
+  put(s, hdr, sizeof(hdr));
+  put(s, payload, len);
+  put(s, ck, sizeof(ck));
+}
+
+static void put_unicore_bin(stream_t *s, uint16_t msg, const void *payload,
+                            uint16_t len) {
+  gps_unicore_bin_header_t hdr = {0};
+  uint8_t *start = s->buf + s->len;
+  uint32_t crc;
+
+  hdr.sync[0] = 0xAA;
+  hdr.sync[1] = 0x44;
+  hdr.sync[2] = 0xB5;
+  hdr.message_id = msg;
+  hdr.message_len = len;
+  put(s, &hdr, sizeof(hdr));
+  put(s, payload, len);
+  crc = gps_crc32(start, sizeof(hdr) + len);
+  put(s, &crc, sizeof(crc));
+}
+
+/**
+ * @brief MSM 과 비슷한 임의 payload 의 RTCM3 프레임
+ */
+static void put_rtcm(stream_t *s, uint16_t type, uint16_t len) {
+  uint8_t *f = s->buf + s->len;
+  uint32_t crc;
+
+  f[0] = 0xD3;
+  f[1] = (uint8_t)(len >> 8);
+  f[2] = (uint8_t)len;
+  for (uint16_t i = 0; i < len; i++) {
+    f[3 + i] = rng8();
+  }
+  f[3] = (uint8_t)(type >> 4);
+  f[4] = (uint8_t)((f[4] & 0x0F) | (type & 0x0F) << 4);
+  crc = gps_crc24q(f, 3u + len);
+  f[3 + len] = (uint8_t)(crc >> 16);
+  f[4 + len] = (uint8_t)(crc >> 8);
+  f[5 + len] = (uint8_t)crc;
+  s->len += 6u + len;
+}
+
+/**
+ * @brief F9P 1Hz epoch: GGA, NAV-HPPOSLLH, NAV-RELPOSNED, NAV-PVT, RTCM MSM7
+ */
+static void gen_f9p(stream_t *s) {
+  uint8_t payload[92];
+
+  while (s->len + 4096 < BENCH_STREAM_MAX) {
+    put_nmea(s, "GNGGA,092725.00,3717.11399,N,12733.91590,E,4,18,0.61,49.6,M,"
+                "18.0,M,1.0,0000");
+    memset(payload, 0, sizeof(payload));
+    put_ubx(s, 0x01, 0x14, payload, 36);
+    put_ubx(s, 0x01, 0x3C, payload, 64);
+    put_ubx(s, 0x01, 0x07, payload, 92);
+    put_rtcm(s, 1077, 420);
+    put_rtcm(s, 1087, 300);
+    put_rtcm(s, 1097, 280);
+    put_rtcm(s, 1127, 360);
+    put_rtcm(s, 1005, 19);
+  }
+}
+
+/**
+ * @brief UM982 1Hz epoch: GGA, THS, BESTNAVB, HEADINGB, RTCM MSM4, 명령 응답
+ */
+static void gen_um982(stream_t *s) {
+  hpd_unicore_bestnavb_t bestnav = {0};
+  hpd_unicore_headingb_t heading = {0};
+
+  while (s->len + 4096 < BENCH_STREAM_MAX) {
+    put_nmea(s, "GNGGA,092725.00,3717.11399,N,12733.91590,E,4,18,0.61,49.6,M,"
+                "18.0,M,1.0,0000");
+    put_nmea(s, "GNTHS,123.45,A");
+    put_unicore_bin(s, GPS_UNICORE_BIN_MSG_BESTNAV, &bestnav, sizeof(bestnav));
+    put_unicore_bin(s, GPS_UNICORE_BIN_MSG_HEADING, &heading, sizeof(heading));
+    put_rtcm(s, 1074, 220);
+    put_rtcm(s, 1084, 160);
+    put_rtcm(s, 1094, 150);
+    put_rtcm(s, 1124, 190);
+    put_unicore_resp(s, "mode base", "OK");
+  }
+}
+
+/**
+ * @brief GCAP 캡처에서 한 소스의 레코드만 꺼내 이어 붙인다 (in-place)
+ */
+static void load_capture(stream_t *s, unsigned src) {
+  size_t pos = CAPTURE_HDR_SIZE;
+  size_t out = 0;
+
+  s->rec_cnt = 0;
+  while (pos + CAPTURE_REC_HDR_SIZE <= s->len) {
+    const uint8_t *hdr = &s->buf[pos];
+    uint16_t len = (uint16_t)(hdr[6] | hdr[7] << 8);
+
+    if (pos + CAPTURE_REC_HDR_SIZE + len > s->len) {
+      break;
+    }
+    if (hdr[4] == src) {
+      memmove(&s->buf[out], hdr + CAPTURE_REC_HDR_SIZE, len);
+      s->rec[s->rec_cnt++] = len;
+      out += len;
+    }
+    pos += CAPTURE_REC_HDR_SIZE + len;
+  }
+  s->len = out;
+}
+
+static int load_file(stream_t *s, const char *path) {
+  FILE *fp = fopen(path, "rb");
+  const char *env_src = getenv("BENCH_CAPTURE_SRC");
+
+  if (fp == NULL) {
+    return -1;
+  }
+  s->len = fread(s->buf, 1, BENCH_STREAM_MAX, fp);
+  s->rec_cnt = 0;
+  fclose(fp);
+
+  if (s->len >= CAPTURE_HDR_SIZE && memcmp(s->buf, "GCAP", 4) == 0) {
+    load_capture(s, env_src ? (unsigned)atoi(env_src) : CAPTURE_SRC_GPS_BASE);
+  }
+  return s->len ? 0 : -1;
+}
+
+/* ---------------------------------------------------------------------------
+ * 측정
+ * ------------------------------------------------------------------------- */
+
+static void replay(gps_t *gps, const stream_t *s, size_t chunk) {
+  size_t off = 0;
+
+  if (chunk == BENCH_CHUNK_CAPTURE) {
+    for (size_t i = 0; i < s->rec_cnt; i++) {
+      gps_parse_process(gps, s->buf + off, s->rec[i]);
+      off += s->rec[i];
+    }
+    return;
+  }
+
+  if (chunk == BENCH_CHUNK_ALL) {
+    chunk = s->len;
+  }
+  for (; off < s->len; off += chunk) {
+    size_t n = s->len - off < chunk ? s->len - off : chunk;
+    gps_parse_process(gps, s->buf + off, n);
+  }
+}
+
+static void run(const char *name, const stream_t *s, double host_ghz,
+                double m4_cpi) {
+  static gps_t gps;
+  gps_parse_stats_t st;
+
+  fprintf(stderr, "\n%s: %zu bytes\n", name, s->len);
+  fprintf(stderr, "%6s %9s %9s %11s %9s %8s %8s %8s %8s %8s %6s %9s %8s\n",
+          "chunk", "MB/s", "ns/byte", "frames/s", "events", "nmea", "ubx",
+          "unib", "unia", "rtcm", "err", "m4 cyc/B", "m4 MB/s");
+
+  for (size_t c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+    size_t chunk = chunk_sizes[c];
+    char label[24];
+    uint32_t reps = (uint32_t)(BENCH_MIN_BYTES / s->len + 1);
+    uint32_t err = 0;
+    double t0, t1, ns_byte, m4_cyc;
+
+    if (chunk == BENCH_CHUNK_CAPTURE && s->rec_cnt == 0) {
+      continue;
+    }
+    if (chunk == BENCH_CHUNK_CAPTURE) {
+      snprintf(label, sizeof(label), "cap");
+    } else if (chunk == BENCH_CHUNK_ALL) {
+      snprintf(label, sizeof(label), "all");
+    } else {
+      snprintf(label, sizeof(label), "%zu", chunk);
+    }
+
+    memset(&gps, 0, sizeof(gps));
+    gps_init(&gps);
+    gps_set_evt_handler(&gps, bench_handler);
+    memset(&count, 0, sizeof(count));
+
+    t0 = now_ns();
+    for (uint32_t r = 0; r < reps; r++) {
+      replay(&gps, s, chunk);
+    }
+    t1 = now_ns();
+
+    gps_get_parse_stats(&gps, &st);
+    for (int p = 0; p < GPS_PROTOCOL_CNT; p++) {
+      err += st.chksum_err[p];
+    }
+
+    ns_byte = (t1 - t0) / ((double)s->len * (double)reps);
+    m4_cyc = ns_byte * host_ghz * m4_cpi;
+    fprintf(stderr,
+            "%6s %9.1f %9.2f %11.0f %9u %8u %8u %8u %8u %8u %6u %9.1f %8.2f\n",
+            label, 1e3 / ns_byte, ns_byte,
+            (double)count.events / ((t1 - t0) / 1e9), count.events / reps,
+            count.proto[GPS_PROTOCOL_NMEA] / reps,
+            count.proto[GPS_PROTOCOL_UBX] / reps,
+            count.proto[GPS_PROTOCOL_UNICORE_BIN] / reps,
+            count.proto[GPS_PROTOCOL_UNICORE] / reps,
+            count.proto[GPS_PROTOCOL_RTCM] / reps, err / reps, m4_cyc,
+            BENCH_M4_HZ / m4_cyc / 1e6);
+  }
+
+  fprintf(stderr,
+          "discarded %u resync %u len_reject %u overflow %u (last run)\n",
+          st.discarded, st.resync, st.len_reject, st.overflow);
+}
+
+int main(int argc, char *argv[]) {
+  const char *env_ghz = getenv("BENCH_HOST_GHZ");
+  const char *env_cpi = getenv("BENCH_M4_CPI");
+  double host_ghz = env_ghz ? atof(env_ghz) : 3.0;
+  double m4_cpi = env_cpi ? atof(env_cpi) : 2.5;
+  stream_t s = {.buf = malloc(BENCH_STREAM_MAX),
+                .rec = malloc(BENCH_STREAM_MAX / CAPTURE_REC_HDR_SIZE *
+                              sizeof(uint16_t))};
+
+  if (s.buf == NULL || s.rec == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+    return 1;
+  }
+
+  fprintf(stderr, "host %.2f GHz, M4 CPI x%.2f, M4 %.0f MHz\n", host_ghz,
+          m4_cpi, BENCH_M4_HZ / 1e6);
+  fprintf(stderr, "events/err: 1 회 재생당 값, all: 스트림 전체\n");
+
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      if (load_file(&s, argv[i]) != 0) {
+        fprintf(stderr, "%s: read fail\n", argv[i]);
+        continue;
+      }
+      run(argv[i], &s, host_ghz, m4_cpi);
+    }
+  } else {
+    gen_f9p(&s);
+    run("F9P (NMEA + UBX + RTCM MSM7)", &s, host_ghz, m4_cpi);
+    s.len = 0;
+    gen_um982(&s);
+    run("UM982 (NMEA + UNICORE BIN + RTCM MSM4)", &s, host_ghz, m4_cpi);
+  }
+
+  free(s.buf);
+  free(s.rec);
+  return 0;
+}
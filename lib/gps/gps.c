@@ -1,105 +1,87 @@
 #include "gps.h"
 #include "gps_config.h"
+#include "gps_crc.h"
+#include "nmea_index.h"
 #include "parser.h"
+#include "task.h"
 #include <string.h>
 
+#if defined(USE_GPS_PARSE_CYCLES) && defined(STM32F405xx)
+#define GPS_PARSE_CYCLES
+#include "stm32f4xx.h"
+#endif
+
 #ifndef TAG
   #define TAG "GPS_PARSE"
 #endif
 
 #include "log.h"
 
-static inline void add_nmea_chksum(gps_t *gps, char ch);
-static inline uint8_t check_nmea_chksum(gps_t *gps);
-static inline void term_add(gps_t *gps, char ch);
-static inline void term_next(gps_t *gps);
-
-void _gps_gga_raw_add(gps_t *gps, char ch) {
-  if (gps->nmea_data.gga_raw_pos < 99) {
-    gps->nmea_data.gga_raw[gps->nmea_data.gga_raw_pos] = ch;
-    gps->nmea_data.gga_raw[++gps->nmea_data.gga_raw_pos] = '\0';
-  }
-}
-
-bool get_gga(gps_t *gps, char *buf, uint8_t *len) {
-  bool ret = false;
-
-  // xSemaphoreTake(gps->mutex, portMAX_DELAY);
-  if (gps->nmea_data.gga_is_rdy && gps->nmea_data.gga.fix != GPS_FIX_INVALID) {
-    strncpy(buf, gps->nmea_data.gga_raw, gps->nmea_data.gga_raw_pos + 1);
-    *len = gps->nmea_data.gga_raw_pos;
-    ret = true;
-  }
-  // xSemaphoreGive(gps->mutex);
-
-  return ret;
-}
+static void parse_unicore(gps_t *gps, uint8_t ch);
 
 /**
- * @brief NMEA 프로토콜 체크섬 추가
+ * @brief 마지막으로 발행된 GGA 원문 복사
  *
- * @param[out] gps
- * @param[in] ch
- */
-static inline void add_nmea_chksum(gps_t *gps, char ch) {
-  gps->nmea.crc ^= (uint8_t)ch;
-}
-
-/**
- * @brief NMEA 프로토콜 체크섬 확인
+ * 파서를 멈추지 않도록 mutex 대신 항법해 스냅샷에서 읽는다.
  *
  * @param[in] gps
- * @return uint8_t 1: success 0: fail
+ * @param[out] buf GPS_NMEA_GGA_RAW_SIZE 이상
+ * @param[out] len NUL 제외 길이
+ * @return true: 유효한 fix 의 GGA 있음
  */
-static inline uint8_t check_nmea_chksum(gps_t *gps) {
-  uint8_t crc = 0;
-
-  crc = (uint8_t)((((PARSER_CHAR_HEX_TO_NUM(gps->nmea.term_str[0])) & 0x0FU)
-                   << 0x04U) |
-                  ((PARSER_CHAR_HEX_TO_NUM(gps->nmea.term_str[1])) & 0x0FU));
+bool get_gga(gps_t *gps, char *buf, uint8_t *len) {
+#if defined(USE_STORE_RAW_GGA)
+  gps_solution_t sol;
 
-  if (gps->nmea.crc != crc) {
-    return 0;
+  if (!gps_snapshot_read(&gps->snapshot, &sol) || sol.gga_len == 0 ||
+      sol.fix == GPS_FIX_INVALID) {
+    return false;
   }
 
-  return 1;
+  memcpy(buf, sol.gga_raw, sol.gga_len + 1);
+  *len = sol.gga_len;
+  return true;
+#else
+  (void)gps;
+  (void)buf;
+  (void)len;
+  return false;
+#endif
 }
 
 /**
- * @brief 프로토콜 페이로드 추가
+ * @brief 프레임 시작 문자 LUT
  *
- * @param[inout] gps
- * @param[in] ch
+ * @note '$'(NMEA, UNICORE ASCII), 0xB5(UBX), 0xAA(UNICORE BIN), 0xD3(RTCM3)
  */
-static inline void add_payload(gps_t *gps, char ch) {
-  if (gps->pos < GPS_PAYLOAD_SIZE - 1) {
-    gps->payload[gps->pos] = ch;
-    gps->payload[++gps->pos] = 0;
-  }
-}
+static const uint8_t gps_sync_lut[256] = {
+  ['$'] = 1,
+  [0xB5] = 1,
+  [0xAA] = 1,
+  [0xD3] = 1,
+};
 
 /**
- * @brief NMEA183 프로토콜 , 사이에 있는 문자 추가
+ * @brief 프레임 시작 문자까지 건너뛰기
  *
- * @param[inout] gps
- * @param[in] ch
+ * @param[in] d 검색 시작 위치
+ * @param[in] end 검색 끝 위치
+ * @return const uint8_t* 시작 문자 위치, 없으면 end
  */
-static inline void term_add(gps_t *gps, char ch) {
-  if (gps->nmea.term_pos < GPS_NMEA_TERM_SIZE - 1) {
-    gps->nmea.term_str[gps->nmea.term_pos] = ch;
-    gps->nmea.term_str[++gps->nmea.term_pos] = 0;
+static inline const uint8_t *find_sync(const uint8_t *d, const uint8_t *end) {
+  while (end - d >= 4) {
+    if (gps_sync_lut[d[0]]) return d;
+    if (gps_sync_lut[d[1]]) return d + 1;
+    if (gps_sync_lut[d[2]]) return d + 2;
+    if (gps_sync_lut[d[3]]) return d + 3;
+    d += 4;
   }
-}
 
-/**
- * @brief NMEA183 프로토콜 , 파싱후 초기화
- *
- * @param[out] gps
- */
-static inline void term_next(gps_t *gps) {
-  gps->nmea.term_str[0] = 0;
-  gps->nmea.term_pos = 0;
-  gps->nmea.term_num++;
+  while (d < end && !gps_sync_lut[*d]) {
+    d++;
+  }
+
+  return d;
 }
 
 static inline void term_add_unicore(gps_t *gps, char ch) {
@@ -144,243 +126,682 @@ static inline uint8_t check_unicore_chksum(gps_t *gps) {
  */
 void gps_init(gps_t *gps) {
   memset(gps, 0, sizeof(*gps));
+  gps_crc_init();
   gps->mutex = xSemaphoreCreateMutex();
   ubx_cmd_handler_init(&gps->ubx_cmd_handler);
   ubx_init_context_init(&gps->ubx_init_ctx);
+  gps_snapshot_init(&gps->snapshot);
+
+#if defined(GPS_PARSE_CYCLES)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 }
 
 /**
- * @brief GPS 프로토콜 파싱
+ * @brief 수신 프레임 구간 초기화
+ *
+ * @param[out] gps
+ */
+static inline void frame_reset(gps_t *gps) {
+  memset(&gps->frame, 0, sizeof(gps->frame));
+  gps->pos = 0;
+}
+
+/**
+ * @brief 수신 프레임 구간 추가
+ *
+ * 이전 구간과 이어지는 데이터는 구간 길이만 늘리고, 링 버퍼 wrap 으로
+ * 끊긴 경우 두번째 구간을 시작한다.
  *
  * @param[inout] gps
- * @param[in] data
+ * @param[in] data 수신 버퍼 위치
  * @param[in] len
+ * @return true: success false: 구간이 3개 이상으로 나뉨
  */
-void gps_parse_process(gps_t *gps, const void *data, size_t len) {
-  const uint8_t *d = data;
+bool _gps_frame_add(gps_t *gps, const uint8_t *data, size_t len) {
+  gps_frame_t *frame = &gps->frame;
+  gps_span_t *seg = frame->seg[1].len ? &frame->seg[1] : &frame->seg[0];
 
-  for (; len > 0; ++d, --len) {
-    /* @TODO GPS_PROTOCOL_NONE 일때 start 문자 찾는걸 만들고, 프로토콜에 따라
-     * 다르게 파싱하게끔 만들기 */
-    if (gps->protocol == GPS_PROTOCOL_NONE) {
-      if (*d == '$') {
-        memset(gps->nmea.term_str, 0, sizeof(gps->nmea.term_str));
-        gps->nmea.term_pos = 0;
-        gps->nmea.term_num = 0;
-        memset(&gps->nmea, 0, sizeof(gps->nmea));
-
-        gps->protocol = GPS_PROTOCOL_NMEA;
-        gps->state = GPS_PARSE_STATE_NMEA_START;
-      } 
-      /* UBX binary */
-      else if (*d == 0xB5 && gps->state == GPS_PARSE_STATE_NONE) {
-        gps->state = GPS_PARSE_STATE_UBX_SYNC_1;
-      } 
-      else if (*d == 0x62 && gps->state == GPS_PARSE_STATE_UBX_SYNC_1) {
-        memset(gps->payload, 0, sizeof(gps->payload));
-        memset(&gps->ubx, 0, sizeof(gps->ubx));
-        gps->pos = 0;
-
-        gps->protocol = GPS_PROTOCOL_UBX;
-        gps->state = GPS_PARSE_STATE_UBX_SYNC_2;
-      } 
-      /* UNICORE binary */
-      else if(*d == 0xAA && gps->state == GPS_PARSE_STATE_NONE) {
-        gps->state = GPS_PARSE_STATE_UNICORE_SYNC1;
-        memset(gps->payload, 0, sizeof(gps->payload));
-        gps->pos = 0;
-        add_payload(gps, *d);
-      } else if(*d == 0x44 && gps->state == GPS_PARSE_STATE_UNICORE_SYNC1) {
-        gps->state = GPS_PARSE_STATE_UNICORE_SYNC2;
-        add_payload(gps, *d);
-      } else if(*d == 0xB5 && gps->state == GPS_PARSE_STATE_UNICORE_SYNC2) {
-        memset(&gps->unicore_bin, 0, sizeof(gps->unicore_bin));
-        add_payload(gps, *d);
-
-        gps->protocol = GPS_PROTOCOL_UNICORE_BIN;
-        gps->state = GPS_PARSE_STATE_UNICORE_SYNC3;
-      }
-      /* RTCM3 */
-      else if(*d == 0xD3 && gps->state == GPS_PARSE_STATE_NONE) {
-        memset(&gps->rtcm, 0, sizeof(gps->rtcm));
-        memset(gps->payload, 0, sizeof(gps->payload));
-        gps->pos = 0;
-        add_payload(gps, *d);
-        gps->protocol = GPS_PROTOCOL_RTCM;
-        gps->state = GPS_PARSE_STATE_RTCM_PREAMBLE;
-      }
-      else {
-        gps->state = GPS_PARSE_STATE_NONE;
-
-        if (*d == '$') {
-          memset(gps->nmea.term_str, 0, sizeof(gps->nmea.term_str));
-          gps->nmea.term_pos = 0;
-          gps->nmea.term_num = 0;
-          memset(&gps->nmea, 0, sizeof(gps->nmea));
-          gps->protocol = GPS_PROTOCOL_NMEA;
-          gps->state = GPS_PARSE_STATE_NMEA_START;
-        } else if (*d == 0xD3) {
-          memset(&gps->rtcm, 0, sizeof(gps->rtcm));
-          memset(gps->payload, 0, sizeof(gps->payload));
-          gps->pos = 0;
-          add_payload(gps, *d);
-          gps->protocol = GPS_PROTOCOL_RTCM;
-          gps->state = GPS_PARSE_STATE_RTCM_PREAMBLE;
-        }else if (*d == 0xB5) {
-          gps->state = GPS_PARSE_STATE_UBX_SYNC_1;
-          memset(gps->payload, 0, sizeof(gps->payload));
-        } else if (*d == 0xAA) {
-          gps->state = GPS_PARSE_STATE_UNICORE_SYNC1;
-          memset(gps->payload, 0, sizeof(gps->payload));
-          gps->pos = 0;
-          add_payload(gps, *d);
-        }
-      }
-    } 
-    else if (gps->protocol == GPS_PROTOCOL_NMEA) {
-#if defined(USE_STORE_RAW_GGA)
-      if (gps->nmea.msg_type == GPS_NMEA_MSG_GGA) {
-        _gps_gga_raw_add(gps, *d);
-      }
-#endif
+  if (len == 0) {
+    return true;
+  }
 
-      if (*d == ',') {
-            if (gps->nmea.term_num == 0 && strcmp(gps->nmea.term_str, "command") == 0) {
-
-            	memset(&gps->unicore, 0, sizeof(gps->unicore));
-            	gps->unicore.crc = gps->nmea.crc;
-            	memset(&gps->nmea, 0, sizeof(gps->nmea));
-              gps->protocol = GPS_PROTOCOL_UNICORE;
-              gps->state = GPS_PARSE_STATE_UNICORE_START;
-              gps->unicore.msg_type = GPS_UNICORE_MSG_COMMAND;
-              add_unicore_chksum(gps, *d);
-              term_next_unicore(gps);
-            } else {
-              gps_parse_nmea_term(gps);
-              add_nmea_chksum(gps, *d);
-              term_next(gps);
-            }
-      }
-      else if (*d == '*') {
-        gps_parse_nmea_term(gps);
-        gps->nmea.star = 1;
-        term_next(gps);
+  if (seg->len == 0) {
+    seg->ptr = data;
+    seg->len = len;
+  } else if (seg->ptr + seg->len == data) {
+    seg->len += len;
+  } else if (seg == &frame->seg[0]) {
+    frame->seg[1].ptr = data;
+    frame->seg[1].len = len;
+  } else {
+    return false;
+  }
 
-        gps->state = GPS_PARSE_STATE_NMEA_CHKSUM;
-      } else if (*d == '\r') {
-        if (check_nmea_chksum(gps)) {
+  gps->pos += len;
+  return true;
+}
 
-#if defined(USE_STORE_RAW_GGA)
-          if (gps->nmea.msg_type == GPS_NMEA_MSG_GGA) {
-            _gps_gga_raw_add(gps, *d);
-            _gps_gga_raw_add(gps, '\n');
-            gps->nmea_data.gga_is_rdy = true;
-          }
+/**
+ * @brief 처리중인 바이너리 프레임 버림
+ *
+ * 프레임 구간은 그대로 두고 재동기 대기 상태로 바꾼다. 버린 바이트는
+ * gps_parse_process 에서 다음 동기 문자를 다시 찾는다.
+ *
+ * @param[inout] gps
+ * @param[inout] cause 원인별 통계 (NULL 가능)
+ */
+void _gps_frame_drop(gps_t *gps, uint32_t *cause) {
+  gps->stats.resync++;
+  if (cause) {
+    (*cause)++;
+  }
+
+  gps->protocol = GPS_PROTOCOL_NONE;
+  gps->state = GPS_PARSE_STATE_RESYNC;
+}
+
+/**
+ * @brief 파싱 완료 이벤트 발생
+ *
+ * 프로토콜별 프레임 수와 핸들러 최대 처리 시간을 함께 기록한다.
+ *
+ * @param[inout] gps
+ * @param[in] protocol GPS_PROTOCOL_CNT 미만
+ * @param[in] msg
+ */
+void _gps_emit(gps_t *gps, gps_procotol_t protocol, gps_msg_t msg) {
+  gps->stats.frames[protocol]++;
+
+  if (!gps->handler) {
+    return;
+  }
+
+#if defined(GPS_PARSE_CYCLES)
+  uint32_t start = DWT->CYCCNT;
+  gps->handler(gps, GPS_EVENT_DATA_PARSED, protocol, msg);
+  uint32_t cycles = DWT->CYCCNT - start;
+
+  if (cycles > gps->stats.handler_max) {
+    gps->stats.handler_max = cycles;
+  }
+#else
+  gps->handler(gps, GPS_EVENT_DATA_PARSED, protocol, msg);
 #endif
-          gps_msg_t msg;
-          msg.nmea = gps->nmea.msg_type;
-          
-          if (gps->handler) {
-            gps->handler(gps, GPS_EVENT_DATA_PARSED, GPS_PROTOCOL_NMEA, msg);
-          }
-        }
+}
 
-        memset(gps->payload, 0, sizeof(gps->payload));
+/**
+ * @brief 처리중인 문장 버림
+ *
+ * @param[inout] gps
+ * @param[inout] cause 원인별 통계 (NULL 가능)
+ */
+static inline void line_drop(gps_t *gps, uint32_t *cause) {
+  gps->stats.discarded += gps->nmea.line_len + 1; // '$' 포함
+  gps->stats.resync++;
+  if (cause) {
+    (*cause)++;
+  }
 
-        gps->protocol = GPS_PROTOCOL_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
-      } else {
-        if (!gps->nmea.star) {
-          add_nmea_chksum(gps, *d);
-        }
-        term_add(gps, *d);
-      }
-    } else if (gps->protocol == GPS_PROTOCOL_UBX) {
-      add_payload(gps, *d);
-      gps_parse_ubx(gps);
-    } 
-    else if(gps->protocol == GPS_PROTOCOL_UNICORE)
-    {
-      if (*d == ',') {
-        gps_parse_unicore_term(gps);
-        
-        if (!gps->unicore.colon) {
-          add_unicore_chksum(gps, *d);
-        }
-        term_next_unicore(gps);
-      }
-      else if (*d == ':') {
-        // ':' 이후는 값이므로 CRC에 포함하지 않음
-        gps->unicore.colon = 1;
-        add_unicore_chksum(gps, *d);  // ':' 자체는 CRC에 포함
-        term_add_unicore(gps, *d);
-      }
-      else if (*d == '*') {
-        gps_parse_unicore_term(gps);
-        gps->unicore.star = 1;
-        term_next_unicore(gps);
-        gps->state = GPS_PARSE_STATE_UNICORE_CHKSUM;
-      } else if (*d == '\r') {
-        if (check_unicore_chksum(gps)) {
-          gps_msg_t msg;
-          msg.unicore.response = gps->unicore.response;
-
-          if (gps->handler) {
-            gps->handler(gps, GPS_EVENT_DATA_PARSED, gps->protocol, msg);
-          }
-        }
+  gps->protocol = GPS_PROTOCOL_NONE;
+  gps->state = GPS_PARSE_STATE_NONE;
+}
 
-        memset(&gps->unicore, 0, sizeof(gps->unicore));
-        memset(gps->payload, 0, sizeof(gps->payload));
-        gps->protocol = GPS_PROTOCOL_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
-      } else {
-        if (!gps->unicore.star && !gps->unicore.colon) {
-          add_unicore_chksum(gps, *d);
-        }
+/**
+ * @brief 프레임 데이터 복사
+ *
+ * @param[in] frame
+ * @param[in] offset 프레임 시작(sync) 기준 위치
+ * @param[out] dst
+ * @param[in] len
+ * @return size_t 복사한 바이트 수
+ */
+size_t gps_frame_read(const gps_frame_t *frame, size_t offset, void *dst,
+                      size_t len) {
+  uint8_t *out = dst;
+  size_t done = 0;
 
-        term_add_unicore(gps, *d);
-      }
+  for (int i = 0; i < 2 && done < len; i++) {
+    const gps_span_t *seg = &frame->seg[i];
+
+    if (offset >= seg->len) {
+      offset -= seg->len;
+      continue;
     }
-    else if( gps->protocol == GPS_PROTOCOL_UNICORE_BIN)
-    {
-      add_payload(gps, *d);
-      gps_parse_unicore_bin(gps);
+
+    size_t n = seg->len - offset;
+    if (n > len - done) {
+      n = len - done;
     }
-    else if (gps->protocol == GPS_PROTOCOL_RTCM) {
-      add_payload(gps, *d);
-      if (gps->state == GPS_PARSE_STATE_RTCM_PREAMBLE) {
-    	gps->rtcm.msg_len = (*d & 0x03) << 8;
-        gps->state = GPS_PARSE_STATE_RTCM_LEN_1;
-      }
-      else if (gps->state == GPS_PARSE_STATE_RTCM_LEN_1) {
-        gps->rtcm.msg_len |= *d;
-        gps->rtcm.total_len = 3 + gps->rtcm.msg_len + 3;  // 헤더(3) + 페이로드 + CRC(3)
-        gps->rtcm.payload_cnt = 0;
-        gps->state = GPS_PARSE_STATE_RTCM_PAYLOAD;
+
+    memcpy(&out[done], &seg->ptr[offset], n);
+    done += n;
+    offset = 0;
+  }
+
+  return done;
+}
+
+/**
+ * @brief 프레임 1바이트 읽기
+ *
+ * @param[in] frame
+ * @param[in] offset 프레임 시작(sync) 기준 위치
+ * @return uint8_t 범위를 벗어나면 0
+ */
+uint8_t gps_frame_byte(const gps_frame_t *frame, size_t offset) {
+  if (offset < frame->seg[0].len) {
+    return frame->seg[0].ptr[offset];
+  }
+
+  offset -= frame->seg[0].len;
+  if (offset < frame->seg[1].len) {
+    return frame->seg[1].ptr[offset];
+  }
+
+  return 0;
+}
+
+/**
+ * @brief NMEA 프레임 시작
+ *
+ * @param[out] gps
+ */
+static inline void start_nmea(gps_t *gps) {
+  gps->nmea.line_len = 0;
+  gps->protocol = GPS_PROTOCOL_NMEA;
+  gps->state = GPS_PARSE_STATE_NMEA_START;
+}
+
+/**
+ * @brief RTCM3 프레임 시작
+ *
+ * @param[out] gps
+ * @param[in] d preamble(0xD3) 위치
+ */
+static inline void start_rtcm(gps_t *gps, const uint8_t *d) {
+  memset(&gps->rtcm, 0, sizeof(gps->rtcm));
+  gps->rtcm.crc = gps_crc24q_update(0, d, 1);
+  frame_reset(gps);
+  _gps_frame_add(gps, d, 1);
+  gps->protocol = GPS_PROTOCOL_RTCM;
+  gps->state = GPS_PARSE_STATE_RTCM_PREAMBLE;
+}
+
+/**
+ * @brief 프레임 동기 문자 처리
+ *
+ * @param[inout] gps
+ * @param[in] d 동기 문자 위치
+ */
+static void parse_sync(gps_t *gps, const uint8_t *d) {
+  uint8_t ch = *d;
+
+  if (gps->state == GPS_PARSE_STATE_UBX_SYNC_1 && ch == 0x62) {
+    if (_gps_frame_add(gps, d, 1)) {
+      memset(&gps->ubx, 0, sizeof(gps->ubx));
+      gps->protocol = GPS_PROTOCOL_UBX;
+      gps->state = GPS_PARSE_STATE_UBX_SYNC_2;
+      return;
+    }
+  }
+
+  if (gps->state == GPS_PARSE_STATE_UNICORE_SYNC1 &&
+      ch == GPS_UNICORE_BIN_SYNC_2) {
+    if (_gps_frame_add(gps, d, 1)) {
+      gps->state = GPS_PARSE_STATE_UNICORE_SYNC2;
+      return;
+    }
+  }
+
+  if (gps->state == GPS_PARSE_STATE_UNICORE_SYNC2 &&
+      ch == GPS_UNICORE_BIN_SYNC_3) {
+    if (_gps_frame_add(gps, d, 1)) {
+      static const uint8_t sync[] = {GPS_UNICORE_BIN_SYNC_1, GPS_UNICORE_BIN_SYNC_2,
+                                     GPS_UNICORE_BIN_SYNC_3};
+
+      memset(&gps->unicore_bin, 0, sizeof(gps->unicore_bin));
+      gps->unicore_bin.crc_calc = gps_crc32(sync, sizeof(sync));
+      gps->protocol = GPS_PROTOCOL_UNICORE_BIN;
+      gps->state = GPS_PARSE_STATE_UNICORE_SYNC3;
+      return;
+    }
+  }
+
+  /* 동기 문자가 이어지지 않으면 현재 문자를 새 프레임 시작으로 다시 판단 */
+  if (gps->state != GPS_PARSE_STATE_NONE) {
+    gps->stats.discarded += gps->pos;
+  }
+  gps->state = GPS_PARSE_STATE_NONE;
+
+  switch (ch) {
+  case '$':
+    start_nmea(gps);
+    break;
+
+  case 0xB5:
+    frame_reset(gps);
+    _gps_frame_add(gps, d, 1);
+    gps->state = GPS_PARSE_STATE_UBX_SYNC_1;
+    break;
+
+  case GPS_UNICORE_BIN_SYNC_1:
+    frame_reset(gps);
+    _gps_frame_add(gps, d, 1);
+    gps->state = GPS_PARSE_STATE_UNICORE_SYNC1;
+    break;
+
+  case 0xD3:
+    start_rtcm(gps, d);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief NMEA183 문장 완료 처리
+ *
+ * 문장 인덱스를 만들어 체크섬을 확인하고 디코더로 넘긴다.
+ * UNICORE command 응답은 UNICORE ASCII 파서로 넘긴다.
+ *
+ * @param[inout] gps
+ */
+static void parse_nmea_line(gps_t *gps) {
+  nmea_index_t idx;
+  bool chksum_ok =
+      nmea_index_build(&idx, gps->nmea.line, gps->nmea.line_len);
+
+  gps->protocol = GPS_PROTOCOL_NONE;
+  gps->state = GPS_PARSE_STATE_NONE;
+
+  if (nmea_field_equal(&idx, 0, "command")) {
+    memset(&gps->unicore, 0, sizeof(gps->unicore));
+    gps->protocol = GPS_PROTOCOL_UNICORE;
+    gps->state = GPS_PARSE_STATE_UNICORE_START;
+    gps->unicore.msg_type = GPS_UNICORE_MSG_COMMAND;
+
+    for (uint8_t i = 0; i < gps->nmea.line_len; i++) {
+      parse_unicore(gps, (uint8_t)gps->nmea.line[i]);
+    }
+    parse_unicore(gps, '\r');
+    return;
+  }
+
+  if (!chksum_ok) {
+    gps->stats.chksum_err[GPS_PROTOCOL_NMEA]++;
+    gps->stats.discarded += gps->nmea.line_len + 2; // '$', '\r' 포함
+    return;
+  }
+
+  gps_msg_t msg;
+  msg.nmea = gps_parse_nmea_sentence(&gps->nmea_data, &idx);
+
+  if (msg.nmea != GPS_NMEA_MSG_NONE) {
+    _gps_emit(gps, GPS_PROTOCOL_NMEA, msg);
+  }
+}
+
+/**
+ * @brief NMEA183 프로토콜 처리
+ *
+ * '\r' 까지 문장 버퍼에 모은 뒤 한번에 처리한다.
+ * 문장이 버퍼보다 길면 버리고 다음 '$' 부터 다시 동기한다.
+ * 문장이 끝나기 전에 동기 문자가 나오면 잘린 문장으로 보고 버린 뒤 그 위치부터
+ * 다시 동기한다 (바이너리 프레임 안의 '$' 에서 시작한 경우 포함).
+ *
+ * @param[inout] gps
+ * @param[in] data
+ * @param[in] len
+ * @return size_t 처리한 바이트 수
+ */
+static size_t parse_nmea(gps_t *gps, const uint8_t *data, size_t len) {
+  const uint8_t *cr = memchr(data, '\r', len);
+  size_t n = cr ? (size_t)(cr - data) : len;
+  const uint8_t *sync = find_sync(data, data + n);
+
+  if (sync < data + n) {
+    line_drop(gps, NULL);
+    return sync - data;
+  }
+
+  if (gps->nmea.line_len + n > GPS_NMEA_LINE_SIZE - 1) {
+    gps->stats.discarded += n;
+    line_drop(gps, &gps->stats.overflow);
+    return n;
+  }
+
+  memcpy(&gps->nmea.line[gps->nmea.line_len], data, n);
+  gps->nmea.line_len += n;
+
+  if (!cr) {
+    return n;
+  }
+
+  gps->nmea.line[gps->nmea.line_len] = '\0';
+  parse_nmea_line(gps);
+
+  /* 같은 수신 구간에 있으면 '\n' 까지 소비 (건너뛴 바이트로 세지 않음) */
+  if (n + 1 < len && cr[1] == '\n') {
+    return n + 2;
+  }
+
+  return n + 1;
+}
+
+/**
+ * @brief UNICORE ASCII 프로토콜 1바이트 처리
+ *
+ * @param[inout] gps
+ * @param[in] ch
+ */
+static void parse_unicore(gps_t *gps, uint8_t ch) {
+  if (ch == ',') {
+    gps_parse_unicore_term(gps);
+
+    if (!gps->unicore.colon) {
+      add_unicore_chksum(gps, ch);
+    }
+    term_next_unicore(gps);
+  } else if (ch == ':') {
+    // ':' 이후는 값이므로 CRC에 포함하지 않음
+    gps->unicore.colon = 1;
+    add_unicore_chksum(gps, ch); // ':' 자체는 CRC에 포함
+    term_add_unicore(gps, ch);
+  } else if (ch == '*') {
+    gps_parse_unicore_term(gps);
+    gps->unicore.star = 1;
+    term_next_unicore(gps);
+    gps->state = GPS_PARSE_STATE_UNICORE_CHKSUM;
+  } else if (ch == '\r') {
+    if (check_unicore_chksum(gps)) {
+      gps_msg_t msg;
+      msg.unicore.response = gps->unicore.response;
+      _gps_emit(gps, GPS_PROTOCOL_UNICORE, msg);
+    } else {
+      gps->stats.chksum_err[GPS_PROTOCOL_UNICORE]++;
+    }
+
+    memset(&gps->unicore, 0, sizeof(gps->unicore));
+    gps->protocol = GPS_PROTOCOL_NONE;
+    gps->state = GPS_PARSE_STATE_NONE;
+  } else {
+    if (!gps->unicore.star && !gps->unicore.colon) {
+      add_unicore_chksum(gps, ch);
+    }
+
+    term_add_unicore(gps, ch);
+  }
+}
+
+/**
+ * @brief RTCM3 프레임 처리
+ *
+ * 헤더(3byte)로 길이를 알고 나면 나머지 프레임은 수신 버퍼 구간으로만 기록한다.
+ * CRC24Q는 수신하면서 누적하고, 불일치하면 이벤트 없이 프레임을 버린다.
+ * 길이 앞 예약 비트(6bit)가 0이 아니면 헤더에서 바로 버린다.
+ *
+ * @param[inout] gps
+ * @param[in] data
+ * @param[in] len
+ * @return size_t 처리한 바이트 수
+ */
+static size_t parse_rtcm(gps_t *gps, const uint8_t *data, size_t len) {
+  size_t used = 0;
+
+  while (gps->pos < 3 && used < len) {
+    uint8_t ch = data[used];
+
+    if (!_gps_frame_add(gps, &data[used++], 1)) {
+      _gps_frame_drop(gps, &gps->stats.overflow);
+      return used;
+    }
+
+    gps->rtcm.crc = gps_crc24q_update(gps->rtcm.crc, &ch, 1);
+
+    if (gps->state == GPS_PARSE_STATE_RTCM_PREAMBLE) {
+      if (ch & 0xFC) {
+        _gps_frame_drop(gps, &gps->stats.len_reject);
+        return used;
       }
-      else if (gps->state == GPS_PARSE_STATE_RTCM_PAYLOAD) {
-        gps->rtcm.payload_cnt++;
-        if (gps->rtcm.payload_cnt == 1) {
-          gps->rtcm.msg_type = (*d) << 4;
-        }
-        else if (gps->rtcm.payload_cnt == 2) {
-          gps->rtcm.msg_type |= ((*d) >> 4) & 0x0F;
-        }
+      gps->rtcm.msg_len = (ch & 0x03) << 8;
+      gps->state = GPS_PARSE_STATE_RTCM_LEN_1;
+    } else {
+      gps->rtcm.msg_len |= ch;
+      gps->rtcm.total_len = 3 + gps->rtcm.msg_len + 3; // 헤더(3) + 페이로드 + CRC(3)
+      gps->state = GPS_PARSE_STATE_RTCM_PAYLOAD;
+    }
+  }
+
+  if (gps->pos < 3) {
+    return used;
+  }
+
+  uint32_t crc_pos = gps->rtcm.total_len - 3;
+  size_t need = gps->rtcm.total_len - gps->pos;
+  size_t n = (len - used < need) ? len - used : need;
+
+  if (gps->pos < crc_pos) {
+    size_t crc_len = (gps->pos + n < crc_pos) ? n : crc_pos - gps->pos;
+    gps->rtcm.crc = gps_crc24q_update(gps->rtcm.crc, &data[used], crc_len);
+  }
+
+  if (!_gps_frame_add(gps, &data[used], n)) {
+    _gps_frame_drop(gps, &gps->stats.overflow);
+    return used + n;
+  }
+  used += n;
+  gps->rtcm.payload_cnt = gps->pos - 3;
+
+  if (gps->pos >= gps->rtcm.total_len) {
+    gps->rtcm.msg_type = ((uint16_t)gps_frame_byte(&gps->frame, 3) << 4) |
+                         ((gps_frame_byte(&gps->frame, 4) >> 4) & 0x0F);
+
+    uint32_t recv_crc = ((uint32_t)gps_frame_byte(&gps->frame, crc_pos) << 16) |
+                        ((uint32_t)gps_frame_byte(&gps->frame, crc_pos + 1) << 8) |
+                        gps_frame_byte(&gps->frame, crc_pos + 2);
+
+    /* CRC 불일치 프레임은 이벤트 없이 버림 (LoRa 전송 안 함) */
+    if (recv_crc != gps->rtcm.crc) {
+      LOG_WARN("RTCM CRC mismatch: type=%d calc=0x%06X recv=0x%06X",
+               gps->rtcm.msg_type, (unsigned)gps->rtcm.crc, (unsigned)recv_crc);
+      memset(&gps->rtcm, 0, sizeof(gps->rtcm));
+      _gps_frame_drop(gps, &gps->stats.chksum_err[GPS_PROTOCOL_RTCM]);
+      return used;
+    }
+
+    gps_msg_t msg;
+    msg.rtcm.msg_type = gps->rtcm.msg_type;
+    _gps_emit(gps, GPS_PROTOCOL_RTCM, msg);
+
+    memset(&gps->rtcm, 0, sizeof(gps->rtcm));
+    gps->protocol = GPS_PROTOCOL_NONE;
+    gps->state = GPS_PARSE_STATE_NONE;
+  }
+
+  return used;
+}
+
+/**
+ * @brief 버린 프레임 재검사
+ *
+ * 버린 프레임의 두번째 바이트부터 동기 문자를 찾는다. 이번 수신 구간
+ * (data ~ d) 안에서 찾으면 그 위치부터 다시 파싱하고, 이전 수신분에서 찾으면
+ * 그 부분을 한번 더 처리한 뒤 이번 수신 구간 처음부터 이어서 파싱한다.
+ * 이전 수신분을 다시 처리하다 실패한 프레임은 재검사하지 않는다.
+ *
+ * @param[inout] gps
+ * @param[in] data 이번 수신 구간 시작
+ * @param[in] d 버린 프레임 끝
+ * @return const uint8_t* 다시 파싱할 위치
+ */
+static const uint8_t *frame_rescan(gps_t *gps, const uint8_t *data,
+                                   const uint8_t *d) {
+  gps_frame_t frame = gps->frame;
+  const uint8_t *p = NULL;
+  size_t skip = 0;
+  int i;
+
+  frame_reset(gps);
+  gps->state = GPS_PARSE_STATE_NONE;
+
+  if (gps->rescan) {
+    gps->stats.discarded += frame.seg[0].len + frame.seg[1].len;
+    return d;
+  }
+
+  /* 첫 바이트는 실패한 프레임의 동기 문자 */
+  for (i = 0; i < 2 && frame.seg[i].len; i++) {
+    const uint8_t *seg_end = frame.seg[i].ptr + frame.seg[i].len;
+
+    p = find_sync(frame.seg[i].ptr + (i == 0), seg_end);
+    if (p < seg_end) {
+      skip += p - frame.seg[i].ptr;
+      break;
+    }
+    skip += frame.seg[i].len;
+    p = NULL;
+  }
+
+  gps->stats.discarded += skip;
+
+  if (!p) {
+    return d;
+  }
+
+  gps->stats.rescan++;
+
+  if (p >= data && p < d) {
+    return p;
+  }
+
+  gps->rescan = true;
+  for (; i < 2 && frame.seg[i].len; i++) {
+    const uint8_t *from = (p >= frame.seg[i].ptr) ? p : frame.seg[i].ptr;
+    const uint8_t *to = frame.seg[i].ptr + frame.seg[i].len;
+    bool last = (data >= from && data <= to);
+
+    if (last) {
+      to = data;
+    }
+
+    gps_parse_process(gps, from, to - from);
+
+    if (last) {
+      break;
+    }
+    p = NULL;
+  }
+  gps->rescan = false;
+
+  return data;
+}
+
+/**
+ * @brief 수신이 끊긴 미완성 프레임 처리
+ *
+ * 프레임 도중 GPS_FRAME_STALL_MS 이상 수신이 없었으면 프레임을 버리고
+ * 버린 바이트에서 다시 동기한다.
+ *
+ * @param[inout] gps
+ * @param[in] data 이번 수신 구간 시작
+ */
+static void check_frame_stall(gps_t *gps, const uint8_t *data) {
+#if GPS_FRAME_STALL_MS > 0
+  TickType_t now = xTaskGetTickCount();
+  bool stalled = (gps->state != GPS_PARSE_STATE_NONE) &&
+                 (now - gps->rx_tick > pdMS_TO_TICKS(GPS_FRAME_STALL_MS));
+
+  gps->rx_tick = now;
+
+  if (!stalled) {
+    return;
+  }
+
+  if (gps->protocol == GPS_PROTOCOL_NMEA) {
+    line_drop(gps, &gps->stats.stall);
+    return;
+  }
+
+  _gps_frame_drop(gps, &gps->stats.stall);
+  frame_rescan(gps, data, data);
+#else
+  (void)gps;
+  (void)data;
+#endif
+}
 
-        if (gps->pos >= gps->rtcm.total_len) {
-          gps_msg_t msg;
-          msg.rtcm.msg_type = gps->rtcm.msg_type;
-          if (gps->handler) {
-            gps->handler(gps, GPS_EVENT_DATA_PARSED, GPS_PROTOCOL_RTCM, msg);
-          }
-
-          memset(&gps->rtcm, 0, sizeof(gps->rtcm));
-          memset(gps->payload, 0, sizeof(gps->payload));
-          gps->protocol = GPS_PROTOCOL_NONE;
-          gps->state = GPS_PARSE_STATE_NONE;
+/**
+ * @brief GPS 프로토콜 파싱
+ *
+ * 프레임 사이 구간은 시작 문자 LUT로 건너뛰고, 바이너리 프레임(UBX,
+ * UNICORE BIN, RTCM3)은 길이를 알게 된 이후 남은 부분을 span 단위로 처리한다.
+ * NMEA는 '\r' 까지 문장 단위로 모아 처리하고, UNICORE ASCII는 바이트 단위로
+ * 처리한다.
+ * 바이너리 프레임이 길이/체크섬 검사에서 실패하면 프레임 전체를 버리지 않고
+ * 두번째 바이트부터 다음 동기 문자를 다시 찾는다 (frame_rescan).
+ *
+ * @note 바이너리 프레임은 복사하지 않고 data 위치를 그대로 참조하므로, 프레임이
+ * 완료될 때까지 data 는 같은 수신 버퍼(링 버퍼) 위에서 유효해야 한다.
+ *
+ * @param[inout] gps
+ * @param[in] data
+ * @param[in] len
+ */
+void gps_parse_process(gps_t *gps, const void *data, size_t len) {
+  const uint8_t *d = data;
+  const uint8_t *end = d + len;
+
+  if (!gps->rescan) {
+    gps->stats.rx_bytes += len;
+    check_frame_stall(gps, d);
+  }
+
+  while (d < end) {
+    switch (gps->protocol) {
+    case GPS_PROTOCOL_NONE:
+      if (gps->state == GPS_PARSE_STATE_NONE) {
+        const uint8_t *s = find_sync(d, end);
+
+        gps->stats.discarded += s - d;
+        d = s;
+        if (d == end) {
+          break;
         }
       }
+      parse_sync(gps, d++);
+      break;
+
+    case GPS_PROTOCOL_NMEA:
+      d += parse_nmea(gps, d, end - d);
+      break;
+
+    case GPS_PROTOCOL_UNICORE:
+      parse_unicore(gps, *d++);
+      break;
+
+    case GPS_PROTOCOL_UBX:
+      d += gps_parse_ubx(gps, d, end - d);
+      break;
+
+    case GPS_PROTOCOL_UNICORE_BIN:
+      d += gps_parse_unicore_bin(gps, d, end - d);
+      break;
+
+    case GPS_PROTOCOL_RTCM:
+      d += parse_rtcm(gps, d, end - d);
+      break;
+
+    default:
+      gps->protocol = GPS_PROTOCOL_NONE;
+      gps->state = GPS_PARSE_STATE_NONE;
+      break;
+    }
+
+    if (gps->state == GPS_PARSE_STATE_RESYNC) {
+      d = frame_rescan(gps, data, d);
     }
   }
 }
@@ -390,3 +811,28 @@ void gps_set_evt_handler(gps_t *gps, evt_handler handler) {
     gps->handler = handler;
   }
 }
+
+/**
+ * @brief 파서 통계 복사
+ *
+ * @param[in] gps
+ * @param[out] stats
+ */
+void gps_get_parse_stats(const gps_t *gps, gps_parse_stats_t *stats) {
+  *stats = gps->stats;
+}
+
+/**
+ * @brief 수신 링 미처리량 기록
+ *
+ * 수신 태스크가 파싱 직전에 링 버퍼에 쌓인 바이트 수를 넘긴다.
+ * 최대값이 링 크기에 가까우면 DMA 가 아직 처리하지 않은 데이터를 덮어쓸 수 있다.
+ *
+ * @param[inout] gps
+ * @param[in] pending 미처리 바이트 수
+ */
+void gps_stats_rx_pending(gps_t *gps, size_t pending) {
+  if (pending > gps->stats.ring_max) {
+    gps->stats.ring_max = pending;
+  }
+}
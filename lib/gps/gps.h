@@ -4,6 +4,7 @@
 #include "FreeRTOS.h"
 #include "gps_types.h"
 #include "gps_nmea.h"
+#include "gps_snapshot.h"
 #include "gps_ubx.h"
 #include "gps_unicore.h"
 #include "semphr.h"
@@ -11,7 +12,8 @@
 #include <stdint.h>
 #include <stdio.h>
 
-#define GPS_PAYLOAD_SIZE 1029
+#define GPS_FRAME_MAX_SIZE 1029 ///< RTCM3 최대 프레임 (3 + 1023 + 3)
+#define GPS_PROTOCOL_CNT (GPS_PROTOCOL_RTCM + 1) ///< 프로토콜별 통계 배열 크기
 
 typedef struct {
   int (*init)(void);
@@ -25,6 +27,27 @@ typedef struct {
 typedef void (*evt_handler)(gps_t *gps, gps_event_t event,
                             gps_procotol_t protocol, gps_msg_t msg);
 
+/**
+ * @brief 파서 통계
+ *
+ * 파서 태스크만 기록하고, 다른 태스크는 gps_get_parse_stats() 로 복사해 읽는다.
+ * 항목마다 32bit 단위로 읽히므로 항목 사이의 시점은 조금 어긋날 수 있다.
+ * resync 는 프레임을 버린 전체 횟수이고, len_reject ~ stall 은 원인별 횟수이다.
+ */
+typedef struct {
+  uint32_t frames[GPS_PROTOCOL_CNT];     ///< 프로토콜별 이벤트를 발생시킨 프레임
+  uint32_t chksum_err[GPS_PROTOCOL_CNT]; ///< 프로토콜별 체크섬/CRC 불일치
+  uint32_t rx_bytes;   ///< 파서에 들어온 바이트
+  uint32_t discarded;  ///< 프레임 사이에서 건너뛰었거나 버린 바이트
+  uint32_t resync;     ///< 프레임을 버리고 다시 동기한 횟수
+  uint32_t rescan;     ///< 버린 프레임 안에서 다음 프레임을 찾은 횟수
+  uint32_t len_reject; ///< 헤더 길이가 메시지 최대 길이를 넘은 프레임
+  uint32_t overflow;   ///< 문장/프레임 버퍼 초과
+  uint32_t stall;      ///< 수신이 끊겨 버린 미완성 프레임
+  uint32_t handler_max; ///< 이벤트 핸들러 최대 처리 시간 [cycle]
+  uint32_t ring_max;   ///< 수신 링 최대 미처리량 [byte] (gps_stats_rx_pending)
+} gps_parse_stats_t;
+
 typedef enum {
   GPS_INIT_NONE = 0,
   GPS_INIT_CONFIG
@@ -46,8 +69,11 @@ typedef struct gps_s {
 
   /* parse */
   gps_parse_state_t state;
-  char payload[GPS_PAYLOAD_SIZE];
-  uint32_t pos;
+  gps_frame_t frame; ///< 처리중인 바이너리 프레임 (수신 버퍼 참조)
+  uint32_t pos;      ///< 프레임 누적 길이
+  uint32_t rx_tick;  ///< 마지막 수신 tick (미완성 프레임 검사)
+  bool rescan;       ///< 버린 프레임 재검사 중
+  gps_parse_stats_t stats;
 
   /* protocol header */
   gps_nmea_parser_t nmea;
@@ -60,6 +86,7 @@ typedef struct gps_s {
     uint16_t payload_cnt;  // 현재까지 받은 페이로드 바이트 수
     uint16_t total_len;    // 전체 패킷 길이 (헤더 3 + 페이로드 + CRC 3)
     uint16_t bytes_received;
+    uint32_t crc;          // 수신중 누적 CRC24Q
   } rtcm;
 
   /* info */
@@ -67,6 +94,9 @@ typedef struct gps_s {
   gps_ubx_data_t ubx_data;
   gps_unicore_bin_data_t unicore_bin_data;
 
+  /* 읽기 측 공개용 항법해 (이벤트 핸들러가 파서 문맥에서 발행) */
+  gps_snapshot_t snapshot;
+
   ubx_cmd_handler_t ubx_cmd_handler;
 
   ubx_init_context_t ubx_init_ctx;
@@ -77,10 +107,18 @@ typedef struct gps_s {
 void gps_init(gps_t *gps);
 void gps_parse_process(gps_t *gps, const void *data, size_t len);
 void gps_set_evt_handler(gps_t *gps, evt_handler handler);
+void gps_get_parse_stats(const gps_t *gps, gps_parse_stats_t *stats);
+void gps_stats_rx_pending(gps_t *gps, size_t pending);
 
 bool get_gga(gps_t *gps, char *buf, uint8_t *len);
 
+size_t gps_frame_read(const gps_frame_t *frame, size_t offset, void *dst,
+                      size_t len);
+uint8_t gps_frame_byte(const gps_frame_t *frame, size_t offset);
+
 /* internal */
-void _gps_gga_raw_add(gps_t *gps, char ch);
+bool _gps_frame_add(gps_t *gps, const uint8_t *data, size_t len);
+void _gps_frame_drop(gps_t *gps, uint32_t *cause);
+void _gps_emit(gps_t *gps, gps_procotol_t protocol, gps_msg_t msg);
 
 #endif
@@ -0,0 +1,171 @@
+#include "gps_coord.h"
+#include "parser.h"
+
+static const int64_t pow10_tbl[] = {
+    1LL,
+    10LL,
+    100LL,
+    1000LL,
+    10000LL,
+    100000LL,
+    1000000LL,
+    10000000LL,
+    100000000LL,
+    1000000000LL,
+    10000000000LL,
+    100000000000LL,
+    1000000000000LL,
+};
+
+#define POW10_MAX (sizeof(pow10_tbl) / sizeof(pow10_tbl[0]) - 1)
+
+/**
+ * @brief 10^n 으로 나누기 (0 에서 먼 쪽으로 반올림)
+ */
+static int64_t div_round(int64_t val, uint8_t n) {
+  int64_t d = pow10_tbl[n];
+
+  return (val >= 0) ? (val + d / 2) / d : (val - d / 2) / d;
+}
+
+/**
+ * @brief 부호 없는 정수를 10진 문자열로 기록
+ *
+ * @param[out] buf
+ * @param[in] val
+ * @param[in] width 최소 자리수 (앞을 0 으로 채움)
+ * @return int 기록한 문자 수
+ */
+static int put_uint(char *buf, uint64_t val, uint8_t width) {
+  char tmp[20];
+  int n = 0;
+
+  do {
+    tmp[n++] = (char)('0' + val % 10);
+    val /= 10;
+  } while (val > 0 && n < (int)sizeof(tmp));
+
+  while (n < width && n < (int)sizeof(tmp)) {
+    tmp[n++] = '0';
+  }
+
+  for (int i = 0; i < n; i++) {
+    buf[i] = tmp[n - 1 - i];
+  }
+
+  return n;
+}
+
+int64_t gps_coord_fixed_from_double(double val, uint8_t scale) {
+  if (scale > POW10_MAX) {
+    scale = POW10_MAX;
+  }
+
+  val *= (double)pow10_tbl[scale];
+
+  return (int64_t)(val >= 0 ? val + 0.5 : val - 0.5);
+}
+
+int64_t gps_coord_ndeg_from_deg(double deg) {
+  return gps_coord_fixed_from_double(deg, 9);
+}
+
+int64_t gps_coord_parse_fixed(const char *str, uint8_t frac_digits,
+                              const char **end) {
+  int64_t val = 0;
+  bool minus = false;
+  uint8_t n = 0;
+
+  if (frac_digits > 9) {
+    frac_digits = 9;
+  }
+
+  for (; *str == ' '; ++str) {
+  }
+
+  if (*str == '-') {
+    minus = true;
+    ++str;
+  } else if (*str == '+') {
+    ++str;
+  }
+
+  for (; PARSER_CHAR_IS_NUM(*str); ++str) {
+    val = val * 10 + PARSER_CHAR_DEC_TO_NUM(*str);
+  }
+
+  if (*str == '.') {
+    ++str;
+
+    for (; PARSER_CHAR_IS_NUM(*str) && n < frac_digits; ++str, ++n) {
+      val = val * 10 + PARSER_CHAR_DEC_TO_NUM(*str);
+    }
+
+    /* 버리는 첫 자리로 반올림, 나머지는 건너뜀 */
+    if (PARSER_CHAR_IS_NUM(*str) && *str >= '5') {
+      val++;
+    }
+
+    for (; PARSER_CHAR_IS_NUM(*str); ++str) {
+    }
+  }
+
+  val *= pow10_tbl[frac_digits - n];
+
+  if (end) {
+    *end = str;
+  }
+
+  return minus ? -val : val;
+}
+
+int64_t gps_coord_ndeg_from_ddmm(int64_t ddmm) {
+  /* ddmm.mmmmmmmmm -> 분 단위 1e-9 고정소수점 */
+  int64_t deg = ddmm / (100 * GPS_COORD_NDEG_PER_DEG);
+  int64_t min = ddmm - deg * 100 * GPS_COORD_NDEG_PER_DEG;
+
+  if (ddmm < 0) {
+    return 0;
+  }
+
+  return deg * GPS_COORD_NDEG_PER_DEG + (min + 30) / 60;
+}
+
+int gps_coord_format_fixed(char *buf, size_t size, int64_t val, uint8_t scale,
+                           uint8_t decimals) {
+  char tmp[32];
+  int n = 0;
+
+  if (!buf || size == 0 || scale > POW10_MAX || decimals > 9) {
+    return -1;
+  }
+
+  if (decimals < scale) {
+    val = div_round(val, scale - decimals);
+  } else if (decimals > scale) {
+    val *= pow10_tbl[decimals - scale];
+  }
+
+  uint64_t abs_val = (val < 0) ? (uint64_t)(-val) : (uint64_t)val;
+  uint64_t div = (uint64_t)pow10_tbl[decimals];
+
+  if (val < 0) {
+    tmp[n++] = '-';
+  }
+  n += put_uint(&tmp[n], abs_val / div, 1);
+  if (decimals > 0) {
+    tmp[n++] = '.';
+    n += put_uint(&tmp[n], abs_val % div, decimals);
+  }
+
+  if ((size_t)n >= size) {
+    return -1;
+  }
+
+  for (int i = 0; i < n; i++) {
+    buf[i] = tmp[i];
+  }
+  buf[n] = '\0';
+
+  return n;
+}
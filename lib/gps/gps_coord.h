@@ -0,0 +1,84 @@
+#ifndef GPS_COORD_H
+#define GPS_COORD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GPS_COORD_NDEG_PER_DEG 1000000000LL ///< 1 deg = 1e9 ndeg
+
+/**
+ * @brief 고정소수점 좌표
+ *
+ * @note Cortex-M4F 는 단정밀도 FPU 만 있으므로 double 연산은 소프트웨어로
+ * 처리된다. 좌표는 정수로 들고 다니고 출력할 때만 문자열로 바꾼다.
+ * @note UBX lat(1e-7) + lat_hp(1e-9) 는 손실 없이 표현된다.
+ */
+typedef struct {
+  int64_t lat; ///< 위도 [1e-9 deg]
+  int64_t lon; ///< 경도 [1e-9 deg]
+  int32_t alt; ///< 고도 [mm]
+} gps_coord_t;
+
+/**
+ * @brief UBX 1e-7 deg 값과 1e-9 deg 보정값을 나노도로 변환
+ *
+ * @param[in] val lat/lon [1e-7 deg]
+ * @param[in] hp lat_hp/lon_hp [1e-9 deg]
+ * @return int64_t [1e-9 deg]
+ */
+static inline int64_t gps_coord_ndeg_from_ubx(int32_t val, int8_t hp) {
+  return (int64_t)val * 100 + hp;
+}
+
+/**
+ * @brief 도 단위 double 을 나노도로 변환
+ *
+ * @note UNICORE BESTNAV 처럼 수신기가 double 로 주는 값의 입구에서만 사용
+ */
+int64_t gps_coord_ndeg_from_deg(double deg);
+
+/**
+ * @brief double 을 10^scale 배 고정소수점으로 변환 (반올림)
+ *
+ * @param[in] val
+ * @param[in] scale 소수 자리수 (최대 12)
+ * @return int64_t
+ */
+int64_t gps_coord_fixed_from_double(double val, uint8_t scale);
+
+/**
+ * @brief 10진 고정소수점 문자열 파싱
+ *
+ * "-12.3456" 을 frac_digits=3 으로 파싱하면 -12346 (반올림)
+ *
+ * @param[in] str
+ * @param[in] frac_digits 결과의 소수 자리수 (최대 9)
+ * @param[out] end 파싱이 끝난 위치 (NULL 가능)
+ * @return int64_t value * 10^frac_digits
+ */
+int64_t gps_coord_parse_fixed(const char *str, uint8_t frac_digits,
+                              const char **end);
+
+/**
+ * @brief NMEA ddmm.mmmm 고정소수점 값을 나노도로 변환
+ *
+ * @param[in] ddmm ddmm.mmmm * 1e9 (nmea_field_fixed(..., 9, ...) 결과)
+ * @return int64_t [1e-9 deg], 음수면 0
+ */
+int64_t gps_coord_ndeg_from_ddmm(int64_t ddmm);
+
+/**
+ * @brief 고정소수점 값을 10진 문자열로 변환
+ *
+ * @param[out] buf
+ * @param[in] size
+ * @param[in] val 값 (10^scale 배)
+ * @param[in] scale val 의 소수 자리수
+ * @param[in] decimals 출력 소수 자리수 (scale 보다 작으면 반올림, 크면 0 채움)
+ * @return int 기록한 문자 수 (NUL 제외), 실패시 -1
+ */
+int gps_coord_format_fixed(char *buf, size_t size, int64_t val, uint8_t scale,
+                           uint8_t decimals);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef GPS_CRC_H
+#define GPS_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief RTCM3 CRC24Q 누적 계산
+ *
+ * @param[in] crc 이전까지의 CRC (처음에는 0)
+ * @param[in] data
+ * @param[in] len
+ * @return uint32_t 24-bit CRC
+ */
+uint32_t gps_crc24q_update(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief RTCM3 CRC24Q 계산
+ *
+ * @param[in] data
+ * @param[in] len
+ * @return uint32_t 24-bit CRC
+ */
+uint32_t gps_crc24q(const uint8_t *data, size_t len);
+
+/**
+ * @brief CRC 엔진 초기화 (HW CRC 사용시 클럭 활성화)
+ *
+ */
+void gps_crc_init(void);
+
+/**
+ * @brief UNICORE 바이너리 CRC32 누적 계산
+ *
+ * @note reflected polynomial 0xEDB88320, 초기값 0, final xor 없음
+ * @note USE_GPS_HW_CRC32 정의시 target 에서는 STM32 CRC 유닛 사용,
+ * 그 외에는 slicing-by-8
+ *
+ * @param[in] crc 이전까지의 CRC (처음에는 0)
+ * @param[in] data
+ * @param[in] len
+ * @return uint32_t
+ */
+uint32_t gps_crc32_update(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief UNICORE 바이너리 CRC32 계산
+ *
+ * @param[in] data
+ * @param[in] len
+ * @return uint32_t
+ */
+uint32_t gps_crc32(const uint8_t *data, size_t len);
+
+#endif
@@ -0,0 +1,128 @@
+#include "gps_evt_queue.h"
+#include <string.h>
+
+#define EVT_MASK (GPS_EVT_QUEUE_LEN - 1)
+#define DATA_MASK (GPS_EVT_DATA_SIZE - 1)
+
+_Static_assert((GPS_EVT_QUEUE_LEN & EVT_MASK) == 0, "GPS_EVT_QUEUE_LEN must be power of 2");
+_Static_assert((GPS_EVT_DATA_SIZE & DATA_MASK) == 0, "GPS_EVT_DATA_SIZE must be power of 2");
+
+/* 상대편이 쓰는 인덱스는 acquire 로 읽고, 내 인덱스는 데이터 기록 후 release 로 공개 */
+#define LOAD_ACQ(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static void data_write(gps_evt_queue_t *q, uint32_t pos, const uint8_t *src,
+                       size_t len) {
+  size_t idx = pos & DATA_MASK;
+  size_t first = GPS_EVT_DATA_SIZE - idx;
+
+  if (first > len) {
+    first = len;
+  }
+  memcpy(&q->data[idx], src, first);
+  memcpy(q->data, &src[first], len - first);
+}
+
+static void data_read(const gps_evt_queue_t *q, uint32_t pos, uint8_t *dst,
+                      size_t len) {
+  size_t idx = pos & DATA_MASK;
+  size_t first = GPS_EVT_DATA_SIZE - idx;
+
+  if (first > len) {
+    first = len;
+  }
+  memcpy(dst, &q->data[idx], first);
+  memcpy(&dst[first], q->data, len - first);
+}
+
+void gps_evt_queue_init(gps_evt_queue_t *q) {
+  memset(q, 0, sizeof(gps_evt_queue_t));
+}
+
+bool gps_evt_queue_push(gps_evt_queue_t *q, const gps_evt_t *evt,
+                        const gps_span_t *span, uint8_t span_cnt) {
+  uint32_t head = q->evt_head;
+  uint32_t depth = head - LOAD_ACQ(&q->evt_tail);
+  uint32_t data_head = q->data_head;
+  uint32_t data_used = data_head - LOAD_ACQ(&q->data_tail);
+  size_t data_len = 0;
+
+  for (uint8_t i = 0; i < span_cnt; i++) {
+    data_len += span[i].len;
+  }
+
+  if (depth >= GPS_EVT_QUEUE_LEN || data_len > UINT16_MAX ||
+      data_len > GPS_EVT_DATA_SIZE - data_used) {
+    q->dropped++;
+    return false;
+  }
+
+  for (uint8_t i = 0; i < span_cnt; i++) {
+    data_write(q, data_head, span[i].ptr, span[i].len);
+    data_head += span[i].len;
+  }
+
+  gps_evt_t *slot = &q->evt[head & EVT_MASK];
+  *slot = *evt;
+  slot->data_len = (uint16_t)data_len;
+
+  STORE_REL(&q->data_head, data_head);
+  STORE_REL(&q->evt_head, head + 1);
+
+  q->pushed++;
+  if (depth + 1 > q->depth_max) {
+    q->depth_max = depth + 1;
+  }
+  if (data_used + data_len > q->data_max) {
+    q->data_max = data_used + data_len;
+  }
+
+  return true;
+}
+
+bool gps_evt_queue_pop(gps_evt_queue_t *q, gps_evt_t *evt, uint8_t *data,
+                       size_t size, uint32_t now) {
+  uint32_t tail = q->evt_tail;
+
+  if (tail == LOAD_ACQ(&q->evt_head)) {
+    return false;
+  }
+
+  *evt = q->evt[tail & EVT_MASK];
+
+  uint32_t data_tail = q->data_tail;
+
+  if (evt->data_len > 0) {
+    if (data && evt->data_len <= size) {
+      data_read(q, data_tail, data, evt->data_len);
+    } else {
+      evt->data_len = 0;
+    }
+  }
+  /* 레코드는 복사했으므로 데이터 링을 먼저 돌려주고 슬롯을 반환 */
+  STORE_REL(&q->data_tail, data_tail + q->evt[tail & EVT_MASK].data_len);
+  STORE_REL(&q->evt_tail, tail + 1);
+
+  uint32_t latency = now - evt->tick;
+
+  q->popped++;
+  q->latency_last = latency;
+  q->latency_sum += latency;
+  if (latency > q->latency_max) {
+    q->latency_max = latency;
+  }
+
+  return true;
+}
+
+void gps_evt_queue_get_stats(const gps_evt_queue_t *q, gps_evt_stats_t *stats) {
+  stats->pushed = q->pushed;
+  stats->dropped = q->dropped;
+  stats->popped = q->popped;
+  stats->depth = LOAD_ACQ(&q->evt_head) - LOAD_ACQ(&q->evt_tail);
+  stats->depth_max = q->depth_max;
+  stats->data_max = q->data_max;
+  stats->latency_last = q->latency_last;
+  stats->latency_max = q->latency_max;
+  stats->latency_sum = q->latency_sum;
+}
@@ -0,0 +1,110 @@
+#ifndef GPS_EVT_QUEUE_H
+#define GPS_EVT_QUEUE_H
+
+#include "gps_coord.h"
+#include "gps_nmea.h"
+#include "gps_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef GPS_EVT_QUEUE_LEN
+#define GPS_EVT_QUEUE_LEN 16   ///< 이벤트 레코드 개수 (2의 거듭제곱)
+#endif
+
+#ifndef GPS_EVT_DATA_SIZE
+#define GPS_EVT_DATA_SIZE 2048 ///< 이벤트 부가 데이터 링 크기 (2의 거듭제곱)
+#endif
+
+/**
+ * @brief 파서가 발행하는 이벤트 레코드
+ *
+ * @note 소비자는 gps_t 를 참조하지 않도록 필요한 값을 적재 시점에 복사해 둔다.
+ * 가변 길이 데이터(RTCM 프레임, GGA 원문)는 데이터 링에 data_len 만큼 함께 적재된다.
+ */
+typedef struct {
+  uint32_t tick;           ///< 적재 시각 [tick]
+  gps_procotol_t protocol;
+  gps_event_t event;
+  gps_msg_t msg;
+  gps_fix_t fix;           ///< 적재 시점 GGA fix
+  gps_coord_t pos;         ///< 위치 이벤트 좌표
+  uint16_t data_len;       ///< 데이터 링에 함께 적재한 바이트 수
+} gps_evt_t;
+
+/**
+ * @brief 이벤트 큐 통계
+ *
+ */
+typedef struct {
+  uint32_t pushed;      ///< 적재 성공
+  uint32_t dropped;     ///< 큐/데이터 링 부족으로 버린 이벤트
+  uint32_t popped;      ///< 소비 완료
+  uint32_t depth;       ///< 현재 대기중인 레코드 수
+  uint32_t depth_max;   ///< 최대 대기 레코드 수
+  uint32_t data_max;    ///< 데이터 링 최대 사용량 [byte]
+  uint32_t latency_last; ///< 마지막 이벤트 지연 [tick]
+  uint32_t latency_max;  ///< 최대 이벤트 지연 [tick]
+  uint32_t latency_sum;  ///< 누적 이벤트 지연 [tick] (평균 = sum / popped)
+} gps_evt_stats_t;
+
+/**
+ * @brief lock-free 단일 생산자/단일 소비자 이벤트 큐
+ *
+ * @note 생산자는 head 계열만, 소비자는 tail 계열만 쓴다.
+ * 인덱스는 wrap 없이 증가시키고 크기 마스크로 접근한다.
+ */
+typedef struct {
+  gps_evt_t evt[GPS_EVT_QUEUE_LEN];
+  uint8_t data[GPS_EVT_DATA_SIZE];
+
+  uint32_t evt_head;
+  uint32_t evt_tail;
+  uint32_t data_head;
+  uint32_t data_tail;
+
+  /* 생산자 기록 */
+  uint32_t pushed;
+  uint32_t dropped;
+  uint32_t depth_max;
+  uint32_t data_max;
+
+  /* 소비자 기록 */
+  uint32_t popped;
+  uint32_t latency_last;
+  uint32_t latency_max;
+  uint32_t latency_sum;
+} gps_evt_queue_t;
+
+void gps_evt_queue_init(gps_evt_queue_t *q);
+
+/**
+ * @brief 이벤트 적재 (생산자)
+ *
+ * 공간이 부족하면 기다리지 않고 버린 뒤 dropped 를 증가시킨다.
+ *
+ * @param[inout] q
+ * @param[in] evt 레코드 (data_len 은 span 합으로 덮어쓴다)
+ * @param[in] span 함께 적재할 데이터 구간 (NULL 가능)
+ * @param[in] span_cnt 구간 개수
+ * @return true: 적재 성공, false: 공간 부족
+ */
+bool gps_evt_queue_push(gps_evt_queue_t *q, const gps_evt_t *evt,
+                        const gps_span_t *span, uint8_t span_cnt);
+
+/**
+ * @brief 이벤트 꺼내기 (소비자)
+ *
+ * @param[inout] q
+ * @param[out] evt
+ * @param[out] data 부가 데이터 복사 버퍼
+ * @param[in] size 버퍼 크기 (부족하면 데이터는 버리고 data_len 을 0 으로 둔다)
+ * @param[in] now 현재 tick (지연 통계용)
+ * @return true: 이벤트 있음, false: 비어 있음
+ */
+bool gps_evt_queue_pop(gps_evt_queue_t *q, gps_evt_t *evt, uint8_t *data,
+                       size_t size, uint32_t now);
+
+void gps_evt_queue_get_stats(const gps_evt_queue_t *q, gps_evt_stats_t *stats);
+
+#endif
@@ -1,162 +1,492 @@
 #include "gps_nmea.h"
-#include "gps.h"
-#include "gps_parse.h"
+#include "gps_coord.h"
+#include "parser.h"
 #include <string.h>
 
-static double parse_lat_lon(gps_t *gps);
-static void parse_nmea_gga(gps_t *gps);
+typedef void (*nmea_decode_fn)(gps_nmea_data_t *data,
+                               const nmea_index_t *idx);
+
+/**
+ * @brief 문장 종류별 디코더
+ *
+ * @note decode 가 NULL 이면 이벤트만 발생시킨다.
+ */
+typedef struct {
+  const char *msg; ///< 주소 필드의 메시지 이름 (talker 제외)
+  gps_nmea_msg_t msg_type;
+  nmea_decode_fn decode;
+} nmea_decoder_t;
+
+static void decode_gga(gps_nmea_data_t *data, const nmea_index_t *idx);
+static void decode_ths(gps_nmea_data_t *data, const nmea_index_t *idx);
+#if defined(USE_GPS_NMEA_RMC)
+static void decode_rmc(gps_nmea_data_t *data, const nmea_index_t *idx);
+#endif
+#if defined(USE_GPS_NMEA_GST)
+static void decode_gst(gps_nmea_data_t *data, const nmea_index_t *idx);
+#endif
+#if defined(USE_GPS_NMEA_GSA)
+static void decode_gsa(gps_nmea_data_t *data, const nmea_index_t *idx);
+#endif
+#if defined(USE_GPS_NMEA_GSV)
+static void decode_gsv(gps_nmea_data_t *data, const nmea_index_t *idx);
+#endif
+#if defined(USE_GPS_NMEA_VTG)
+static void decode_vtg(gps_nmea_data_t *data, const nmea_index_t *idx);
+#endif
+#if defined(USE_GPS_NMEA_ZDA)
+static void decode_zda(gps_nmea_data_t *data, const nmea_index_t *idx);
+#endif
+
+/* 수신 빈도가 높은 순서 (GSV 는 epoch 마다 여러 문장) */
+static const nmea_decoder_t nmea_decoders[] = {
+    {"GGA", GPS_NMEA_MSG_GGA, decode_gga},
+#if defined(USE_GPS_NMEA_GSV)
+    {"GSV", GPS_NMEA_MSG_GSV, decode_gsv},
+#endif
+#if defined(USE_GPS_NMEA_GSA)
+    {"GSA", GPS_NMEA_MSG_GSA, decode_gsa},
+#endif
+#if defined(USE_GPS_NMEA_RMC)
+    {"RMC", GPS_NMEA_MSG_RMC, decode_rmc},
+#else
+    {"RMC", GPS_NMEA_MSG_RMC, NULL},
+#endif
+    {"THS", GPS_NMEA_MSG_THS, decode_ths},
+#if defined(USE_GPS_NMEA_GST)
+    {"GST", GPS_NMEA_MSG_GST, decode_gst},
+#endif
+#if defined(USE_GPS_NMEA_VTG)
+    {"VTG", GPS_NMEA_MSG_VTG, decode_vtg},
+#endif
+#if defined(USE_GPS_NMEA_ZDA)
+    {"ZDA", GPS_NMEA_MSG_ZDA, decode_zda},
+#endif
+};
 
 /**
  * @brief 십진수 도 변환
  *
- * @param[in] gps
- * @return double
+ * @param[in] idx
+ * @param[in] n 필드 번호
+ * @return int64_t [1e-9 deg], 빈 필드면 0
  */
-static double parse_lat_lon(gps_t *gps) {
-  double val, deg, min;
+static int64_t field_lat_lon(const nmea_index_t *idx, uint8_t n) {
+  int64_t ddmm = 0;
 
-  val = gps_parse_double(gps);
-  deg = (double)((int)(((int)val / 100)));
-  min = val - (deg * (double)100);
-  val = deg + (min / (double)(60));
+  nmea_field_fixed(idx, n, 9, &ddmm);
 
-  return val;
+  return gps_coord_ndeg_from_ddmm(ddmm);
 }
 
 /**
- * @brief GGA 파싱
+ * @brief hhmmss.ss 시각 필드
  *
- * @param[inout] gps
+ * @param[in] idx
+ * @param[in] n 필드 번호
+ * @param[out] hour
+ * @param[out] min
+ * @param[out] sec
+ * @return true: 6자리 이상
  */
-static void parse_nmea_gga(gps_t *gps) {
-  switch (gps->nmea.term_num) {
-  case 1: // time
-    if (gps->nmea.term_pos >= 6) {
-      gps->nmea_data.gga.hour =
-          PARSER_CHAR_DEC_TO_NUM(gps->nmea.term_str[0]) * 10 +
-          PARSER_CHAR_DEC_TO_NUM(gps->nmea.term_str[1]);
-      gps->nmea_data.gga.min =
-          PARSER_CHAR_DEC_TO_NUM(gps->nmea.term_str[2]) * 10 +
-          PARSER_CHAR_DEC_TO_NUM(gps->nmea.term_str[3]);
-      gps->nmea_data.gga.sec =
-          PARSER_CHAR_DEC_TO_NUM(gps->nmea.term_str[4]) * 10 +
-          PARSER_CHAR_DEC_TO_NUM(gps->nmea.term_str[5]);
-    }
-    break;
+static bool field_time(const nmea_index_t *idx, uint8_t n, uint8_t *hour,
+                       uint8_t *min, uint8_t *sec) {
+  uint8_t len;
+  const char *time = nmea_field_ptr(idx, n, &len);
 
-  case 2: // lat
-    gps->nmea_data.gga.lat = parse_lat_lon(gps);
-    break;
+  if (!time || len < 6) {
+    return false;
+  }
 
-  case 3: // NS
-    // S면 위도 음수
-    gps->nmea_data.gga.ns = gps->nmea.term_str[0];
-    break;
+  *hour = PARSER_CHAR_DEC_TO_NUM(time[0]) * 10 +
+          PARSER_CHAR_DEC_TO_NUM(time[1]);
+  *min = PARSER_CHAR_DEC_TO_NUM(time[2]) * 10 +
+         PARSER_CHAR_DEC_TO_NUM(time[3]);
+  *sec = PARSER_CHAR_DEC_TO_NUM(time[4]) * 10 +
+         PARSER_CHAR_DEC_TO_NUM(time[5]);
 
-  case 4: // lon
-    gps->nmea_data.gga.lon = parse_lat_lon(gps);
-    break;
+  return true;
+}
 
-  case 5: // EW
-    // W면 경도 음수
-    gps->nmea_data.gga.ew = gps->nmea.term_str[0];
-    break;
+/**
+ * @brief 고정소수점 필드, 빈 필드면 def
+ */
+static int32_t field_fixed32(const nmea_index_t *idx, uint8_t n,
+                             uint8_t frac_digits, int32_t def) {
+  int64_t val;
 
-  case 6: // quality(fix)
-    gps->nmea_data.gga.fix = gps_parse_number(gps);
-    break;
+  if (!nmea_field_fixed(idx, n, frac_digits, &val) || val > INT32_MAX ||
+      val < -INT32_MAX) {
+    return def;
+  }
 
-  case 7: // sat num
-    gps->nmea_data.gga.sat_num = gps_parse_number(gps);
-    break;
+  return (int32_t)val;
+}
 
-  case 8: // HDOP
-    gps->nmea_data.gga.hdop = gps_parse_float(gps);
-    break;
+/**
+ * @brief 정수 필드, 빈 필드면 def
+ */
+static int32_t field_int(const nmea_index_t *idx, uint8_t n, int32_t def) {
+  int32_t val;
 
-  case 9: // alt
-    gps->nmea_data.gga.alt = gps_parse_float(gps);
-    break;
+  if (!nmea_field_int32(idx, n, &val)) {
+    return def;
+  }
 
-    // case 10 : // alt unit 'M'
+  return val;
+}
 
-  case 11: // geoid separation
-    gps->nmea_data.gga.geo_sep = gps_parse_float(gps);
-    break;
+#if defined(USE_GPS_NMEA_GSA) || defined(USE_GPS_NMEA_GSV)
+/**
+ * @brief talker ID 로 system ID 추정 (NMEA 4.11 system ID 필드가 없을 때)
+ *
+ * @param[in] idx
+ * @return uint8_t 1: GPS, 2: GLONASS, 3: Galileo, 4: BeiDou, 5: QZSS, 6: NavIC,
+ * 0: 미상 (GN 등)
+ */
+static uint8_t talker_sys(const nmea_index_t *idx) {
+  const char *t = idx->str;
 
-    // case 12: // sep unit 'M'
-    // case 13: // diffAge
-    // case 14: // diffStation
+  if (t[0] == 'B' && t[1] == 'D') {
+    return 4;
+  }
+  if (t[0] != 'G') {
+    return 0;
+  }
 
+  switch (t[1]) {
+  case 'P':
+    return 1;
+  case 'L':
+    return 2;
+  case 'A':
+    return 3;
+  case 'B':
+    return 4;
+  case 'Q':
+    return 5;
+  case 'I':
+    return 6;
   default:
-    break;
+    return 0;
   }
 }
+#endif
 
-static void parse_nmea_gpths(gps_t *gps)
-{
-  switch (gps->nmea.term_num) {
-  case 1:
-    gps->nmea_data.ths.heading = gps_parse_double(gps);
-    break;
+/**
+ * @brief GGA 원문 저장 (NTRIP 서버 전송용)
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void store_gga_raw(gps_nmea_data_t *data, const nmea_index_t *idx) {
+#if defined(USE_STORE_RAW_GGA)
+  char *raw = data->gga_raw;
 
-  case 2:
-    gps->nmea_data.ths.mode = gps_parse_character(gps);
-    break;
+  /* '$' + 문장 + "\r\n" + NUL */
+  if ((size_t)idx->len + 4 > sizeof(data->gga_raw)) {
+    data->gga_is_rdy = false;
+    return;
+  }
 
-  default:
-    break;
+  raw[0] = '$';
+  memcpy(&raw[1], idx->str, idx->len);
+  raw[idx->len + 1] = '\r';
+  raw[idx->len + 2] = '\n';
+  raw[idx->len + 3] = '\0';
+  data->gga_raw_pos = idx->len + 3;
+  data->gga_is_rdy = true;
+#else
+  (void)data;
+  (void)idx;
+#endif
+}
+
+/**
+ * @brief GGA 디코딩
+ *
+ * @note 빈 필드는 0 으로 채움
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_gga(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  gps_gga_t *gga = &data->gga;
+  uint32_t u32 = 0;
+  float hdop = 0.0f;
+  float diff_age = -1.0f;
+
+  field_time(idx, 1, &gga->hour, &gga->min, &gga->sec);
+
+  gga->lat = field_lat_lon(idx, 2);
+  gga->ns = nmea_field_char(idx, 3);
+  gga->lon = field_lat_lon(idx, 4);
+  gga->ew = nmea_field_char(idx, 5);
+
+  nmea_field_uint32(idx, 6, &u32);
+  gga->fix = (gps_fix_t)u32;
+
+  u32 = 0;
+  nmea_field_uint32(idx, 7, &u32);
+  gga->sat_num = (uint8_t)u32;
+
+  nmea_field_float(idx, 8, &hdop);
+  gga->hdop = hdop;
+
+  gga->alt = field_fixed32(idx, 9, 3, 0);
+  // 10: alt unit 'M'
+  gga->geo_sep = field_fixed32(idx, 11, 3, 0);
+  // 12: sep unit 'M'
+
+  nmea_field_float(idx, 13, &diff_age);
+  gga->diff_age = diff_age;
+  gga->diff_station = (int16_t)field_int(idx, 14, -1);
+
+  store_gga_raw(data, idx);
+}
+
+/**
+ * @brief THS 디코딩
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_ths(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  data->ths.heading = field_fixed32(idx, 1, 5, 0);
+  data->ths.mode = (gps_ths_mode_t)nmea_field_char(idx, 2);
+}
+
+#if defined(USE_GPS_NMEA_RMC)
+/**
+ * @brief RMC 디코딩
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_rmc(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  gps_rmc_t *rmc = &data->rmc;
+  uint8_t len;
+  const char *date = nmea_field_ptr(idx, 9, &len);
+
+  field_time(idx, 1, &rmc->hour, &rmc->min, &rmc->sec);
+  rmc->status = nmea_field_char(idx, 2);
+  rmc->lat = field_lat_lon(idx, 3);
+  rmc->ns = nmea_field_char(idx, 4);
+  rmc->lon = field_lat_lon(idx, 5);
+  rmc->ew = nmea_field_char(idx, 6);
+  rmc->speed = field_fixed32(idx, 7, 3, 0);
+  rmc->course = field_fixed32(idx, 8, 5, -1);
+
+  /* ddmmyy */
+  if (date && len == 6) {
+    rmc->day = PARSER_CHAR_DEC_TO_NUM(date[0]) * 10 +
+               PARSER_CHAR_DEC_TO_NUM(date[1]);
+    rmc->month = PARSER_CHAR_DEC_TO_NUM(date[2]) * 10 +
+                 PARSER_CHAR_DEC_TO_NUM(date[3]);
+    rmc->year = PARSER_CHAR_DEC_TO_NUM(date[4]) * 10 +
+                PARSER_CHAR_DEC_TO_NUM(date[5]);
   }
+
+  // 10: magnetic variation, 11: mv EW
+  rmc->mode = nmea_field_char(idx, 12);
 }
+#endif
 
+#if defined(USE_GPS_NMEA_GST)
 /**
- * @brief NMEA183 프로토콜 파싱
+ * @brief GST 디코딩
  *
- * @param[inout]  gps
- * @return uint8_t 1: success, 0: fail
+ * @param[inout] data
+ * @param[in] idx
  */
-uint8_t gps_parse_nmea_term(gps_t *gps) {
-  if (gps->nmea.msg_type == GPS_NMEA_MSG_NONE) {
-    if (gps->state == GPS_PARSE_STATE_NMEA_START) {
-      const char *talker = gps->nmea.term_str;
-      const char *msg = &gps->nmea.term_str[2];
+static void decode_gst(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  gps_gst_t *gst = &data->gst;
 
-      if (!strncmp(msg, "GGA", 3)) {
-          gps->nmea.msg_type = GPS_NMEA_MSG_GGA;
+  gst->rms = field_fixed32(idx, 2, 3, -1);
+  // 3: stdMajor, 4: stdMinor, 5: orient
+  gst->std_lat = field_fixed32(idx, 6, 3, -1);
+  gst->std_lon = field_fixed32(idx, 7, 3, -1);
+  gst->std_alt = field_fixed32(idx, 8, 3, -1);
+}
+#endif
 
-#if defined(USE_STORE_RAW_GGA)
-          gps->nmea_data.gga_raw_pos = 0;
-          _gps_gga_raw_add(gps, '$');
-          for (int i = 0; i < 5; i++) {
-            _gps_gga_raw_add(gps, gps->nmea.term_str[i]);
-          }
-          _gps_gga_raw_add(gps, ',');
-          gps->nmea_data.gga_is_rdy = false;
-#endif
-
-      } else if (!strncmp(msg, "RMC", 3)) {
-        gps->nmea.msg_type = GPS_NMEA_MSG_RMC;
-      } else if (!strncmp(msg, "THS", 3)) {
-        gps->nmea.msg_type = GPS_NMEA_MSG_THS;
-      }
-      else {
-        gps->nmea.msg_type = GPS_NMEA_MSG_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
+#if defined(USE_GPS_NMEA_GSA)
+/**
+ * @brief GSA 디코딩
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_gsa(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  uint8_t sys = (uint8_t)field_int(idx, 18, talker_sys(idx));
+  gps_gsa_t *gsa;
+
+  if (sys >= GPS_NMEA_SYS_MAX) {
+    return;
+  }
+
+  gsa = &data->gsa[sys];
+  gsa->op_mode = nmea_field_char(idx, 1);
+  gsa->nav_mode = (uint8_t)field_int(idx, 2, 0);
+  gsa->sv_cnt = 0;
+
+  for (uint8_t n = 3; n < 3 + GPS_NMEA_GSA_SV_MAX; n++) {
+    int32_t sv = field_int(idx, n, 0);
+
+    if (sv > 0 && sv <= UINT8_MAX) {
+      gsa->sv_id[gsa->sv_cnt++] = (uint8_t)sv;
+    }
+  }
+
+  gsa->pdop = gsa->hdop = gsa->vdop = 99.99f;
+  nmea_field_float(idx, 15, &gsa->pdop);
+  nmea_field_float(idx, 16, &gsa->hdop);
+  nmea_field_float(idx, 17, &gsa->vdop);
+}
+
+/**
+ * @brief 전체 system 의 위치 계산 사용 위성 수
+ *
+ * @param[in] data
+ * @return uint8_t
+ */
+uint8_t gps_nmea_gsa_sv_used(const gps_nmea_data_t *data) {
+  uint8_t cnt = 0;
+
+  for (uint8_t i = 0; i < GPS_NMEA_SYS_MAX; i++) {
+    cnt += data->gsa[i].sv_cnt;
+  }
+
+  return cnt;
+}
+#endif
+
+#if defined(USE_GPS_NMEA_GSV)
+/**
+ * @brief GSV 디코딩
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_gsv(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  gps_gsv_t *gsv = &data->gsv;
+  uint8_t sys = talker_sys(idx);
+  uint8_t signal = 0;
+  uint8_t sat_fields;
+  uint8_t sat_end;
+
+  if (idx->cnt < 4) {
+    return;
+  }
 
-        return 0;
+  /* 위성 4필드 묶음 뒤에 signal ID 가 1필드 더 있을 수 있음 */
+  sat_fields = idx->cnt - 4;
+  if (sat_fields % 4 == 1) {
+    signal = (uint8_t)field_int(idx, idx->cnt - 1, 0);
+  }
+  sat_end = 4 + sat_fields - sat_fields % 4;
+
+  /* 묶음의 첫 문장이면 같은 system/signal 위성을 지움 */
+  if (field_int(idx, 2, 0) == 1) {
+    uint8_t keep = 0;
+
+    for (uint8_t i = 0; i < gsv->sat_cnt; i++) {
+      if (gsv->sat[i].sys != sys || gsv->sat[i].signal != signal) {
+        gsv->sat[keep++] = gsv->sat[i];
       }
+    }
+    gsv->sat_cnt = keep;
+  }
 
-      gps->state = GPS_PARSE_STATE_NMEA_DATA;
+  for (uint8_t n = 4; n < sat_end && gsv->sat_cnt < GPS_NMEA_GSV_SAT_MAX;
+       n += 4) {
+    gps_gsv_sat_t *sat = &gsv->sat[gsv->sat_cnt];
+    int32_t prn = field_int(idx, n, 0);
+
+    if (prn <= 0 || prn > UINT8_MAX) {
+      continue;
     }
 
-    return 1;
+    sat->sys = sys;
+    sat->signal = signal;
+    sat->prn = (uint8_t)prn;
+    sat->elev = (int8_t)field_int(idx, n + 1, INT8_MIN);
+    sat->azim = (int16_t)field_int(idx, n + 2, -1);
+    sat->cn0 = (uint8_t)field_int(idx, n + 3, 0);
+    gsv->sat_cnt++;
   }
+}
+#endif
+
+#if defined(USE_GPS_NMEA_VTG)
+/**
+ * @brief VTG 디코딩
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_vtg(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  gps_vtg_t *vtg = &data->vtg;
+
+  vtg->course = field_fixed32(idx, 1, 5, -1);
+  vtg->course_mag = field_fixed32(idx, 3, 5, -1);
+  vtg->speed = field_fixed32(idx, 5, 3, 0);
+  vtg->speed_kmh = field_fixed32(idx, 7, 3, 0);
+  vtg->mode = nmea_field_char(idx, 9);
+}
+#endif
+
+#if defined(USE_GPS_NMEA_ZDA)
+/**
+ * @brief ZDA 디코딩
+ *
+ * @param[inout] data
+ * @param[in] idx
+ */
+static void decode_zda(gps_nmea_data_t *data, const nmea_index_t *idx) {
+  gps_zda_t *zda = &data->zda;
+  int32_t sec_ms;
+
+  field_time(idx, 1, &zda->hour, &zda->min, &zda->sec);
+
+  /* hhmmss.ss 에서 소수부만 ms 로 */
+  sec_ms = field_fixed32(idx, 1, 3, 0);
+  zda->ms = (uint16_t)(sec_ms % 1000);
+
+  zda->day = (uint8_t)field_int(idx, 2, 0);
+  zda->month = (uint8_t)field_int(idx, 3, 0);
+  zda->year = (uint16_t)field_int(idx, 4, 0);
+  zda->zone_hour = (int8_t)field_int(idx, 5, 0);
+  zda->zone_min = (uint8_t)field_int(idx, 6, 0);
+}
+#endif
+
+/**
+ * @brief NMEA183 문장 디코딩
+ *
+ * 주소 필드로 디코더를 찾아 필요한 필드만 변환한다.
+ * 새 문장은 nmea_decoders 에 추가한다.
+ *
+ * @param[inout] data
+ * @param[in] idx 체크섬이 확인된 문장 인덱스
+ * @return gps_nmea_msg_t 처리하지 않는 문장이면 GPS_NMEA_MSG_NONE
+ */
+gps_nmea_msg_t gps_parse_nmea_sentence(gps_nmea_data_t *data,
+                                       const nmea_index_t *idx) {
+  for (size_t i = 0; i < sizeof(nmea_decoders) / sizeof(nmea_decoders[0]);
+       i++) {
+    const nmea_decoder_t *dec = &nmea_decoders[i];
+
+    if (!nmea_index_msg_is(idx, dec->msg)) {
+      continue;
+    }
+
+    if (dec->decode) {
+      dec->decode(data, idx);
+    }
 
-  if (gps->nmea.msg_type == GPS_NMEA_MSG_GGA) {
-    parse_nmea_gga(gps);
-  } else if (gps->nmea.msg_type == GPS_NMEA_MSG_THS) {
-	  parse_nmea_gpths(gps);
+    return dec->msg_type;
   }
 
-  return 1;
+  return GPS_NMEA_MSG_NONE;
 }
@@ -2,10 +2,12 @@
 #define GPS_NMEA_H
 
 #include "gps_types.h"
+#include "nmea_index.h"
 #include <stdbool.h>
 #include <stdint.h>
 
-#define GPS_NMEA_TERM_SIZE 20
+#define GPS_NMEA_LINE_SIZE 160 ///< UNICORE command 응답 포함
+#define GPS_NMEA_GGA_RAW_SIZE 120 ///< GGA 원문 ('$' ~ "\r\n" + NUL)
 
 /**
  * @brief GGA quality fix 상태
@@ -35,15 +37,17 @@ typedef struct {
   uint8_t hour;
   uint8_t min;
   uint8_t sec;
-  double lat;
+  int64_t lat;     ///< [1e-9 deg]
   char ns;
-  double lon;
+  int64_t lon;     ///< [1e-9 deg]
   char ew;
   gps_fix_t fix;
   uint8_t sat_num;
-  double hdop;
-  double alt;
-  double geo_sep;
+  float hdop;
+  int32_t alt;     ///< [mm]
+  int32_t geo_sep; ///< [mm]
+  float diff_age;  ///< 보정 데이터 나이 [s], 없으면 -1
+  int16_t diff_station; ///< 기준국 ID, 없으면 -1
 } gps_gga_t;
 
 typedef enum
@@ -57,10 +61,124 @@ typedef enum
 
 typedef struct
 {
-  double heading;
+  int32_t heading; ///< [1e-5 deg]
   gps_ths_mode_t mode;
 }gps_ths_t;
 
+/**
+ * @brief RMC 데이터
+ *
+ * @note 패킷 예시
+ * $xxRMC,time,status,lat,NS,lon,EW,spd,cog,date,mv,mvEW,posMode,navStatus*cs\r\n
+ */
+typedef struct {
+  uint8_t hour;
+  uint8_t min;
+  uint8_t sec;
+  char status;     ///< 'A': valid, 'V': invalid
+  int64_t lat;     ///< [1e-9 deg]
+  char ns;
+  int64_t lon;     ///< [1e-9 deg]
+  char ew;
+  int32_t speed;   ///< 대지 속도 [1e-3 knot]
+  int32_t course;  ///< 진북 기준 진행 방향 [1e-5 deg], 없으면 -1
+  uint8_t day;
+  uint8_t month;
+  uint8_t year;    ///< 2000 년 기준
+  char mode;       ///< 'A', 'D', 'R', 'F', 'N' ...
+} gps_rmc_t;
+
+/**
+ * @brief GST 데이터 (위치 오차 추정)
+ *
+ * @note 패킷 예시
+ * $xxGST,time,rangeRms,stdMajor,stdMinor,orient,stdLat,stdLong,stdAlt*cs\r\n
+ */
+typedef struct {
+  int32_t rms;     ///< 의사거리 잔차 RMS [mm]
+  int32_t std_lat; ///< 위도 표준편차 [mm]
+  int32_t std_lon; ///< 경도 표준편차 [mm]
+  int32_t std_alt; ///< 고도 표준편차 [mm]
+} gps_gst_t;
+
+#define GPS_NMEA_SYS_MAX 8 ///< NMEA 4.11 system ID (1~6) + 0(미상) 여유
+#define GPS_NMEA_GSA_SV_MAX 12
+
+/**
+ * @brief GSA 데이터 (system 별)
+ *
+ * @note 패킷 예시
+ * $xxGSA,opMode,navMode{,svid},PDOP,HDOP,VDOP,systemId*cs\r\n
+ * @note GN talker 로 시스템마다 한 문장씩 오므로 system ID 별로 저장한다.
+ */
+typedef struct {
+  char op_mode;   ///< 'M': manual, 'A': auto
+  uint8_t nav_mode; ///< 1: no fix, 2: 2D, 3: 3D
+  uint8_t sv_cnt; ///< 위치 계산에 사용한 위성 수
+  uint8_t sv_id[GPS_NMEA_GSA_SV_MAX];
+  float pdop;
+  float hdop;
+  float vdop;
+} gps_gsa_t;
+
+#define GPS_NMEA_GSV_SAT_MAX 64
+
+/**
+ * @brief GSV 위성 정보
+ */
+typedef struct {
+  uint8_t sys;    ///< system ID (1: GPS, 2: GLONASS, 3: Galileo, 4: BeiDou, 5: QZSS, 6: NavIC)
+  uint8_t signal; ///< signal ID (NMEA 4.11), 없으면 0
+  uint8_t prn;
+  int8_t elev;    ///< [deg], 없으면 -128
+  int16_t azim;   ///< [deg], 없으면 -1
+  uint8_t cn0;    ///< [dB-Hz], 추적하지 않으면 0
+} gps_gsv_sat_t;
+
+/**
+ * @brief GSV 데이터
+ *
+ * @note 패킷 예시
+ * $xxGSV,numMsg,msgNum,numSV{,svid,elv,az,cno},signalId*cs\r\n
+ * @note system/signal 조합별 첫 문장(msgNum 1)이 오면 해당 조합을 비우고 다시 채운다.
+ */
+typedef struct {
+  uint8_t sat_cnt;
+  gps_gsv_sat_t sat[GPS_NMEA_GSV_SAT_MAX];
+} gps_gsv_t;
+
+/**
+ * @brief VTG 데이터
+ *
+ * @note 패킷 예시
+ * $xxVTG,cogt,T,cogm,M,sogn,N,sogk,K,posMode*cs\r\n
+ */
+typedef struct {
+  int32_t course;     ///< 진북 기준 [1e-5 deg], 없으면 -1
+  int32_t course_mag; ///< 자북 기준 [1e-5 deg], 없으면 -1
+  int32_t speed;      ///< [1e-3 knot]
+  int32_t speed_kmh;  ///< [1e-3 km/h]
+  char mode;
+} gps_vtg_t;
+
+/**
+ * @brief ZDA 데이터
+ *
+ * @note 패킷 예시
+ * $xxZDA,time,day,month,year,ltzh,ltzn*cs\r\n
+ */
+typedef struct {
+  uint8_t hour;
+  uint8_t min;
+  uint8_t sec;
+  uint16_t ms;
+  uint8_t day;
+  uint8_t month;
+  uint16_t year;
+  int8_t zone_hour;
+  uint8_t zone_min;
+} gps_zda_t;
+
 /**
  * @brief 파싱한 NMEA 183 프로토콜 데이터
  *
@@ -68,11 +186,29 @@ typedef struct
 typedef struct {
   gps_gga_t gga;
 #if defined(USE_STORE_RAW_GGA)
-  char gga_raw[120];
+  char gga_raw[GPS_NMEA_GGA_RAW_SIZE];
   uint8_t gga_raw_pos;
   bool gga_is_rdy;
 #endif
   gps_ths_t ths;
+#if defined(USE_GPS_NMEA_RMC)
+  gps_rmc_t rmc;
+#endif
+#if defined(USE_GPS_NMEA_GST)
+  gps_gst_t gst;
+#endif
+#if defined(USE_GPS_NMEA_GSA)
+  gps_gsa_t gsa[GPS_NMEA_SYS_MAX]; ///< system ID 로 인덱스
+#endif
+#if defined(USE_GPS_NMEA_GSV)
+  gps_gsv_t gsv;
+#endif
+#if defined(USE_GPS_NMEA_VTG)
+  gps_vtg_t vtg;
+#endif
+#if defined(USE_GPS_NMEA_ZDA)
+  gps_zda_t zda;
+#endif
 } gps_nmea_data_t;
 
 /**
@@ -80,17 +216,15 @@ typedef struct {
  *
  */
 typedef struct {
-  char term_str[GPS_NMEA_TERM_SIZE];
-  uint8_t term_pos;
-  uint8_t term_num;
-
-  gps_nmea_msg_t msg_type;
-  uint8_t crc;
-  uint8_t star;
+  char line[GPS_NMEA_LINE_SIZE]; ///< '$' 다음부터 '\r' 전까지
+  uint8_t line_len;
 } gps_nmea_parser_t;
 
-typedef struct gps_s gps_t;
+gps_nmea_msg_t gps_parse_nmea_sentence(gps_nmea_data_t *data,
+                                       const nmea_index_t *idx);
 
-uint8_t gps_parse_nmea_term(gps_t *gps);
+#if defined(USE_GPS_NMEA_GSA)
+uint8_t gps_nmea_gsa_sv_used(const gps_nmea_data_t *data);
+#endif
 
 #endif
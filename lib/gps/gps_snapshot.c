@@ -0,0 +1,37 @@
+#include "gps_snapshot.h"
+#include <string.h>
+
+#define LOAD_ACQ(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+void gps_snapshot_init(gps_snapshot_t *snap) {
+  memset(snap, 0, sizeof(gps_snapshot_t));
+}
+
+void gps_snapshot_publish(gps_snapshot_t *snap, const gps_solution_t *sol) {
+  uint32_t next = snap->seq + 1;
+
+  snap->slot[next & 1] = *sol;
+  STORE_REL(&snap->seq, next);
+}
+
+bool gps_snapshot_read(const gps_snapshot_t *snap, gps_solution_t *sol) {
+  uint32_t seq = LOAD_ACQ(&snap->seq);
+
+  if (seq == 0) {
+    return false;
+  }
+
+  for (;;) {
+    *sol = snap->slot[seq & 1];
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    uint32_t now = LOAD_ACQ(&snap->seq);
+
+    /* seq + 1 이 공개됐으면 생산자가 같은 slot 에 seq + 2 를 쓰고 있을 수 있음 */
+    if (now == seq) {
+      return true;
+    }
+    seq = now;
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef GPS_SNAPSHOT_H
+#define GPS_SNAPSHOT_H
+
+#include "gps_nmea.h"
+#include "gps_types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief 수신기 종류와 무관하게 정규화한 항법해 레코드
+ *
+ * F9P(HPPOSLLH), UM982(BESTNAV) 모두 같은 단위로 채운다.
+ * LoRa/NTRIP/BLE/RS485/base auto-fix 는 이 레코드만 읽는다.
+ *
+ * @note 생산자(파서 문맥)가 필요한 값만 모아 한 번에 발행한다.
+ */
+typedef struct {
+  uint32_t tick;    ///< 발행 시각 [tick]
+  uint32_t tow;     ///< 위치 epoch GPS time of week [ms]
+  gps_procotol_t src; ///< 위치 출처 (UBX: HPPOSLLH, UNICORE_BIN: BESTNAV)
+  gps_fix_t fix;    ///< GGA quality 기준 fix 상태
+  uint8_t sat_num;  ///< 해에 사용한 위성 수
+  char ns;
+  char ew;
+  int64_t lat;      ///< [1e-9 deg]
+  int64_t lon;      ///< [1e-9 deg]
+  int64_t height;   ///< 타원체고 [0.1 mm]
+  int64_t msl;      ///< 해발고 [0.1 mm]
+  uint32_t hacc;    ///< 수평 정확도 [mm]
+  uint32_t vacc;    ///< 수직 정확도 [mm]
+  int32_t heading;  ///< [1e-5 deg]
+#if defined(USE_STORE_RAW_GGA)
+  uint8_t gga_len;  ///< GGA 원문 길이 (0: 없음)
+  char gga_raw[GPS_NMEA_GGA_RAW_SIZE];
+#endif
+} gps_solution_t;
+
+/**
+ * @brief lock-free 단일 생산자 항법해 스냅샷
+ *
+ * 생산자는 공개되지 않은 slot 에 기록한 뒤 seq 를 올려 공개하므로 기다리지 않는다.
+ * 읽기 측은 slot[seq & 1] 을 복사하고 seq 가 그대로인지 확인해, 복사 도중 생산자가
+ * 같은 slot 을 다시 쓰기 시작했으면 재시도한다.
+ *
+ * @note 생산자를 선점한 높은 우선순위 읽기도 공개된 slot 은 기록 중이 아니므로
+ * 재시도 없이 끝난다.
+ */
+typedef struct {
+  gps_solution_t slot[2];
+  uint32_t seq; ///< 발행 횟수 (0: 아직 발행 없음)
+} gps_snapshot_t;
+
+void gps_snapshot_init(gps_snapshot_t *snap);
+
+/**
+ * @brief 항법해 발행 (단일 생산자)
+ *
+ * @param[inout] snap
+ * @param[in] sol
+ */
+void gps_snapshot_publish(gps_snapshot_t *snap, const gps_solution_t *sol);
+
+/**
+ * @brief 마지막으로 발행된 항법해 복사
+ *
+ * @param[in] snap
+ * @param[out] sol
+ * @return true: 성공, false: 아직 발행 없음
+ */
+bool gps_snapshot_read(const gps_snapshot_t *snap, gps_solution_t *sol);
+
+#endif
@@ -2,6 +2,7 @@
 #define GPS_TYPES_H
 
 #include "gps_config.h"
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -71,7 +72,10 @@ typedef enum {
   GPS_PARSE_STATE_RTCM_LEN_2 = 42,
   GPS_PARSE_STATE_RTCM_PAYLOAD = 43,
   GPS_PARSE_STATE_RTCM_CRC = 44,
-  
+
+  /* 프레임 실패, 버린 바이트 재검사 대기 */
+  GPS_PARSE_STATE_RESYNC = 50,
+
   GPS_PARSE_STATE_INVALID = UINT8_MAX
 } gps_parse_state_t;
 
@@ -84,9 +88,32 @@ typedef enum {
   GPS_NMEA_MSG_GGA = 1,
   GPS_NMEA_MSG_RMC = 2,
   GPS_NMEA_MSG_THS = 3,
+  GPS_NMEA_MSG_GST = 4,
+  GPS_NMEA_MSG_GSA = 5,
+  GPS_NMEA_MSG_GSV = 6,
+  GPS_NMEA_MSG_VTG = 7,
+  GPS_NMEA_MSG_ZDA = 8,
   GPS_NMEA_MSG_INVALID = UINT8_MAX
 } gps_nmea_msg_t;
 
+/**
+ * @brief 수신 버퍼의 연속 구간
+ *
+ */
+typedef struct {
+  const uint8_t *ptr;
+  size_t len;
+} gps_span_t;
+
+/**
+ * @brief 수신 버퍼 위에 놓인 바이너리 프레임
+ *
+ * @note 링 버퍼 끝에서 wrap 되면 seg[0], seg[1] 두 구간으로 나뉜다.
+ */
+typedef struct {
+  gps_span_t seg[2];
+} gps_frame_t;
+
 typedef union {
   gps_nmea_msg_t nmea;
   struct {
@@ -1,15 +1,15 @@
 #include "gps_ubx.h"
 #include "gps.h"
-#include "gps_parse.h"
+#include <stddef.h>
 #include <string.h>
 
 #define UBX_SYNC_1 0xB5
 #define UBX_SYNC_2 0x62
+#define UBX_HEADER_SIZE 6 ///< sync(2) + class + id + length(2)
 
-static inline void calc_ubx_chksum(gps_t *gps);
+static inline void calc_ubx_chksum(gps_t *gps, const uint8_t *data, size_t len);
 static inline uint8_t check_ubx_chksum(gps_t *gps);
-static void store_ubx_nav_data(gps_t *gps);
-static void store_ubx_data(gps_t *gps);
+static bool store_ubx_data(gps_t *gps);
 static void handle_ubx_ack(gps_t *gps, uint8_t cls, uint8_t id, bool is_ack);
 static size_t ubx_build_valset_msg(uint8_t *buf, ubx_cfg_layer_t layer,
                                    const ubx_cfg_item_t *items, size_t item_count);
@@ -17,16 +17,26 @@ static uint32_t get_tick_ms(void);
 static void store_ubx_ack_data(gps_t *gps);
 
 
-static inline void calc_ubx_chksum(gps_t *gps)
+/**
+ * @brief ubx 프로토콜 체크섬 누적 (Fletcher-8)
+ *
+ * @param[inout] gps
+ * @param[in] data
+ * @param[in] len
+ */
+static inline void calc_ubx_chksum(gps_t *gps, const uint8_t *data, size_t len)
 {
-  gps->ubx.cal_chksum_a = 0;
-  gps->ubx.cal_chksum_b = 0;
+  uint8_t a = gps->ubx.cal_chksum_a;
+  uint8_t b = gps->ubx.cal_chksum_b;
 
-  for (int i = 0; i < gps->ubx.len + 4; i++)
+  for (size_t i = 0; i < len; i++)
   {
-    gps->ubx.cal_chksum_a += gps->payload[i];
-    gps->ubx.cal_chksum_b += gps->ubx.cal_chksum_a;
+    a += data[i];
+    b += a;
   }
+
+  gps->ubx.cal_chksum_a = a;
+  gps->ubx.cal_chksum_b = b;
 }
 
 /**
@@ -37,8 +47,6 @@ static inline void calc_ubx_chksum(gps_t *gps)
  */
 static inline uint8_t check_ubx_chksum(gps_t *gps)
 {
-  calc_ubx_chksum(gps);
-
   if (gps->ubx.cal_chksum_a == gps->ubx.chksum_a &&
       gps->ubx.cal_chksum_b == gps->ubx.chksum_b)
   {
@@ -49,111 +57,418 @@ static inline uint8_t check_ubx_chksum(gps_t *gps)
 }
 
 /**
- * @brief 파싱한 ubx nav 프토토콜 데이터 저장
+ * @brief UBX 메시지 저장 정보
+ *
+ * 페이로드는 dst_off 위치의 구조체에 그대로 복사한다. 반복 블록이 있는 메시지는
+ * 헤더의 블록 수(cnt_off)와 길이가 맞는지 확인하고, 저장 공간을 넘는 블록은
+ * 버리면서 블록 수를 줄여 기록한다.
+ */
+typedef struct {
+  uint8_t class;
+  uint8_t id;
+  uint16_t len;      ///< 고정 길이, 반복 블록이 있으면 블록 앞 헤더 길이
+  uint16_t block;    ///< 반복 블록 길이 (0: 고정 길이 메시지)
+  uint8_t cnt_off;   ///< 헤더 내 블록 수(U1) 위치
+  uint16_t dst_off;  ///< gps_ubx_data_t 내 저장 위치
+  uint16_t dst_size; ///< 저장 공간 크기
+  void (*post)(gps_t *gps); ///< 저장 후 처리 (NULL 가능)
+} ubx_msg_desc_t;
+
+#define UBX_MSG_FIXED(cls, msg_id, field)                                      \
+  {(cls), (msg_id), sizeof(((gps_ubx_data_t *)0)->field), 0, 0,                \
+   offsetof(gps_ubx_data_t, field), sizeof(((gps_ubx_data_t *)0)->field), NULL}
+
+#define UBX_MSG_BLOCK(cls, msg_id, field, hdr_len, blk_len, cnt_pos)           \
+  {(cls), (msg_id), (hdr_len), (blk_len), (cnt_pos),                           \
+   offsetof(gps_ubx_data_t, field), sizeof(((gps_ubx_data_t *)0)->field), NULL}
+
+_Static_assert(sizeof(gps_ubx_nav_hpposllh_t) == 36, "UBX-NAV-HPPOSLLH size");
+_Static_assert(sizeof(gps_ubx_nav_relposned_t) == 64, "UBX-NAV-RELPOSNED size");
+
+#if defined(USE_GPS_UBX_NAV_PVT)
+_Static_assert(sizeof(gps_ubx_nav_pvt_t) == 92, "UBX-NAV-PVT size");
+#endif
+#if defined(USE_GPS_UBX_NAV_SAT)
+_Static_assert(offsetof(gps_ubx_nav_sat_t, sv) == 8 &&
+                   sizeof(((gps_ubx_nav_sat_t *)0)->sv[0]) == 12,
+               "UBX-NAV-SAT layout");
+#endif
+#if defined(USE_GPS_UBX_NAV_SIG)
+_Static_assert(offsetof(gps_ubx_nav_sig_t, sig) == 8 &&
+                   sizeof(((gps_ubx_nav_sig_t *)0)->sig[0]) == 16,
+               "UBX-NAV-SIG layout");
+#endif
+#if defined(USE_GPS_UBX_NAV_SVIN)
+_Static_assert(sizeof(gps_ubx_nav_svin_t) == 40, "UBX-NAV-SVIN size");
+#endif
+#if defined(USE_GPS_UBX_RXM_RTCM)
+_Static_assert(sizeof(gps_ubx_rxm_rtcm_t) == 8, "UBX-RXM-RTCM size");
+
+static void update_rtcm_stat(gps_t *gps);
+#endif
+
+static const ubx_msg_desc_t ubx_msg_table[] = {
+#if defined(USE_GPS_UBX_NAV_PVT)
+    UBX_MSG_FIXED(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_PVT, pvt),
+#endif
+    UBX_MSG_FIXED(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_HPPOSLLH, hpposllh),
+    UBX_MSG_FIXED(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_RELPOSNED, relposned),
+#if defined(USE_GPS_UBX_NAV_SAT)
+    UBX_MSG_BLOCK(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_SAT, sat, 8, 12, 5),
+#endif
+#if defined(USE_GPS_UBX_NAV_SIG)
+    UBX_MSG_BLOCK(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_SIG, sig, 8, 16, 5),
+#endif
+#if defined(USE_GPS_UBX_NAV_SVIN)
+    UBX_MSG_FIXED(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_SVIN, svin),
+#endif
+#if defined(USE_GPS_UBX_RXM_RTCM)
+    {GPS_UBX_CLASS_RXM, GPS_UBX_RXM_ID_RTCM, sizeof(gps_ubx_rxm_rtcm_t), 0, 0,
+     offsetof(gps_ubx_data_t, rtcm), sizeof(gps_ubx_rxm_rtcm_t),
+     update_rtcm_stat},
+#endif
+};
+
+#define UBX_MSG_TABLE_CNT (sizeof(ubx_msg_table) / sizeof(ubx_msg_table[0]))
+
+/**
+ * @brief UBX 메시지별 최대 페이로드 길이
+ *
+ * 헤더 길이가 이보다 크면 길이 필드가 깨진 것으로 보고 페이로드를 기다리지 않고
+ * 바로 재동기한다. 저장 여부(USE_GPS_UBX_*)와 관계없이 길이가 정해진 메시지만
+ * 두고, 표에 없는 메시지는 GPS_FRAME_MAX_SIZE 까지 허용한다.
+ */
+static const struct
+{
+  uint8_t class;
+  uint8_t id;
+  uint16_t max_len;
+} ubx_len_table[] = {
+    {GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_PVT, 92},
+    {GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_HPPOSLLH, 36},
+    {GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_SVIN, 40},
+    {GPS_UBX_CLASS_NAV, GPS_UBX_NAV_ID_RELPOSNED, 64},
+    {GPS_UBX_CLASS_RXM, GPS_UBX_RXM_ID_RTCM, 8},
+    {GPS_UBX_CLASS_ACK, GPS_UBX_ACK_ID_NAK, 2},
+    {GPS_UBX_CLASS_ACK, GPS_UBX_ACK_ID_ACK, 2},
+};
+
+/**
+ * @brief UBX 메시지 최대 페이로드 길이
+ *
+ * @param[in] class
+ * @param[in] id
+ * @return uint16_t
+ */
+static uint16_t ubx_max_len(uint8_t class, uint8_t id)
+{
+  for (size_t i = 0; i < sizeof(ubx_len_table) / sizeof(ubx_len_table[0]); i++)
+  {
+    if (ubx_len_table[i].class == class && ubx_len_table[i].id == id)
+    {
+      return ubx_len_table[i].max_len;
+    }
+  }
+
+  return GPS_FRAME_MAX_SIZE - UBX_HEADER_SIZE - 2;
+}
+
+#if defined(USE_GPS_UBX_RXM_RTCM)
+/**
+ * @brief RXM-RTCM 메시지 종류별 사용 여부 누적
+ *
+ * @note 종류가 GPS_UBX_RTCM_STAT_MAX 를 넘으면 새 종류는 기록하지 않는다.
  *
  * @param[inout] gps
  */
-static void store_ubx_nav_data(gps_t *gps)
+static void update_rtcm_stat(gps_t *gps)
 {
-  char *data = &gps->payload[4];
-  switch (gps->ubx.id)
+  const gps_ubx_rxm_rtcm_t *rtcm = &gps->ubx_data.rtcm;
+  gps_ubx_rtcm_stat_t *stat = NULL;
+
+  for (uint8_t i = 0; i < gps->ubx_data.rtcm_stat_cnt; i++)
   {
-  case GPS_UBX_NAV_ID_HPPOSLLH:
-    memcpy(&gps->ubx_data.hpposllh, data, sizeof(gps_ubx_nav_hpposllh_t));
-    break;
+    if (gps->ubx_data.rtcm_stat[i].msg_type == rtcm->msg_type)
+    {
+      stat = &gps->ubx_data.rtcm_stat[i];
+      break;
+    }
+  }
 
-  case GPS_UBX_NAV_ID_RELPOSNED:
-    memcpy(&gps->ubx_data.relposned, data, sizeof(gps_ubx_nav_relposned_t));
-    break;
+  if (!stat)
+  {
+    if (gps->ubx_data.rtcm_stat_cnt >= GPS_UBX_RTCM_STAT_MAX)
+    {
+      return;
+    }
+    stat = &gps->ubx_data.rtcm_stat[gps->ubx_data.rtcm_stat_cnt++];
+    memset(stat, 0, sizeof(*stat));
+    stat->msg_type = rtcm->msg_type;
+  }
 
-  default:
-    break;
+  stat->ref_station = rtcm->ref_station;
+
+  if (rtcm->flags & 0x01)
+  {
+    stat->crc_failed++;
+  }
+  else if (((rtcm->flags >> 1) & 0x03) == 2)
+  {
+    stat->used++;
+  }
+  else
+  {
+    stat->not_used++;
   }
 }
+#endif
 
+#if defined(USE_GPS_UBX_NAV_PVT)
 /**
- * @brief 파싱한 ubx 프로토콜 데이터 저장
+ * @brief NAV-PVT 를 GGA quality 와 같은 fix 상태로 변환
  *
- * @param[inout] gps
+ * @param[in] pvt
+ * @return gps_fix_t
  */
-static void store_ubx_data(gps_t *gps)
+gps_fix_t gps_ubx_pvt_fix(const gps_ubx_nav_pvt_t *pvt)
 {
-  switch (gps->ubx.class)
+  if (!(pvt->flags & GPS_UBX_PVT_FLAGS_GNSS_FIX_OK))
   {
-  case GPS_UBX_CLASS_NAV:
-    store_ubx_nav_data(gps);
-    break;
+    return GPS_FIX_INVALID;
+  }
 
-  case GPS_UBX_CLASS_ACK:
-    store_ubx_ack_data(gps);
+  switch (pvt->fix_type)
+  {
+  case 1:
+    return GPS_FIX_DR;
+
+  case 2:
+  case 3:
+  case 4:
     break;
 
+  default:
+    return GPS_FIX_INVALID;
+  }
+
+  switch (GPS_UBX_PVT_FLAGS_CARR_SOLN(pvt->flags))
+  {
+  case 2:
+    return GPS_FIX_RTK_FIX;
+
+  case 1:
+    return GPS_FIX_RTK_FLOAT;
+
   default:
     break;
   }
+
+  return (pvt->flags & GPS_UBX_PVT_FLAGS_DIFF_SOLN) ? GPS_FIX_DGPS
+                                                     : GPS_FIX_GPS;
 }
+#endif
 
 /**
- * @brief ubx 프로토콜 파싱
+ * @brief 등록된 UBX 메시지 길이 확인 후 저장
  *
  * @param[inout] gps
- * @return uint8_t 1: success 0: checksum mismatch
+ * @param[in] desc
+ * @return true: success false: 길이 불일치
  */
-uint8_t gps_parse_ubx(gps_t *gps)
+static bool store_ubx_msg(gps_t *gps, const ubx_msg_desc_t *desc)
 {
-  if (gps->pos == 1)
+  uint8_t *dst = (uint8_t *)&gps->ubx_data + desc->dst_off;
+  uint16_t len = gps->ubx.len;
+  uint16_t copy = len;
+
+  if (desc->block == 0)
+  {
+    if (len != desc->len)
+    {
+      return false;
+    }
+  }
+  else
+  {
+    if (len < desc->len || (len - desc->len) % desc->block != 0 ||
+        gps_frame_byte(&gps->frame, UBX_HEADER_SIZE + desc->cnt_off) !=
+            (len - desc->len) / desc->block)
+    {
+      return false;
+    }
+
+    if (copy > desc->dst_size)
+    {
+      copy = desc->len +
+             (desc->dst_size - desc->len) / desc->block * desc->block;
+    }
+  }
+
+  gps_frame_read(&gps->frame, UBX_HEADER_SIZE, dst, copy);
+
+  if (desc->block != 0)
   {
-    gps->ubx.class = gps->payload[0];
-    gps->state = GPS_PARSE_STATE_UBX_MSG_CLASS;
+    dst[desc->cnt_off] = (uint8_t)((copy - desc->len) / desc->block);
   }
-  else if (gps->pos == 2)
+
+  if (desc->post)
   {
-    gps->ubx.id = gps->payload[1];
-    gps->state = GPS_PARSE_STATE_UBX_MSG_ID;
+    desc->post(gps);
   }
-  else if (gps->pos == 4)
+
+  return true;
+}
+
+/**
+ * @brief 파싱한 ubx 프로토콜 데이터 저장
+ *
+ * @param[inout] gps
+ * @return true: 저장 또는 처리하지 않는 메시지 false: 길이 불일치
+ */
+static bool store_ubx_data(gps_t *gps)
+{
+  if (gps->ubx.class == GPS_UBX_CLASS_ACK)
   {
-    gps->ubx.len = (gps->payload[2] | ((gps->payload[3] << 8)));
-    gps->state = GPS_PARSE_STATE_UBX_LEN;
+    store_ubx_ack_data(gps);
+    return true;
   }
-  else
+
+  for (size_t i = 0; i < UBX_MSG_TABLE_CNT; i++)
+  {
+    const ubx_msg_desc_t *desc = &ubx_msg_table[i];
+
+    if (desc->class != gps->ubx.class || desc->id != gps->ubx.id)
+    {
+      continue;
+    }
+
+    if (!store_ubx_msg(gps, desc))
+    {
+      gps->ubx_data.len_err++;
+      return false;
+    }
+
+    return true;
+  }
+
+  return true;
+}
+
+/**
+ * @brief ubx 프로토콜 파싱
+ *
+ * class, id, length 4바이트는 바이트 단위로 처리하고, 길이를 알고 나면
+ * 나머지 페이로드와 체크섬은 수신 버퍼 구간으로만 기록하면서 체크섬을 누적한다.
+ *
+ * @param[inout] gps
+ * @param[in] data sync(0xB5 0x62) 이후 수신 데이터
+ * @param[in] len 데이터 길이
+ * @return size_t 처리한 바이트 수
+ */
+size_t gps_parse_ubx(gps_t *gps, const uint8_t *data, size_t len)
+{
+  size_t used = 0;
+
+  while (gps->pos < UBX_HEADER_SIZE && used < len)
   {
-    if (gps->pos <= 4 + gps->ubx.len)
+    uint8_t ch = data[used];
+
+    if (!_gps_frame_add(gps, &data[used++], 1))
+    {
+      _gps_frame_drop(gps, &gps->stats.overflow);
+      return used;
+    }
+    calc_ubx_chksum(gps, &ch, 1);
+
+    if (gps->pos == 3)
     {
-      gps->state = GPS_PARSE_STATE_UBX_PAYLOAD;
+      gps->ubx.class = ch;
+      gps->state = GPS_PARSE_STATE_UBX_MSG_CLASS;
     }
-    else if (gps->pos == 5 + gps->ubx.len)
+    else if (gps->pos == 4)
     {
-      gps->state = GPS_PARSE_STATE_UBX_CHKSUM_A;
-      gps->ubx.chksum_a = gps->payload[4 + gps->ubx.len];
+      gps->ubx.id = ch;
+      gps->state = GPS_PARSE_STATE_UBX_MSG_ID;
     }
-    else if (gps->pos == 6 + gps->ubx.len)
+    else if (gps->pos == 5)
     {
-      gps->state = GPS_PARSE_STATE_UBX_CHKSUM_B;
-      gps->ubx.chksum_b = gps->payload[5 + gps->ubx.len];
+      gps->ubx.len = ch;
+    }
+    else if (gps->pos == UBX_HEADER_SIZE)
+    {
+      gps->ubx.len |= (uint16_t)ch << 8;
+      gps->state = GPS_PARSE_STATE_UBX_LEN;
 
-      if (check_ubx_chksum(gps))
+      if (gps->ubx.len > ubx_max_len(gps->ubx.class, gps->ubx.id))
       {
-        store_ubx_data(gps);
-        gps_msg_t msg;
-        msg.ubx.class = gps->ubx.class;
-        msg.ubx.id = gps->ubx.id;
-        gps->handler(gps, GPS_EVENT_NONE, GPS_PROTOCOL_UBX, msg);
-        gps->protocol = GPS_PROTOCOL_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
-
-        return 1;
-      }
-      else
-      {
-        gps->protocol = GPS_PROTOCOL_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
-        return 0;
+        _gps_frame_drop(gps, &gps->stats.len_reject);
+        return used;
       }
     }
   }
 
-  return 1;
+  if (gps->pos < UBX_HEADER_SIZE)
+  {
+    return used;
+  }
+
+  uint32_t chk_pos = gps->ubx.len + UBX_HEADER_SIZE;
+  uint32_t frame_len = chk_pos + 2;
+  size_t n = frame_len - gps->pos;
+
+  if (n > len - used)
+  {
+    n = len - used;
+  }
+
+  if (gps->pos < chk_pos)
+  {
+    size_t sum_len = (gps->pos + n < chk_pos) ? n : chk_pos - gps->pos;
+    calc_ubx_chksum(gps, &data[used], sum_len);
+  }
+
+  if (!_gps_frame_add(gps, &data[used], n))
+  {
+    _gps_frame_drop(gps, &gps->stats.overflow);
+    return used + n;
+  }
+  used += n;
+
+  if (gps->pos < chk_pos)
+  {
+    gps->state = GPS_PARSE_STATE_UBX_PAYLOAD;
+    return used;
+  }
+
+  if (gps->pos < frame_len)
+  {
+    gps->state = GPS_PARSE_STATE_UBX_CHKSUM_A;
+    return used;
+  }
+
+  gps->state = GPS_PARSE_STATE_UBX_CHKSUM_B;
+  gps->ubx.chksum_a = gps_frame_byte(&gps->frame, chk_pos);
+  gps->ubx.chksum_b = gps_frame_byte(&gps->frame, chk_pos + 1);
+
+  if (!check_ubx_chksum(gps))
+  {
+    _gps_frame_drop(gps, &gps->stats.chksum_err[GPS_PROTOCOL_UBX]);
+    return used;
+  }
+
+  /* 길이가 맞지 않는 메시지는 이전 값을 덮어쓰지 않고 이벤트도 보내지 않음 */
+  if (store_ubx_data(gps))
+  {
+    gps_msg_t msg;
+    msg.ubx.class = gps->ubx.class;
+    msg.ubx.id = gps->ubx.id;
+    _gps_emit(gps, GPS_PROTOCOL_UBX, msg);
+  }
+
+  gps->protocol = GPS_PROTOCOL_NONE;
+  gps->state = GPS_PARSE_STATE_NONE;
+
+  return used;
 }
 
 /**
@@ -717,9 +1032,9 @@ static void store_ubx_ack_data(gps_t *gps)
   if (gps->ubx.len == 2)
   {
 
-    uint8_t acked_cls = gps->payload[4]; // Payload 시작
+    uint8_t acked_cls = gps_frame_byte(&gps->frame, UBX_HEADER_SIZE); // Payload 시작
 
-    uint8_t acked_id = gps->payload[5];
+    uint8_t acked_id = gps_frame_byte(&gps->frame, UBX_HEADER_SIZE + 1);
 
     bool is_ack = (gps->ubx.id == GPS_UBX_ACK_ID_ACK);
 
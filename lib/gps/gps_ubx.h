@@ -1,6 +1,7 @@
 #ifndef GPS_UBX_H
 #define GPS_UBX_H
 
+#include "gps_nmea.h"
 #include "gps_types.h"
 #include <stdio.h>
 #include <stdint.h>
@@ -13,6 +14,7 @@
 typedef enum {
   GPS_UBX_CLASS_NONE = 0,
   GPS_UBX_CLASS_NAV = 0x01,
+  GPS_UBX_CLASS_RXM = 0x02,
   GPS_UBX_CLASS_ACK = 0x05,
   GPS_UBX_CLASS_CFG = 0x06,
 } gps_ubx_class_t;
@@ -23,10 +25,22 @@ typedef enum {
  */
 typedef enum {
   GPS_UBX_NAV_ID_NONE = 0,
+  GPS_UBX_NAV_ID_PVT = 0x07,      ///< Navigation Position Velocity Time Solution
   GPS_UBX_NAV_ID_HPPOSLLH = 0x14, ///< High Precision Position Solution
+  GPS_UBX_NAV_ID_SAT = 0x35,      ///< Satellite Information
+  GPS_UBX_NAV_ID_SVIN = 0x3B,     ///< Survey-in data
   GPS_UBX_NAV_ID_RELPOSNED = 0x3C, ///< Relative Positioning Information in NED frame
+  GPS_UBX_NAV_ID_SIG = 0x43,      ///< Signal Information
 } gps_ubx_nav_id_t;
 
+/**
+ * @brief ubx 프로토콜 RXM 클래스 메시지 id
+ *
+ */
+typedef enum {
+  GPS_UBX_RXM_ID_RTCM = 0x32, ///< RTCM input status
+} gps_ubx_rxm_id_t;
+
 /**
  * @brief ubx 프로토콜 CFG 클래스 메시지 id
  * 
@@ -104,6 +118,147 @@ typedef struct {
   }flags;
 } gps_ubx_nav_relposned_t;
 
+/**
+ * @brief ubx 프로토콜 NAV 클래스 PVT 메시지 (92 byte)
+ *
+ */
+typedef struct {
+  uint32_t tow;     // time of week [ms]
+  uint16_t year;    // UTC
+  uint8_t month;
+  uint8_t day;
+  uint8_t hour;
+  uint8_t min;
+  uint8_t sec;
+  uint8_t valid;    // bit0: validDate, bit1: validTime, bit2: fullyResolved
+  uint32_t t_acc;   // [ns]
+  int32_t nano;     // [ns]
+  uint8_t fix_type; // 0: no fix, 1: DR, 2: 2D, 3: 3D, 4: GNSS+DR, 5: time only
+  uint8_t flags;    // bit0: gnssFixOK, bit1: diffSoln, bit6..7: carrSoln
+  uint8_t flags2;
+  uint8_t num_sv;
+  int32_t lon;      // [1e-7 deg]
+  int32_t lat;      // [1e-7 deg]
+  int32_t height;   // [mm]
+  int32_t msl;      // [mm]
+  uint32_t h_acc;   // [mm]
+  uint32_t v_acc;   // [mm]
+  int32_t vel_n;    // [mm/s]
+  int32_t vel_e;    // [mm/s]
+  int32_t vel_d;    // [mm/s]
+  int32_t g_speed;  // ground speed [mm/s]
+  int32_t head_mot; // heading of motion [1e-5 deg]
+  uint32_t s_acc;   // [mm/s]
+  uint32_t head_acc; // [1e-5 deg]
+  uint16_t pdop;    // [0.01]
+  uint16_t flags3;
+  uint8_t reserved[4];
+  int32_t head_veh; // [1e-5 deg]
+  int16_t mag_dec;  // [1e-2 deg]
+  uint16_t mag_acc; // [1e-2 deg]
+} gps_ubx_nav_pvt_t;
+
+#define GPS_UBX_PVT_FLAGS_GNSS_FIX_OK 0x01
+#define GPS_UBX_PVT_FLAGS_DIFF_SOLN 0x02
+#define GPS_UBX_PVT_FLAGS_CARR_SOLN(x) (((x) >> 6) & 0x03) // 1: float, 2: fixed
+
+#define GPS_UBX_NAV_SAT_MAX 64 ///< 저장하는 최대 위성 수 (나머지는 버림)
+
+/**
+ * @brief ubx 프로토콜 NAV 클래스 SAT 메시지 (8 + 12 * num_svs byte)
+ *
+ */
+typedef struct {
+  uint32_t tow;
+  uint8_t version;
+  uint8_t num_svs;  // 저장한 위성 수 (GPS_UBX_NAV_SAT_MAX 이하로 자름)
+  uint8_t reserved[2];
+  struct {
+    uint8_t gnss_id;
+    uint8_t sv_id;
+    uint8_t cno;    // [dBHz]
+    int8_t elev;    // [deg]
+    int16_t azim;   // [deg]
+    int16_t pr_res; // [0.1 m]
+    uint32_t flags; // bit0..2: qualityInd, bit3: svUsed
+  } sv[GPS_UBX_NAV_SAT_MAX];
+} gps_ubx_nav_sat_t;
+
+#define GPS_UBX_NAV_SIG_MAX 63 ///< GPS_FRAME_MAX_SIZE 에 들어가는 최대 신호 수
+
+/**
+ * @brief ubx 프로토콜 NAV 클래스 SIG 메시지 (8 + 16 * num_sigs byte)
+ *
+ */
+typedef struct {
+  uint32_t tow;
+  uint8_t version;
+  uint8_t num_sigs; // 저장한 신호 수
+  uint8_t reserved[2];
+  struct {
+    uint8_t gnss_id;
+    uint8_t sv_id;
+    uint8_t sig_id;
+    uint8_t freq_id;
+    int16_t pr_res;     // [0.1 m]
+    uint8_t cno;        // [dBHz]
+    uint8_t quality_ind;
+    uint8_t corr_source;
+    uint8_t iono_model;
+    uint16_t sig_flags; // bit0..1: health, bit3: prUsed, bit4: crUsed, bit5: doUsed
+    uint8_t reserved[4];
+  } sig[GPS_UBX_NAV_SIG_MAX];
+} gps_ubx_nav_sig_t;
+
+/**
+ * @brief ubx 프로토콜 NAV 클래스 SVIN 메시지 (40 byte)
+ *
+ */
+typedef struct {
+  uint8_t version;
+  uint8_t reserved0[3];
+  uint32_t tow;
+  uint32_t dur;      // survey-in 경과 시간 [s]
+  int32_t mean_x;    // ECEF [cm]
+  int32_t mean_y;
+  int32_t mean_z;
+  int8_t mean_x_hp;  // [0.1 mm]
+  int8_t mean_y_hp;
+  int8_t mean_z_hp;
+  uint8_t reserved1;
+  uint32_t mean_acc; // [0.1 mm]
+  uint32_t obs;      // 사용한 관측 수
+  uint8_t valid;     // 1: survey-in 완료
+  uint8_t active;    // 1: 진행 중
+  uint8_t reserved2[2];
+} gps_ubx_nav_svin_t;
+
+/**
+ * @brief ubx 프로토콜 RXM 클래스 RTCM 메시지 (8 byte)
+ *
+ */
+typedef struct {
+  uint8_t version;
+  uint8_t flags;       // bit0: crcFailed, bit1..2: msgUsed (2: used, 1: not used, 0: unknown)
+  uint16_t sub_type;
+  uint16_t ref_station;
+  uint16_t msg_type;
+} gps_ubx_rxm_rtcm_t;
+
+#define GPS_UBX_RTCM_STAT_MAX 16 ///< 기록하는 RTCM 메시지 종류 수
+
+/**
+ * @brief RXM-RTCM 메시지 종류별 누적 상태
+ *
+ */
+typedef struct {
+  uint16_t msg_type;
+  uint16_t ref_station;
+  uint32_t used;       // 보정에 사용된 횟수
+  uint32_t not_used;
+  uint32_t crc_failed;
+} gps_ubx_rtcm_stat_t;
+
 /**
  * @brief UBX 파싱에 필요한 변수
  *
@@ -126,6 +281,24 @@ typedef struct {
 typedef struct {
   gps_ubx_nav_hpposllh_t hpposllh;
   gps_ubx_nav_relposned_t relposned;
+#if defined(USE_GPS_UBX_NAV_PVT)
+  gps_ubx_nav_pvt_t pvt;
+#endif
+#if defined(USE_GPS_UBX_NAV_SAT)
+  gps_ubx_nav_sat_t sat;
+#endif
+#if defined(USE_GPS_UBX_NAV_SIG)
+  gps_ubx_nav_sig_t sig;
+#endif
+#if defined(USE_GPS_UBX_NAV_SVIN)
+  gps_ubx_nav_svin_t svin;
+#endif
+#if defined(USE_GPS_UBX_RXM_RTCM)
+  gps_ubx_rxm_rtcm_t rtcm;
+  gps_ubx_rtcm_stat_t rtcm_stat[GPS_UBX_RTCM_STAT_MAX];
+  uint8_t rtcm_stat_cnt;
+#endif
+  uint32_t len_err; // 길이가 맞지 않아 버린 메시지 수
 } gps_ubx_data_t;
 
 typedef enum {
@@ -241,7 +414,11 @@ typedef struct {
 
 typedef struct gps_s gps_t;
 
-uint8_t gps_parse_ubx(gps_t *gps);
+size_t gps_parse_ubx(gps_t *gps, const uint8_t *data, size_t len);
+
+#if defined(USE_GPS_UBX_NAV_PVT)
+gps_fix_t gps_ubx_pvt_fix(const gps_ubx_nav_pvt_t *pvt);
+#endif
 
 /* Command functions */
 void ubx_cmd_handler_init(ubx_cmd_handler_t *handler);
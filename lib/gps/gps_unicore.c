@@ -1,6 +1,7 @@
 #include "gps_unicore.h"
 #include "gps.h"
-#include "gps_parse.h"
+#include "gps_coord.h"
+#include "gps_crc.h"
 #include <string.h>
 
 gps_unicore_resp_t gps_get_unicore_response(gps_t *gps) {
@@ -30,192 +31,333 @@ uint8_t gps_parse_unicore_term(gps_t *gps) {
 
 
 
-uint32_t calc_crc32(uint8_t *buf, uint16_t len);
+static inline uint8_t check_unicore_binary_chksum(gps_t *gps) {
+  if (gps->unicore_bin.crc_calc == gps->unicore_bin.crc32){
+    return 1;
+  }
+
+  return 0;
+}
+
+
+/**
+ * @brief UNICORE 바이너리 로그 저장 정보
+ *
+ * 페이로드는 dst_off 위치의 구조체에 그대로 복사한다.
+ * - 고정 길이: 길이가 len 과 같아야 함
+ * - 앞부분만 사용 (prefix): 길이가 len 이상이면 앞 len 바이트만 저장
+ * - 반복 블록: 첫 4바이트(U4)가 블록 수, 저장 공간을 넘는 블록은 버리면서
+ *   블록 수를 줄여 기록
+ */
+typedef struct {
+  uint16_t id;
+  uint16_t len;      ///< 고정 길이, 반복 블록이 있으면 블록 앞 헤더 길이
+  uint16_t block;    ///< 반복 블록 길이 (0: 블록 없음)
+  uint8_t prefix;    ///< 1: len 이상이면 허용 (뒤에 붙는 필드는 버림)
+  uint16_t dst_off;  ///< gps_unicore_bin_data_t 내 저장 위치
+  uint16_t dst_size; ///< 저장 공간 크기
+} unicore_bin_msg_desc_t;
+
+#define UNICORE_BIN_MSG_FIXED(msg_id, field)                                   \
+  {(msg_id), sizeof(((gps_unicore_bin_data_t *)0)->field), 0, 0,               \
+   offsetof(gps_unicore_bin_data_t, field),                                    \
+   sizeof(((gps_unicore_bin_data_t *)0)->field)}
 
-static inline uint32_t calc_unicore_binary_chksum(gps_t *gps) {
+#define UNICORE_BIN_MSG_PREFIX(msg_id, field)                                  \
+  {(msg_id), sizeof(((gps_unicore_bin_data_t *)0)->field), 0, 1,               \
+   offsetof(gps_unicore_bin_data_t, field),                                    \
+   sizeof(((gps_unicore_bin_data_t *)0)->field)}
+
+#define UNICORE_BIN_MSG_BLOCK(msg_id, field, hdr_len, blk_len)                 \
+  {(msg_id), (hdr_len), (blk_len), 0, offsetof(gps_unicore_bin_data_t, field), \
+   sizeof(((gps_unicore_bin_data_t *)0)->field)}
+
+_Static_assert(sizeof(gps_unicore_bin_header_t) == GPS_UNICORE_BIN_HEADER_SIZE,
+               "UNICORE binary header size");
+_Static_assert(sizeof(hpd_unicore_bestnavb_t) == 120, "BESTNAVB size");
+
+#if defined(USE_GPS_UNICORE_HEADING)
+_Static_assert(sizeof(hpd_unicore_headingb_t) == 44, "HEADINGB size");
+#endif
+#if defined(USE_GPS_UNICORE_PVTSLN)
+_Static_assert(sizeof(hpd_unicore_pvtslnb_t) == 142, "PVTSLNB size");
+#endif
+#if defined(USE_GPS_UNICORE_OBSVM)
+_Static_assert(offsetof(hpd_unicore_obsvmb_t, obs) == 4 &&
+                   sizeof(((hpd_unicore_obsvmb_t *)0)->obs[0]) == 40,
+               "OBSVMB layout");
+_Static_assert(GPS_UNICORE_BIN_HEADER_SIZE + 4 + 40 * GPS_UNICORE_OBSVM_MAX + 4 <=
+                   GPS_FRAME_MAX_SIZE,
+               "GPS_UNICORE_OBSVM_MAX exceeds frame");
+#endif
+#if defined(USE_GPS_UNICORE_BESTNAVXYZ)
+_Static_assert(sizeof(hpd_unicore_bestnavxyzb_t) == 112, "BESTNAVXYZB size");
+#endif
+
+static const unicore_bin_msg_desc_t unicore_bin_msg_table[] = {
+    UNICORE_BIN_MSG_PREFIX(GPS_UNICORE_BIN_MSG_BESTNAV, bestnav),
+#if defined(USE_GPS_UNICORE_HEADING)
+    UNICORE_BIN_MSG_FIXED(GPS_UNICORE_BIN_MSG_HEADING, heading),
+#endif
+#if defined(USE_GPS_UNICORE_PVTSLN)
+    UNICORE_BIN_MSG_PREFIX(GPS_UNICORE_BIN_MSG_PVTSLN, pvtsln),
+#endif
+#if defined(USE_GPS_UNICORE_OBSVM)
+    UNICORE_BIN_MSG_BLOCK(GPS_UNICORE_BIN_MSG_OBSVM, obsvm, 4, 40),
+#endif
+#if defined(USE_GPS_UNICORE_BESTNAVXYZ)
+    UNICORE_BIN_MSG_FIXED(GPS_UNICORE_BIN_MSG_BESTNAVXYZ, bestnavxyz),
+#endif
+};
+
+#define UNICORE_BIN_MSG_TABLE_CNT                                              \
+  (sizeof(unicore_bin_msg_table) / sizeof(unicore_bin_msg_table[0]))
+
+/**
+ * @brief UNICORE 바이너리 로그별 최대 메시지 길이
+ *
+ * 헤더 길이가 이보다 크면 길이 필드가 깨진 것으로 보고 바로 재동기한다.
+ * 길이가 고정된 로그만 두고, 뒤에 필드가 붙을 수 있는 로그(BESTNAV, PVTSLN)와
+ * 반복 블록 로그, 표에 없는 로그는 GPS_FRAME_MAX_SIZE 까지 허용한다.
+ */
+static const struct {
+  uint16_t id;
+  uint16_t max_len;
+} unicore_bin_len_table[] = {
+    {GPS_UNICORE_BIN_MSG_HEADING, 44},
+    {GPS_UNICORE_BIN_MSG_BESTNAVXYZ, 112},
+};
 
-    uint16_t len = (gps->payload[6] | (gps->payload[7] << 8));
-    uint32_t crc32 = calc_crc32((uint8_t*)gps->payload, len + GPS_UNICORE_BIN_HEADER_SIZE);
+/**
+ * @brief UNICORE 바이너리 로그 최대 메시지 길이
+ *
+ * @param[in] id
+ * @return uint16_t
+ */
+static uint16_t unicore_bin_max_len(uint16_t id) {
+  for (size_t i = 0;
+       i < sizeof(unicore_bin_len_table) / sizeof(unicore_bin_len_table[0]);
+       i++) {
+    if (unicore_bin_len_table[i].id == id) {
+      return unicore_bin_len_table[i].max_len;
+    }
+  }
 
-    return crc32;
+  return GPS_FRAME_MAX_SIZE - GPS_UNICORE_BIN_HEADER_SIZE - 4;
 }
 
+/**
+ * @brief 등록된 로그 길이 확인 후 저장
+ *
+ * @param[inout] gps
+ * @param[in] desc
+ * @return true: success false: 길이 불일치
+ */
+static bool store_unicore_bin_msg(gps_t *gps, const unicore_bin_msg_desc_t *desc) {
+  uint8_t *dst = (uint8_t *)&gps->unicore_bin_data + desc->dst_off;
+  uint16_t len = gps->unicore_bin.header.message_len;
+  uint16_t copy = len;
 
-static inline uint8_t check_unicore_binary_chksum(gps_t *gps) {
-  uint32_t crc32 = calc_unicore_binary_chksum(gps);
+  if (desc->block == 0) {
+    if (len < desc->len || (!desc->prefix && len != desc->len)) {
+      return false;
+    }
+    copy = desc->len;
+  } else {
+    uint32_t cnt;
 
-  if (crc32 == gps->unicore_bin.crc32){
-    return 1;
+    gps_frame_read(&gps->frame, GPS_UNICORE_BIN_HEADER_SIZE, &cnt, sizeof(cnt));
+    if (len < desc->len || (len - desc->len) % desc->block != 0 ||
+        cnt != (uint32_t)(len - desc->len) / desc->block) {
+      return false;
+    }
+
+    if (copy > desc->dst_size) {
+      copy = desc->len + (desc->dst_size - desc->len) / desc->block * desc->block;
+    }
   }
 
-  return 0;
+  gps_frame_read(&gps->frame, GPS_UNICORE_BIN_HEADER_SIZE, dst, copy);
+
+  if (desc->block != 0) {
+    uint32_t cnt = (uint32_t)(copy - desc->len) / desc->block;
+
+    memcpy(dst, &cnt, sizeof(cnt));
+  }
+
+  return true;
 }
 
+/**
+ * @brief 파싱한 UNICORE 바이너리 로그 저장
+ *
+ * @param[inout] gps
+ * @return true: 저장 또는 처리하지 않는 로그 false: 길이 불일치
+ */
+static bool store_unicore_bin_data(gps_t *gps) {
+  for (size_t i = 0; i < UNICORE_BIN_MSG_TABLE_CNT; i++) {
+    const unicore_bin_msg_desc_t *desc = &unicore_bin_msg_table[i];
+
+    if (desc->id != gps->unicore_bin.header.message_id) {
+      continue;
+    }
+
+    if (!store_unicore_bin_msg(gps, desc)) {
+      gps->unicore_bin_data.len_err++;
+      return false;
+    }
 
-static void store_unicore_bin_bestnavb_data(gps_t *gps) {
-    memcpy(&gps->unicore_bin_data.bestnav , &gps->payload[GPS_UNICORE_BIN_HEADER_SIZE],
-           sizeof(hpd_unicore_bestnavb_t));
+    return true;
+  }
+
+  return true;
 }
 
+/**
+ * @brief BESTNAV/PVTSLN 솔루션 타입을 GGA quality 와 같은 fix 상태로 변환
+ *
+ * @param[in] sol_status
+ * @param[in] pos_type
+ * @return gps_fix_t
+ */
+gps_fix_t gps_unicore_pos_fix(uint32_t sol_status, uint32_t pos_type) {
+  if (sol_status != GPS_UNICORE_SOL_COMPUTED) {
+    return GPS_FIX_INVALID;
+  }
+
+  switch (pos_type) {
+  case GPS_UNICORE_POS_FIXEDPOS:
+    return GPS_FIX_MANUAL_POS;
+
+  case GPS_UNICORE_POS_SINGLE:
+    return GPS_FIX_GPS;
 
-static void store_unicore_bin_data(gps_t *gps) {
-  switch (gps->unicore_bin.header.message_id) {
-  case GPS_UNICORE_BIN_MSG_BESTNAV:
-    store_unicore_bin_bestnavb_data(gps);
-    break;
+  case GPS_UNICORE_POS_PSRDIFF:
+    return GPS_FIX_DGPS;
+
+  case GPS_UNICORE_POS_L1_FLOAT:
+  case GPS_UNICORE_POS_NARROW_FLOAT:
+    return GPS_FIX_RTK_FLOAT;
+
+  case GPS_UNICORE_POS_L1_INT:
+  case GPS_UNICORE_POS_WIDE_INT:
+  case GPS_UNICORE_POS_NARROW_INT:
+    return GPS_FIX_RTK_FIX;
 
   default:
-    break;
+    return GPS_FIX_INVALID;
   }
 }
 
-uint8_t gps_parse_unicore_bin(gps_t *gps) {
-  if (gps->pos == 6) {
-    gps->unicore_bin.header.message_id = (uint16_t)gps->payload[4] | ((uint16_t)gps->payload[5] << 8);
-    gps->state = GPS_PARSE_STATE_UNICORE_MESSAGE_ID;
-  } else if (gps->pos == 8) {
-    gps->unicore_bin.header.message_len = (uint16_t)gps->payload[6] | ((uint16_t)gps->payload[7] << 8);
-    gps->state = GPS_PARSE_STATE_UNICORE_MESSAGE_LEN;
-  } 
-   else {
-    uint16_t message_len = gps->unicore_bin.header.message_len;
-
-    if (gps->pos <= message_len + GPS_UNICORE_BIN_HEADER_SIZE) {
-      gps->state = GPS_PARSE_STATE_UNICORE_PAYLOAD;
-    } 
-     else if (gps->pos == message_len + GPS_UNICORE_BIN_HEADER_SIZE + 4) {
-      gps->state = GPS_PARSE_STATE_UNICORE_CRC;
-      memcpy(&gps->unicore_bin.crc32, &gps->payload[message_len + GPS_UNICORE_BIN_HEADER_SIZE], 4);
-
-      if (check_unicore_binary_chksum(gps)) {
-        store_unicore_bin_data(gps);
-
-        memcpy(&gps->unicore_bin.header, gps->payload, GPS_UNICORE_BIN_HEADER_SIZE);
-        
-        gps_msg_t msg;
-        msg.unicore_bin.msg = gps->unicore_bin.header.message_id;
-        gps->handler(gps, GPS_EVENT_DATA_PARSED, GPS_PROTOCOL_UNICORE_BIN, msg);
-        gps->protocol = GPS_PROTOCOL_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
-
-        /* clear payload and reset position */
-        memset(gps->payload, 0, sizeof(gps->payload));
-        gps->pos = 0;
-
-        return 1;
-      } else {
-        gps->protocol = GPS_PROTOCOL_NONE;
-        gps->state = GPS_PARSE_STATE_NONE;
-
-        /* clear payload and reset position on failure as well */
-        memset(gps->payload, 0, sizeof(gps->payload));
-        gps->pos = 0;
-        return 0;
-      }
-    }
+#if defined(USE_GPS_UNICORE_HEADING)
+/**
+ * @brief HEADINGB 방위 (GPTHS 와 같은 1e-5 deg 단위)
+ *
+ * @param[in] data
+ * @param[out] heading [1e-5 deg], 유효하지 않으면 변경하지 않음
+ * @return true: 방위 해 있음 false: 해 없음
+ */
+bool gps_unicore_heading(const gps_unicore_bin_data_t *data, int32_t *heading) {
+  if (data->heading.sol_status != GPS_UNICORE_SOL_COMPUTED ||
+      data->heading.pos_type == GPS_UNICORE_POS_NONE) {
+    return false;
   }
 
-  return 1;
+  *heading = (int32_t)gps_coord_fixed_from_double(data->heading.heading, 5);
+  return true;
 }
+#endif
 
+/**
+ * @brief UNICORE 바이너리 프로토콜 파싱
+ *
+ * 헤더의 message length(offset 6)를 받을 때까지는 바이트 단위로 처리하고,
+ * 이후 나머지 헤더/페이로드/CRC는 수신 버퍼 구간으로만 기록한다.
+ * CRC32는 수신하면서 누적하므로 프레임 끝에서는 비교만 한다.
+ *
+ * @param[inout] gps
+ * @param[in] data sync(0xAA 0x44 0xB5) 이후 수신 데이터
+ * @param[in] len 데이터 길이
+ * @return size_t 처리한 바이트 수
+ */
+size_t gps_parse_unicore_bin(gps_t *gps, const uint8_t *data, size_t len) {
+  size_t used = 0;
 
-const static uint32_t crc_table[256] =
-{
-0x00000000UL, 0x77073096UL, 0xee0e612cUL, 0x990951baUL, 0x076dc419UL,
-0x706af48fUL,
-0xe963a535UL, 0x9e6495a3UL, 0x0edb8832UL, 0x79dcb8a4UL, 0xe0d5e91eUL,
-0x97d2d988UL,
-0x09b64c2bUL, 0x7eb17cbdUL, 0xe7b82d07UL, 0x90bf1d91UL, 0x1db71064UL,
-0x6ab020f2UL,
-0xf3b97148UL, 0x84be41deUL, 0x1adad47dUL, 0x6ddde4ebUL, 0xf4d4b551UL,
-0x83d385c7UL,
-0x136c9856UL, 0x646ba8c0UL, 0xfd62f97aUL, 0x8a65c9ecUL, 0x14015c4fUL,
-0x63066cd9UL,
-0xfa0f3d63UL, 0x8d080df5UL, 0x3b6e20c8UL, 0x4c69105eUL, 0xd56041e4UL,
-0xa2677172UL,
-0x3c03e4d1UL, 0x4b04d447UL, 0xd20d85fdUL, 0xa50ab56bUL, 0x35b5a8faUL,
-0x42b2986cUL,
-0xdbbbc9d6UL, 0xacbcf940UL, 0x32d86ce3UL, 0x45df5c75UL, 0xdcd60dcfUL,
-0xabd13d59UL,
-0x26d930acUL, 0x51de003aUL, 0xc8d75180UL, 0xbfd06116UL, 0x21b4f4b5UL,
-0x56b3c423UL,
-0xcfba9599UL, 0xb8bda50fUL, 0x2802b89eUL, 0x5f058808UL, 0xc60cd9b2UL,
-0xb10be924UL,
-0x2f6f7c87UL, 0x58684c11UL, 0xc1611dabUL, 0xb6662d3dUL, 0x76dc4190UL,
-0x01db7106UL,
-0x98d220bcUL, 0xefd5102aUL, 0x71b18589UL, 0x06b6b51fUL, 0x9fbfe4a5UL,
-0xe8b8d433UL,
-0x7807c9a2UL, 0x0f00f934UL, 0x9609a88eUL, 0xe10e9818UL, 0x7f6a0dbbUL,
-0x086d3d2dUL,
-0x91646c97UL, 0xe6635c01UL, 0x6b6b51f4UL, 0x1c6c6162UL, 0x856530d8UL,
-0xf262004eUL,
-0x6c0695edUL, 0x1b01a57bUL, 0x8208f4c1UL, 0xf50fc457UL, 0x65b0d9c6UL,
-0x12b7e950UL,
-0x8bbeb8eaUL, 0xfcb9887cUL, 0x62dd1ddfUL, 0x15da2d49UL, 0x8cd37cf3UL,
-0xfbd44c65UL,
-0x4db26158UL, 0x3ab551ceUL, 0xa3bc0074UL, 0xd4bb30e2UL, 0x4adfa541UL,
-0x3dd895d7UL,
-0xa4d1c46dUL, 0xd3d6f4fbUL, 0x4369e96aUL, 0x346ed9fcUL, 0xad678846UL,
-0xda60b8d0UL,
-0x44042d73UL, 0x33031de5UL, 0xaa0a4c5fUL, 0xdd0d7cc9UL, 0x5005713cUL,
-0x270241aaUL,
-0xbe0b1010UL, 0xc90c2086UL, 0x5768b525UL, 0x206f85b3UL, 0xb966d409UL,
-0xce61e49fUL,
-0x5edef90eUL, 0x29d9c998UL, 0xb0d09822UL, 0xc7d7a8b4UL, 0x59b33d17UL,
-0x2eb40d81UL,
-0xb7bd5c3bUL, 0xc0ba6cadUL, 0xedb88320UL, 0x9abfb3b6UL, 0x03b6e20cUL,
-0x74b1d29aUL,
-0xead54739UL, 0x9dd277afUL, 0x04db2615UL, 0x73dc1683UL, 0xe3630b12UL,
-0x94643b84UL,
-0x0d6d6a3eUL, 0x7a6a5aa8UL, 0xe40ecf0bUL, 0x9309ff9dUL, 0x0a00ae27UL,
-0x7d079eb1UL,
-0xf00f9344UL, 0x8708a3d2UL, 0x1e01f268UL, 0x6906c2feUL, 0xf762575dUL,
-0x806567cbUL,
-0x196c3671UL, 0x6e6b06e7UL, 0xfed41b76UL, 0x89d32be0UL, 0x10da7a5aUL,
-0x67dd4accUL,
-0xf9b9df6fUL, 0x8ebeeff9UL, 0x17b7be43UL, 0x60b08ed5UL, 0xd6d6a3e8UL,
-0xa1d1937eUL,
-0x38d8c2c4UL, 0x4fdff252UL, 0xd1bb67f1UL, 0xa6bc5767UL, 0x3fb506ddUL,
-0x48b2364bUL,
-0xd80d2bdaUL, 0xaf0a1b4cUL, 0x36034af6UL, 0x41047a60UL, 0xdf60efc3UL,
-0xa867df55UL,
-0x316e8eefUL, 0x4669be79UL, 0xcb61b38cUL, 0xbc66831aUL, 0x256fd2a0UL,
-0x5268e236UL,
-0xcc0c7795UL, 0xbb0b4703UL, 0x220216b9UL, 0x5505262fUL, 0xc5ba3bbeUL,
-0xb2bd0b28UL,
-0x2bb45a92UL, 0x5cb36a04UL, 0xc2d7ffa7UL, 0xb5d0cf31UL, 0x2cd99e8bUL,
-0x5bdeae1dUL, 
-0x9b64c2b0UL, 0xec63f226UL, 0x756aa39cUL, 0x026d930aUL, 0x9c0906a9UL,
-0xeb0e363fUL,
-0x72076785UL, 0x05005713UL, 0x95bf4a82UL, 0xe2b87a14UL, 0x7bb12baeUL,
-0x0cb61b38UL,
-0x92d28e9bUL, 0xe5d5be0dUL, 0x7cdcefb7UL, 0x0bdbdf21UL, 0x86d3d2d4UL,
-0xf1d4e242UL,
-0x68ddb3f8UL, 0x1fda836eUL, 0x81be16cdUL, 0xf6b9265bUL, 0x6fb077e1UL,
-0x18b74777UL,
-0x88085ae6UL, 0xff0f6a70UL, 0x66063bcaUL, 0x11010b5cUL, 0x8f659effUL,
-0xf862ae69UL,
-0x616bffd3UL, 0x166ccf45UL, 0xa00ae278UL, 0xd70dd2eeUL, 0x4e048354UL,
-0x3903b3c2UL,
-0xa7672661UL, 0xd06016f7UL, 0x4969474dUL, 0x3e6e77dbUL, 0xaed16a4aUL,
-0xd9d65adcUL,
-0x40df0b66UL, 0x37d83bf0UL, 0xa9bcae53UL, 0xdebb9ec5UL, 0x47b2cf7fUL,
-0x30b5ffe9UL,
-0xbdbdf21cUL, 0xcabac28aUL, 0x53b39330UL, 0x24b4a3a6UL, 0xbad03605UL,
-0xcdd70693UL,
-0x54de5729UL, 0x23d967bfUL, 0xb3667a2eUL, 0xc4614ab8UL, 0x5d681b02UL,
-0x2a6f2b94UL,
-0xb40bbe37UL, 0xc30c8ea1UL, 0x5a05df1bUL, 0x2d02ef8dUL 
-};
+  while (gps->pos < 8 && used < len) {
+    uint8_t ch = data[used];
+
+    if (!_gps_frame_add(gps, &data[used++], 1)) {
+      _gps_frame_drop(gps, &gps->stats.overflow);
+      return used;
+    }
+    gps->unicore_bin.crc_calc = gps_crc32_update(gps->unicore_bin.crc_calc, &ch, 1);
 
-uint32_t calc_crc32(uint8_t *buf, uint16_t len)
-{
-    int idx;
-    uint32_t crc32 = 0;
+    if (gps->pos == 5) {
+      gps->unicore_bin.header.message_id = ch;
+    } else if (gps->pos == 6) {
+      gps->unicore_bin.header.message_id |= (uint16_t)ch << 8;
+      gps->state = GPS_PARSE_STATE_UNICORE_MESSAGE_ID;
+    } else if (gps->pos == 7) {
+      gps->unicore_bin.header.message_len = ch;
+    } else if (gps->pos == 8) {
+      gps->unicore_bin.header.message_len |= (uint16_t)ch << 8;
+      gps->state = GPS_PARSE_STATE_UNICORE_MESSAGE_LEN;
 
-    for (idx = 0; idx < len; idx++)
-    {
-        crc32 = crc_table[(crc32 ^ buf[idx]) & 0xff] ^ (crc32 >> 8);
+      if (gps->unicore_bin.header.message_len >
+          unicore_bin_max_len(gps->unicore_bin.header.message_id)) {
+        _gps_frame_drop(gps, &gps->stats.len_reject);
+        return used;
+      }
     }
-    return crc32;
+  }
+
+  if (gps->pos < 8) {
+    return used;
+  }
+
+  uint16_t message_len = gps->unicore_bin.header.message_len;
+  uint32_t crc_pos = message_len + GPS_UNICORE_BIN_HEADER_SIZE;
+  uint32_t frame_len = crc_pos + 4;
+  size_t n = frame_len - gps->pos;
+
+  if (n > len - used) {
+    n = len - used;
+  }
+
+  if (gps->pos < crc_pos) {
+    size_t crc_len = (gps->pos + n < crc_pos) ? n : crc_pos - gps->pos;
+    gps->unicore_bin.crc_calc = gps_crc32_update(gps->unicore_bin.crc_calc, &data[used], crc_len);
+  }
+
+  if (!_gps_frame_add(gps, &data[used], n)) {
+    _gps_frame_drop(gps, &gps->stats.overflow);
+    return used + n;
+  }
+  used += n;
+
+  if (gps->pos < frame_len) {
+    gps->state = GPS_PARSE_STATE_UNICORE_PAYLOAD;
+    return used;
+  }
+
+  gps->state = GPS_PARSE_STATE_UNICORE_CRC;
+  gps_frame_read(&gps->frame, crc_pos, &gps->unicore_bin.crc32, 4);
+
+  if (!check_unicore_binary_chksum(gps)) {
+    _gps_frame_drop(gps, &gps->stats.chksum_err[GPS_PROTOCOL_UNICORE_BIN]);
+    return used;
+  }
+
+  if (store_unicore_bin_data(gps)) {
+    gps_frame_read(&gps->frame, 0, &gps->unicore_bin.header, GPS_UNICORE_BIN_HEADER_SIZE);
+
+    gps_msg_t msg;
+    msg.unicore_bin.msg = gps->unicore_bin.header.message_id;
+    _gps_emit(gps, GPS_PROTOCOL_UNICORE_BIN, msg);
+  }
+
+  gps->protocol = GPS_PROTOCOL_NONE;
+  gps->state = GPS_PARSE_STATE_NONE;
+
+  return used;
 }
@@ -1,9 +1,11 @@
 #ifndef GPS_UNICORE_H
 #define GPS_UNICORE_H
 
+#include "gps_nmea.h"
 #include "gps_types.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #define GPS_UNICORE_TERM_SIZE 32
 #define GPS_UNICORE_BIN_HEADER_SIZE 24
@@ -36,9 +38,38 @@ typedef struct {
 } gps_unicore_parser_t;
 
 typedef enum {
+    GPS_UNICORE_BIN_MSG_OBSVM = 12,
+    GPS_UNICORE_BIN_MSG_BESTNAVXYZ = 240,
+    GPS_UNICORE_BIN_MSG_HEADING = 972,
+    GPS_UNICORE_BIN_MSG_PVTSLN = 1021,
     GPS_UNICORE_BIN_MSG_BESTNAV = 2118
 }gps_unicore_bin_msg_t;
 
+/**
+ * @brief 솔루션 상태 (sol_status)
+ */
+typedef enum {
+    GPS_UNICORE_SOL_COMPUTED = 0,
+    GPS_UNICORE_SOL_INSUFFICIENT_OBS = 1,
+    GPS_UNICORE_SOL_NO_CONVERGENCE = 2,
+    GPS_UNICORE_SOL_COV_TRACE = 4
+}gps_unicore_sol_status_t;
+
+/**
+ * @brief 위치/방위 타입 (pos_type)
+ */
+typedef enum {
+    GPS_UNICORE_POS_NONE = 0,
+    GPS_UNICORE_POS_FIXEDPOS = 1,
+    GPS_UNICORE_POS_SINGLE = 16,
+    GPS_UNICORE_POS_PSRDIFF = 17,
+    GPS_UNICORE_POS_L1_FLOAT = 32,
+    GPS_UNICORE_POS_NARROW_FLOAT = 34,
+    GPS_UNICORE_POS_L1_INT = 48,
+    GPS_UNICORE_POS_WIDE_INT = 49,
+    GPS_UNICORE_POS_NARROW_INT = 50
+}gps_unicore_pos_type_t;
+
 typedef struct __attribute__((packed)) {
     uint8_t sync[3]; ///< 0xAA 0x44 0xB5
     uint8_t cpu_idle; ///< CPU idle 0-100
@@ -56,7 +87,8 @@ typedef struct __attribute__((packed)) {
 
 typedef struct {
   gps_unicore_bin_header_t header;
-  uint32_t crc32;
+  uint32_t crc32;    ///< 수신한 CRC
+  uint32_t crc_calc; ///< 수신중 누적 CRC (sync 부터 payload 끝까지)
 } gps_unicore_bin_parser_t;
 
 typedef struct __attribute__((packed))
@@ -91,14 +123,159 @@ typedef struct __attribute__((packed))
     float horspd_std;
 }hpd_unicore_bestnavb_t;
 
+/**
+ * @brief HEADINGB (44 byte)
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t sol_status;
+    uint32_t pos_type;
+    float length;       ///< baseline [m]
+    float heading;      ///< [deg] 0 ~ 360
+    float pitch;        ///< [deg] -90 ~ 90
+    float reserved1;
+    float heading_dev;  ///< [deg]
+    float pitch_dev;    ///< [deg]
+    char base_station_id[4];
+    uint8_t sv;
+    uint8_t used_sv;
+    uint8_t obs;
+    uint8_t multi;
+    uint8_t reserved2;
+    uint8_t ext_sol_stat;
+    uint8_t galileo_bds3_sig_mask;
+    uint8_t gps_glonass_bds2_sig_mask;
+}hpd_unicore_headingb_t;
+
+/**
+ * @brief PVTSLNB 고정 부분 (142 byte)
+ *
+ * @note 뒤에 오는 PRN 목록(prn_no * 2 byte)은 저장하지 않는다.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t bestpos_type;
+    float bestpos_hgt;
+    double bestpos_lat;
+    double bestpos_lon;
+    float bestpos_hgt_dev;
+    float bestpos_lat_dev;
+    float bestpos_lon_dev;
+    float bestpos_diff_age;
+    uint32_t psrpos_type;
+    float psrpos_hgt;
+    double psrpos_lat;
+    double psrpos_lon;
+    float undulation;
+    uint8_t bestpos_sv;
+    uint8_t bestpos_used_sv;
+    uint8_t psrpos_sv;
+    uint8_t psrpos_used_sv;
+    double psrvel_north;
+    double psrvel_east;
+    double psrvel_ground;
+    uint32_t heading_type;
+    float heading_length;
+    float heading_degree;
+    float heading_pitch;
+    uint8_t heading_sv;
+    uint8_t heading_used_sv;
+    uint8_t heading_ggl1;
+    uint8_t heading_ggl1l2;
+    float gdop;
+    float pdop;
+    float hdop;
+    float htdop;
+    float tdop;
+    float cutoff;
+    uint16_t prn_no;
+}hpd_unicore_pvtslnb_t;
+
+#define GPS_UNICORE_OBSVM_MAX 24 ///< GPS_FRAME_MAX_SIZE 에 들어가는 최대 관측 수
+
+/**
+ * @brief OBSVMB (4 + 40 * obs_num byte)
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t obs_num; ///< 저장한 관측 수 (GPS_UNICORE_OBSVM_MAX 이하)
+    struct __attribute__((packed)) {
+        uint16_t system_freq;
+        uint16_t prn;
+        double psr;         ///< pseudorange [m]
+        double adr;         ///< carrier phase [cycle]
+        uint16_t psr_dev;   ///< [0.01 m]
+        uint16_t adr_dev;   ///< [0.0001 cycle]
+        float dopp;         ///< [Hz]
+        uint16_t cn0;       ///< [0.01 dB-Hz]
+        uint16_t reserved;
+        float lock_time;    ///< [s]
+        uint32_t ch_tr_status;
+    } obs[GPS_UNICORE_OBSVM_MAX];
+}hpd_unicore_obsvmb_t;
+
+/**
+ * @brief BESTNAVXYZB (112 byte)
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t psol_status;
+    uint32_t pos_type;
+    double x;           ///< ECEF [m]
+    double y;
+    double z;
+    float x_dev;
+    float y_dev;
+    float z_dev;
+    uint32_t v_sol_status;
+    uint32_t vel_type;
+    double vx;          ///< ECEF [m/s]
+    double vy;
+    double vz;
+    float vx_dev;
+    float vy_dev;
+    float vz_dev;
+    char base_station_id[4];
+    float v_latency;
+    float diff_age;
+    float sol_age;
+    uint8_t sv;
+    uint8_t used_sv;
+    uint8_t ggl1;
+    uint8_t multi;
+    uint8_t reserved;
+    uint8_t ext_sol_stat;
+    uint8_t galileo_bds3_sig_mask;
+    uint8_t gps_glonass_bds2_sig_mask;
+}hpd_unicore_bestnavxyzb_t;
+
 typedef struct {
   hpd_unicore_bestnavb_t bestnav;
+#if defined(USE_GPS_UNICORE_HEADING)
+  hpd_unicore_headingb_t heading;
+#endif
+#if defined(USE_GPS_UNICORE_PVTSLN)
+  hpd_unicore_pvtslnb_t pvtsln;
+#endif
+#if defined(USE_GPS_UNICORE_OBSVM)
+  hpd_unicore_obsvmb_t obsvm;
+#endif
+#if defined(USE_GPS_UNICORE_BESTNAVXYZ)
+  hpd_unicore_bestnavxyzb_t bestnavxyz;
+#endif
+  uint32_t len_err; ///< 길이가 맞지 않아 버린 메시지 수
 } gps_unicore_bin_data_t;
 
 typedef struct gps_s gps_t;
 
 gps_unicore_resp_t gps_get_unicore_response(gps_t *gps);
 uint8_t gps_parse_unicore_term(gps_t *gps);
-uint8_t gps_parse_unicore_bin(gps_t *gps);
+size_t gps_parse_unicore_bin(gps_t *gps, const uint8_t *data, size_t len);
+
+gps_fix_t gps_unicore_pos_fix(uint32_t sol_status, uint32_t pos_type);
+
+#if defined(USE_GPS_UNICORE_HEADING)
+bool gps_unicore_heading(const gps_unicore_bin_data_t *data, int32_t *heading);
+#endif
 
 #endif
\ No newline at end of file
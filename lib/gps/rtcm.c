@@ -1,7 +1,11 @@
 #include "rtcm.h"
+#include "rtcm_msm.h"
+#include "rtcm_fec.h"
+#include "gps.h"
 #include "lora_app.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -15,98 +19,422 @@
 // LoRa 최대 236 HEX 문자 = 118 바이트 binary
 #define RTCM_MAX_FRAGMENT_SIZE 118  // Max binary size per fragment
 
-// LoRa Time on Air calculation (SF7, BW125, CR4/5, Preamble 8)
-// HEX 변환: 1 byte -> 2 HEX chars
-// 최대 118바이트 = 236 HEX chars = 350ms (측정값)
-// 20% 여유: 350ms * 1.2 = 420ms
-#define RTCM_MAX_BINARY_BYTES 118   // 최대 binary 크기
-#define LORA_TOA_MAX_MS 350         // 118바이트(236 HEX) 전송 시간
-#define LORA_TOA_MARGIN_PERCENT 20  // 20% margin
+#define RTCM_TX_TIMEOUT_MARGIN_PCT 20 // 예상 응답 시간에 더하는 여유
+#define RTCM_TX_TIMEOUT_MIN_MS 60
+
+#define RTCM_INFLIGHT_MAX 2   // LoRa TX 큐에 미리 넣어 두는 fragment 수
+#define RTCM_TX_RETRY_MS 100  // LoRa TX 큐가 찼을 때 재시도 간격
 
 /**
- * @brief Calculate LoRa Time on Air (ToA) with 20% margin
+ * @brief fragment 응답 대기 시간
  *
- * Formula: ToA = (bytes / 118) * 350ms * 1.2
+ * 예상 응답 시간 (lora_p2p_send_ms: ToA + UART 와 실측 하한 중 큰 쪽) 에 20% 여유.
  *
  * @param binary_bytes Binary payload size (before HEX conversion)
- * @return Time on Air in milliseconds (with 20% margin)
+ * @return 응답 타임아웃 [ms]
+ */
+static uint32_t rtcm_fragment_timeout_ms(size_t binary_bytes) {
+  uint32_t timeout_ms = lora_p2p_send_ms(binary_bytes) *
+                        (100 + RTCM_TX_TIMEOUT_MARGIN_PCT) / 100;
+
+  return timeout_ms < RTCM_TX_TIMEOUT_MIN_MS ? RTCM_TX_TIMEOUT_MIN_MS
+                                             : timeout_ms;
+}
+
+/**
+ * @brief epoch 묶음
+ *
+ * 한 epoch 의 RTCM 프레임을 이어 붙여 보관한다. MSM 의 multiple message bit 가
+ * 0 인 메시지 (epoch 의 마지막 MSM) 를 받으면 닫고, 다음 메시지부터 새 묶음을 연다.
  */
-static uint32_t calculate_lora_toa(size_t binary_bytes) {
-  // ToA(ms) = (bytes / 118) * 350 * 1.2
-  uint32_t toa_ms = (binary_bytes * LORA_TOA_MAX_MS / RTCM_MAX_BINARY_BYTES);
-  toa_ms = toa_ms * (100 + LORA_TOA_MARGIN_PERCENT) / 100;
+typedef struct {
+  uint16_t off;
+  uint16_t len;
+  uint16_t type;
+} rtcm_bundle_msg_t;
+
+typedef struct {
+  uint8_t data[RTCM_BUNDLE_BUF_SIZE];
+  rtcm_bundle_msg_t msg[RTCM_BUNDLE_MSG_MAX];
+  uint16_t used;
+  uint8_t msg_cnt;
+  uint8_t msg_sent; ///< 다음에 보낼 메시지
+  bool closed;
+  uint32_t open_ms;
+} rtcm_bundle_t;
 
-  // Minimum ToA
-  if (toa_ms < 60) {
-    toa_ms = 60;  // 최소 60ms (20% margin 포함)
+/* CCM 은 시작 시 0 으로 초기화되지 않으므로 묶음 버퍼만 둔다 */
+__attribute__((section(".ccmram"))) static rtcm_bundle_t rtcm_bundles[RTCM_BUNDLE_CNT];
+
+#if defined(USE_GPS_RTCM_FEC)
+__attribute__((section(".ccmram"))) static rtcm_fec_tx_t rtcm_fec;
+#endif
+
+static struct {
+  uint8_t rd; ///< 가장 오래된 묶음 (free-running)
+  uint8_t wr;
+  SemaphoreHandle_t mutex;
+  TaskHandle_t task;
+  volatile uint8_t inflight; ///< LoRa TX 큐에 넣고 완료되지 않은 fragment 수
+  rtcm_tx_stats_t stats;
+} rtcm_tx;
+
+static uint32_t rtcm_now_ms(void) {
+  return xTaskGetTickCount() * portTICK_PERIOD_MS;
+}
+
+static inline uint8_t rtcm_bundle_count(void) {
+  return (uint8_t)(rtcm_tx.wr - rtcm_tx.rd);
+}
+
+static inline rtcm_bundle_t *rtcm_bundle_at(uint8_t pos) {
+  return &rtcm_bundles[pos & (RTCM_BUNDLE_CNT - 1)];
+}
+
+/**
+ * @brief 가장 오래된 묶음 제거 (mutex 보유 상태)
+ *
+ * 보내지 못한 메시지가 남아 있으면 drop 으로 센다.
+ */
+static void rtcm_bundle_drop_oldest(void) {
+  rtcm_bundle_t *b = rtcm_bundle_at(rtcm_tx.rd);
+
+  if (b->msg_sent < b->msg_cnt) {
+    rtcm_tx.stats.epochs_dropped++;
+    rtcm_tx.stats.msgs_dropped += b->msg_cnt - b->msg_sent;
+    for (uint8_t i = b->msg_sent; i < b->msg_cnt; i++) {
+      rtcm_tx.stats.bytes_dropped += b->msg[i].len;
+    }
   }
+  rtcm_tx.rd++;
+}
+
+/**
+ * @brief 다음에 보낼 프레임 복사 (mutex 보유 상태)
+ *
+ * 새 묶음이 있는데 RTCM_BUNDLE_MAX_AGE_MS 보다 오래된 묶음은 남은 메시지를 버린다.
+ *
+ * @param whole_epoch true: 열린 묶음은 닫힐 때까지 (epoch 전체가 모일 때까지) 꺼내지 않음
+ * @return 프레임 길이, 보낼 것이 없으면 0
+ */
+static size_t rtcm_bundle_next_frame(uint8_t *buf, uint16_t *type,
+                                     bool whole_epoch) {
+  uint32_t now = rtcm_now_ms();
 
-  return toa_ms;
+  while (rtcm_bundle_count() > 0) {
+    rtcm_bundle_t *b = rtcm_bundle_at(rtcm_tx.rd);
+    bool newer = rtcm_bundle_count() > 1;
+
+    if (newer && now - b->open_ms > RTCM_BUNDLE_MAX_AGE_MS) {
+      rtcm_bundle_drop_oldest();
+      continue;
+    }
+
+    if (whole_epoch && !newer && !b->closed) {
+      if (now - b->open_ms <= RTCM_BUNDLE_CLOSE_MS) {
+        return 0;
+      }
+      b->closed = true;
+    }
+
+    if (b->msg_sent < b->msg_cnt) {
+      const rtcm_bundle_msg_t *m = &b->msg[b->msg_sent++];
+      uint32_t age = now - b->open_ms;
+
+      if (age > rtcm_tx.stats.age_max_ms) {
+        rtcm_tx.stats.age_max_ms = age;
+      }
+      memcpy(buf, &b->data[m->off], m->len);
+      *type = m->type;
+      return m->len;
+    }
+
+    if (!newer) {
+      return 0; // 열린 묶음은 다음 메시지를 기다린다
+    }
+    rtcm_tx.rd++;
+  }
+  return 0;
 }
 
 /**
- * @brief Callback for last fragment transmission completion
+ * @brief fragment 전송 완료 (LoRa TX task 에서 호출)
  */
-static void rtcm_last_fragment_callback(bool success, void *user_data) {
+static void rtcm_fragment_callback(bool success, void *user_data) {
   uint16_t msg_type = (uint16_t)(uintptr_t)user_data;
 
-  if (success) {
+  if (!success) {
+    rtcm_tx.stats.frag_fail++;
+    LOG_ERR("RTCM fragment transmission failed (type=%d)", msg_type);
+  } else if (msg_type) {
     LOG_INFO("RTCM transmission complete (type=%d)", msg_type);
-  } else {
-    LOG_ERR("RTCM last fragment transmission failed (type=%d)", msg_type);
+  }
+
+  taskENTER_CRITICAL();
+  rtcm_tx.inflight--;
+  taskEXIT_CRITICAL();
+
+  xTaskNotifyGive(rtcm_tx.task);
+}
+
+/**
+ * @brief fragment 하나를 LoRa TX 큐에 넣음
+ *
+ * @return false: airtime 한도이거나 LoRa TX 큐가 다른 명령으로 차 있음
+ *         (잠시 후 같은 fragment 재시도)
+ */
+static bool rtcm_tx_queue_fragment(const uint8_t *data, size_t len,
+                                   uint16_t msg_type) {
+  if (!lora_p2p_airtime_allow(len)) {
+    // 시간당 duty cycle 한도, 묶음에 두었다가 여유가 생기면 보낸다
+    return false;
+  }
+
+  taskENTER_CRITICAL();
+  rtcm_tx.inflight++;
+  taskEXIT_CRITICAL();
+
+  if (!lora_send_p2p_raw_async(data, len, rtcm_fragment_timeout_ms(len),
+                                rtcm_fragment_callback,
+                                (void *)(uintptr_t)msg_type)) {
+    taskENTER_CRITICAL();
+    rtcm_tx.inflight--;
+    taskEXIT_CRITICAL();
+    LOG_WARN("LoRa TX queue full - retrying RTCM fragment");
+    return false;
+  }
+
+  rtcm_tx.stats.frags_sent++;
+  return true;
+}
+
+#if defined(USE_GPS_RTCM_FEC)
+/**
+ * @brief 닫힌 epoch 의 프레임을 FEC 블록으로 묶어 데이터/parity 패킷을 차례로 보냄
+ *
+ * 블록에 들어가지 않는 프레임은 잘라 넣지 않고 다음 블록 첫 프레임으로 넘긴다.
+ */
+static void rtcm_tx_pump(void) {
+  static uint8_t frame[GPS_FRAME_MAX_SIZE];
+  static uint8_t pkt[RTCM_FEC_PKT_MAX];
+  static size_t held_len; ///< 앞 블록에 들어가지 않아 넘어온 프레임
+  static uint16_t held_type;
+  static uint8_t pkt_idx;
+  static uint8_t pkt_cnt;
+
+  while (rtcm_tx.inflight < RTCM_INFLIGHT_MAX) {
+    if (pkt_idx >= pkt_cnt) {
+      if (pkt_cnt) {
+        rtcm_fec_tx_next(&rtcm_fec);
+      }
+
+      xSemaphoreTake(rtcm_tx.mutex, portMAX_DELAY);
+      while (1) {
+        if (held_len == 0) {
+          held_len = rtcm_bundle_next_frame(frame, &held_type, true);
+        }
+        if (held_len == 0 || !rtcm_fec_tx_add(&rtcm_fec, frame, held_len)) {
+          break;
+        }
+        held_len = 0;
+      }
+      xSemaphoreGive(rtcm_tx.mutex);
+
+      pkt_cnt = rtcm_fec_tx_finish(&rtcm_fec);
+      pkt_idx = 0;
+      if (pkt_cnt == 0) {
+        break;
+      }
+      LOG_DEBUG("RTCM FEC block: %d bytes, k=%d m=%d", rtcm_fec.len,
+                rtcm_fec.k, rtcm_fec.m);
+    }
+
+    size_t len = rtcm_fec_tx_packet(&rtcm_fec, pkt_idx, pkt);
+    if (!rtcm_tx_queue_fragment(pkt, len, 0)) {
+      break;
+    }
+    pkt_idx++;
+  }
+}
+#else
+/**
+ * @brief 묶음에서 프레임을 하나씩 꺼내 118 byte fragment 로 나눠 보냄
+ *
+ * 보내기 시작한 프레임은 끝까지 보낸다.
+ */
+static void rtcm_tx_pump(void) {
+  static uint8_t frame[GPS_FRAME_MAX_SIZE];
+  static size_t frame_len;
+  static size_t frame_off;
+  static uint16_t msg_type;
+
+  while (rtcm_tx.inflight < RTCM_INFLIGHT_MAX) {
+    if (frame_off >= frame_len) {
+      xSemaphoreTake(rtcm_tx.mutex, portMAX_DELAY);
+      frame_len = rtcm_bundle_next_frame(frame, &msg_type, false);
+      xSemaphoreGive(rtcm_tx.mutex);
+
+      frame_off = 0;
+      if (frame_len == 0) {
+        break;
+      }
+    }
+
+    size_t fragment_len = frame_len - frame_off;
+    if (fragment_len > RTCM_MAX_FRAGMENT_SIZE) {
+      fragment_len = RTCM_MAX_FRAGMENT_SIZE;
+    }
+    bool is_last = (frame_off + fragment_len == frame_len);
+
+    if (!rtcm_tx_queue_fragment(&frame[frame_off], fragment_len,
+                                is_last ? msg_type : 0)) {
+      break;
+    }
+    frame_off += fragment_len;
+  }
+}
+#endif
+
+/**
+ * @brief RTCM TX task
+ *
+ * 묶음의 프레임을 LoRa TX 큐에 넣는다. 큐에는 RTCM_INFLIGHT_MAX 개까지만 넣어 두므로,
+ * 링크가 밀리면 묶음 쪽에 쌓였다가 오래된 epoch 부터 버려진다.
+ */
+static void rtcm_tx_task(void *pvParameter) {
+  (void)pvParameter;
+
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RTCM_TX_RETRY_MS));
+    rtcm_tx_pump();
   }
 }
 
 void rtcm_tx_task_init(void) {
-  // No task needed anymore - direct async transmission
-  LOG_INFO("RTCM async transmission initialized (no task)");
+  memset(&rtcm_tx, 0, sizeof(rtcm_tx));
+#if defined(USE_GPS_RTCM_FEC)
+  rtcm_fec_tx_init(&rtcm_fec, GPS_RTCM_FEC_PARITY_PCT);
+#endif
+
+  rtcm_tx.mutex = xSemaphoreCreateMutex();
+  if (rtcm_tx.mutex == NULL) {
+    LOG_ERR("RTCM mutex 생성 실패");
+    return;
+  }
+
+  if (xTaskCreate(rtcm_tx_task, "rtcm_tx", 1024, NULL, tskIDLE_PRIORITY + 2,
+                  &rtcm_tx.task) != pdPASS) {
+    LOG_ERR("RTCM TX task 생성 실패");
+    rtcm_tx.task = NULL;
+    return;
+  }
+
+  LOG_INFO("RTCM TX task initialized (%d epoch bundles)", RTCM_BUNDLE_CNT);
 }
 
-bool rtcm_send_to_lora(gps_t *gps) {
-  if (!gps) {
-    LOG_ERR("GPS handle is NULL");
+bool rtcm_send_to_lora(const uint8_t *data, size_t len, uint16_t msg_type) {
+  if (!data) {
+    LOG_ERR("RTCM data is NULL");
     return false;
   }
 
-  // RTCM packet total length
-  size_t rtcm_len = gps->rtcm.total_len;
-
-  if (rtcm_len == 0) {
+  if (len == 0) {
     LOG_ERR("RTCM length is zero");
     return false;
   }
 
-  // Calculate total fragments needed
-  uint8_t total_fragments = (rtcm_len + RTCM_MAX_FRAGMENT_SIZE - 1) / RTCM_MAX_FRAGMENT_SIZE;
-
-  LOG_INFO("RTCM TX: type=%d, len=%d, fragments=%d",
-           gps->rtcm.msg_type, rtcm_len, total_fragments);
+  if (rtcm_tx.task == NULL) {
+    LOG_ERR("RTCM TX task not initialized");
+    return false;
+  }
 
-  // Queue all fragments at once
-  for (uint8_t i = 0; i < total_fragments; i++) {
-    size_t offset = i * RTCM_MAX_FRAGMENT_SIZE;
-    size_t fragment_len = (rtcm_len - offset > RTCM_MAX_FRAGMENT_SIZE)
-                          ? RTCM_MAX_FRAGMENT_SIZE
-                          : (rtcm_len - offset);
+  if (len > RTCM_BUNDLE_BUF_SIZE) {
+    rtcm_tx.stats.overflow++;
+    LOG_ERR("RTCM frame too large for bundle: %d", len);
+    return false;
+  }
 
-    uint32_t toa_ms = calculate_lora_toa(fragment_len);
+  uint32_t now = rtcm_now_ms();
 
-    LOG_DEBUG("Queueing fragment %d/%d: %d bytes",
-             i + 1, total_fragments, fragment_len);
+  xSemaphoreTake(rtcm_tx.mutex, portMAX_DELAY);
 
-    // Last fragment gets callback for logging
-    bool is_last = (i == total_fragments - 1);
-    lora_command_callback_t callback = is_last ? rtcm_last_fragment_callback : NULL;
-    void *user_data = is_last ? (void*)(uintptr_t)gps->rtcm.msg_type : NULL;
+  rtcm_bundle_t *b = NULL;
+  if (rtcm_bundle_count() > 0) {
+    b = rtcm_bundle_at(rtcm_tx.wr - 1);
+    // multiple message bit 를 주지 않는 수신기는 시간으로 epoch 를 닫는다
+    if (!b->closed && now - b->open_ms > RTCM_BUNDLE_CLOSE_MS) {
+      b->closed = true;
+    }
+    if (b->closed || b->used + len > RTCM_BUNDLE_BUF_SIZE ||
+        b->msg_cnt >= RTCM_BUNDLE_MSG_MAX) {
+      b->closed = true;
+      b = NULL;
+    }
+  }
 
-    if (!lora_send_p2p_raw_async(&gps->payload[offset], fragment_len, toa_ms,
-                                  callback, user_data)) {
-      LOG_ERR("Failed to queue fragment %d/%d - LoRa TX queue full?", i + 1, total_fragments);
-      return false;
+  if (b == NULL) {
+    if (rtcm_bundle_count() >= RTCM_BUNDLE_CNT) {
+      LOG_WARN("RTCM bundles full - dropping oldest epoch");
+      rtcm_bundle_drop_oldest();
     }
+    b = rtcm_bundle_at(rtcm_tx.wr++);
+    b->used = 0;
+    b->msg_cnt = 0;
+    b->msg_sent = 0;
+    b->closed = false;
+    b->open_ms = now;
+    rtcm_tx.stats.epochs++;
   }
 
-  // All fragments queued successfully - return immediately (non-blocking)
-  LOG_INFO("All %d fragments queued to LoRa TX task", total_fragments);
+  rtcm_bundle_msg_t *m = &b->msg[b->msg_cnt++];
+  m->off = b->used;
+  m->len = len;
+  m->type = msg_type;
+  memcpy(&b->data[b->used], data, len);
+  b->used += len;
+  rtcm_tx.stats.msgs++;
+
+  // MSM 의 DF393 (payload bit 54) 이 0 이면 이 epoch 의 마지막 메시지
+  if (rtcm_msm_is_msm(msg_type) && len > 9 && ((data[9] >> 1) & 0x01) == 0) {
+    b->closed = true;
+  }
+
+  xSemaphoreGive(rtcm_tx.mutex);
+
+  LOG_DEBUG("RTCM queued: type=%d, len=%d, epoch msgs=%d", msg_type, len,
+            b->msg_cnt);
+
+  xTaskNotifyGive(rtcm_tx.task);
   return true;
 }
+
+void rtcm_get_tx_stats(rtcm_tx_stats_t *stats) {
+  if (rtcm_tx.mutex == NULL) {
+    memset(stats, 0, sizeof(*stats));
+    return;
+  }
+  xSemaphoreTake(rtcm_tx.mutex, portMAX_DELAY);
+  *stats = rtcm_tx.stats;
+  stats->pending = 0;
+  for (uint8_t pos = rtcm_tx.rd; pos != rtcm_tx.wr; pos++) {
+    const rtcm_bundle_t *b = rtcm_bundle_at(pos);
+    stats->pending += b->msg_cnt - b->msg_sent;
+  }
+  xSemaphoreGive(rtcm_tx.mutex);
+}
+
+int rtcm_format_tx_stats(char *buf, size_t size) {
+  rtcm_tx_stats_t st;
+
+  if (rtcm_tx.mutex == NULL) {
+    return -1;
+  }
+  rtcm_get_tx_stats(&st);
+
+  return snprintf(buf, size, "%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%u",
+                  (unsigned long)st.epochs, (unsigned long)st.msgs,
+                  (unsigned long)st.frags_sent, (unsigned long)st.epochs_dropped,
+                  (unsigned long)st.msgs_dropped, (unsigned long)st.bytes_dropped,
+                  (unsigned long)st.overflow, (unsigned long)st.frag_fail,
+                  (unsigned long)st.age_max_ms, st.pending);
+}
@@ -3,30 +3,75 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "gps.h"
+#include <stddef.h>
+
+/*
+ * RTCM 은 epoch 단위 묶음에 쌓았다가 RTCM TX task 가 LoRa TX 큐로 조금씩 넘긴다.
+ * 링크가 밀려 묶음이 모두 차면 새 데이터 대신 가장 오래된 epoch 를 버리고,
+ * 새 epoch 가 있는데 RTCM_BUNDLE_MAX_AGE_MS 보다 오래된 epoch 도 버린다.
+ * USE_GPS_RTCM_FEC 이면 닫힌 epoch 를 FEC 블록 (rtcm_fec.h) 으로 묶어 parity 와 함께 보낸다.
+ */
+#define RTCM_BUNDLE_CNT 4           ///< 2의 거듭제곱
+#define RTCM_BUNDLE_BUF_SIZE 1536   ///< epoch 당 최대 바이트 (RTCM 최대 프레임 1029 이상)
+#define RTCM_BUNDLE_MSG_MAX 12      ///< epoch 당 최대 메시지 수
+#define RTCM_BUNDLE_CLOSE_MS 500    ///< multiple message bit 없이 epoch 를 닫는 시간
+#define RTCM_BUNDLE_MAX_AGE_MS 1500 ///< 새 epoch 가 있을 때 남은 메시지를 버리는 나이
+
+typedef struct {
+  uint32_t epochs;         ///< 연 묶음 수
+  uint32_t msgs;           ///< 받은 메시지 수
+  uint32_t frags_sent;     ///< LoRa TX 큐에 넣은 fragment 수
+  uint32_t epochs_dropped; ///< 다 보내지 못하고 버린 epoch 수
+  uint32_t msgs_dropped;
+  uint32_t bytes_dropped;
+  uint32_t overflow;       ///< 묶음에 들어가지 않아 버린 메시지
+  uint32_t frag_fail;      ///< LoRa 전송 실패 fragment
+  uint32_t age_max_ms;     ///< 전송 시작 시 최대 대기 시간
+  uint16_t pending;        ///< 묶음에 남은 메시지 수
+} rtcm_tx_stats_t;
 
 /**
- * @brief RTCM 전송 초기화 (task 없음)
+ * @brief RTCM 전송 초기화
  *
- * RTCM 데이터를 비동기로 LoRa TX task를 통해 전송
- * 별도의 RTCM task 없이 LoRa TX task를 직접 사용
+ * epoch 묶음과 RTCM TX task 를 만든다. 기지국에서만 호출한다.
  */
 void rtcm_tx_task_init(void);
 
 /**
  * @brief RTCM 데이터를 LoRa로 전송 (비동기, 자동 분할)
  *
- * - 완전 비동기 전송: 즉시 리턴 (GPS Task 블록 안 됨)
+ * - 완전 비동기 전송: 현재 epoch 묶음에 복사하고 즉시 리턴
  * - HEX ASCII 변환으로 인해 최대 118바이트씩 전송
- * - 118바이트 초과 시 자동으로 여러 fragment로 분할
- * - ToA(Time on Air) 자동 계산: (bytes / 118) * 350ms * 1.2
- * - 모든 fragment를 LoRa TX 큐에 추가 (순차 처리)
- * - 모든 RTCM 타입 전송 (1074, 1084, 1124 등)
- * - LoRa TX 큐가 가득 찬 경우에만 실패
+ * - 118바이트 초과 시 RTCM TX task 가 여러 fragment로 분할
+ * - ToA(Time on Air) 는 현재 LoRa P2P 설정으로 계산 (lora_p2p_toa_ms)
+ * - 시간당 airtime 한도를 넘으면 한도 안으로 돌아올 때까지 묶음에 남겨 둔다
+ * - 묶음이 모두 차면 가장 오래된 epoch 를 버리고 새 데이터를 받는다
+ *
+ * @note GPS 이벤트 소비 태스크에서 호출되므로 수신 링 버퍼가 아닌
+ * 이벤트 큐에서 복사해 온 연속 버퍼를 받는다.
+ *
+ * @param data RTCM 프레임 (preamble ~ CRC)
+ * @param len 프레임 길이
+ * @param msg_type RTCM 메시지 타입 (로그용)
+ * @return true: 묶음 추가 성공, false: 초기화 안 됨 또는 에러
+ */
+bool rtcm_send_to_lora(const uint8_t *data, size_t len, uint16_t msg_type);
+
+/**
+ * @brief 전송 통계 조회 (초기화 전이면 모두 0)
+ *
+ * pending 은 RTCM 스케줄러 (rtcm_sched.h) 의 혼잡 판단 깊이로도 쓴다.
+ */
+void rtcm_get_tx_stats(rtcm_tx_stats_t *stats);
+
+/**
+ * @brief 전송 통계 한 줄
+ *
+ * epochs,msgs,frags,epochs_dropped,msgs_dropped,bytes_dropped,overflow,
+ * frag_fail,age_max[ms],pending
  *
- * @param gps GPS 핸들
- * @return true: 큐 추가 성공, false: 큐 full 또는 에러
+ * @return snprintf 결과, 초기화 전이면 -1
  */
-bool rtcm_send_to_lora(gps_t *gps);
+int rtcm_format_tx_stats(char *buf, size_t size);
 
 #endif
@@ -0,0 +1,286 @@
+#include "rtcm_fec.h"
+#include "gps_crc.h"
+#include <string.h>
+
+static inline uint16_t fec_slice_len(uint8_t i, uint8_t k, uint8_t last_len) {
+  return i + 1 < k ? RTCM_FEC_PAYLOAD : last_len;
+}
+
+static void fec_xor(uint8_t *dst, const uint8_t *src, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    dst[i] ^= src[i];
+  }
+}
+
+void rtcm_fec_tx_init(rtcm_fec_tx_t *tx, uint8_t parity_pct) {
+  memset(tx, 0, sizeof(*tx));
+  tx->parity_pct = parity_pct;
+}
+
+bool rtcm_fec_tx_add(rtcm_fec_tx_t *tx, const uint8_t *frame, size_t len) {
+  if (tx->k || tx->len + len > RTCM_FEC_BLOCK_MAX) {
+    return false;
+  }
+  memcpy(&tx->data[tx->len], frame, len);
+  tx->len += len;
+  return true;
+}
+
+uint8_t rtcm_fec_tx_finish(rtcm_fec_tx_t *tx) {
+  if (tx->len == 0) {
+    return 0;
+  }
+
+  uint8_t k = (tx->len + RTCM_FEC_PAYLOAD - 1) / RTCM_FEC_PAYLOAD;
+  uint8_t m = (k * tx->parity_pct + 99) / 100;
+  if (m > k) {
+    m = k;
+  }
+  if (m > RTCM_FEC_PARITY_MAX) {
+    m = RTCM_FEC_PARITY_MAX;
+  }
+
+  uint8_t last_len = tx->len - (k - 1) * RTCM_FEC_PAYLOAD;
+  memset(tx->parity, 0, sizeof(tx->parity));
+  for (uint8_t i = 0; i < k && m; i++) {
+    fec_xor(tx->parity[i % m], &tx->data[i * RTCM_FEC_PAYLOAD],
+            fec_slice_len(i, k, last_len));
+  }
+
+  tx->k = k;
+  tx->m = m;
+  return k + m;
+}
+
+size_t rtcm_fec_tx_packet(const rtcm_fec_tx_t *tx, uint8_t idx, uint8_t *out) {
+  uint8_t k = tx->k;
+  uint8_t last_len = tx->len - (k - 1) * RTCM_FEC_PAYLOAD;
+  size_t len;
+
+  out[0] = RTCM_FEC_MAGIC | RTCM_FEC_VERSION;
+  out[1] = tx->block_id;
+  out[2] = idx;
+  out[3] = (k << 4) | tx->m;
+  out[4] = last_len;
+
+  if (idx < k) {
+    len = fec_slice_len(idx, k, last_len);
+    memcpy(&out[RTCM_FEC_HDR_SIZE], &tx->data[idx * RTCM_FEC_PAYLOAD], len);
+  } else {
+    // 클래스에 꽉 찬 fragment 가 없으면 (k 가 작을 때) parity 도 짧게 보낸다
+    uint8_t j = idx - k;
+    len = (j + 1 < k) ? RTCM_FEC_PAYLOAD : last_len;
+    memcpy(&out[RTCM_FEC_HDR_SIZE], tx->parity[j], len);
+  }
+  return RTCM_FEC_HDR_SIZE + len;
+}
+
+void rtcm_fec_tx_next(rtcm_fec_tx_t *tx) {
+  tx->block_id++;
+  tx->k = 0;
+  tx->m = 0;
+  tx->len = 0;
+}
+
+bool rtcm_fec_is_packet(const uint8_t *pkt, size_t len) {
+  return len > RTCM_FEC_HDR_SIZE &&
+         (pkt[0] & RTCM_FEC_MAGIC_MASK) == RTCM_FEC_MAGIC;
+}
+
+void rtcm_fec_rx_init(rtcm_fec_rx_t *rx) { memset(rx, 0, sizeof(*rx)); }
+
+/**
+ * @brief parity 클래스마다 빠진 데이터가 하나면 복구
+ */
+static void fec_rx_repair(rtcm_fec_rx_t *rx) {
+  for (uint8_t j = 0; j < rx->m; j++) {
+    if (!(rx->have & (1UL << (rx->k + j)))) {
+      continue;
+    }
+
+    int missing = -1;
+    uint8_t cnt = 0;
+    for (uint8_t i = j; i < rx->k; i += rx->m) {
+      if (!(rx->have & (1UL << i))) {
+        missing = i;
+        cnt++;
+      }
+    }
+    if (cnt != 1) {
+      continue;
+    }
+
+    uint8_t *dst = rx->pkt[missing];
+    memcpy(dst, rx->pkt[rx->k + j], RTCM_FEC_PAYLOAD);
+    for (uint8_t i = j; i < rx->k; i += rx->m) {
+      if (i != missing) {
+        fec_xor(dst, rx->pkt[i], RTCM_FEC_PAYLOAD);
+      }
+    }
+    rx->have |= 1UL << missing;
+    rx->repaired = true;
+    rx->stats.pkts_recovered++;
+  }
+}
+
+static inline bool fec_rx_have_range(const rtcm_fec_rx_t *rx, size_t off,
+                                     size_t len) {
+  for (size_t i = off / RTCM_FEC_PAYLOAD; i <= (off + len - 1) / RTCM_FEC_PAYLOAD; i++) {
+    if (!(rx->have & (1UL << i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 복구하지 못한 블록에서 받은 fragment 안에 온전히 들어 있는 프레임만 추출
+ *
+ * 빠진 fragment 뒤에서는 preamble 과 CRC 로 다음 프레임 경계를 다시 찾는다.
+ *
+ * @return out 에 쓴 길이 (CRC 가 맞는 프레임 연속)
+ */
+static size_t fec_rx_salvage(const rtcm_fec_rx_t *rx, uint8_t *out,
+                             size_t out_size) {
+  size_t total = (rx->k - 1) * RTCM_FEC_PAYLOAD + rx->last_len;
+  size_t off = 0;
+  size_t w = 0;
+
+  while (off + 6 <= total) {
+    uint8_t i = off / RTCM_FEC_PAYLOAD;
+    if (!(rx->have & (1UL << i))) {
+      off = (i + 1) * RTCM_FEC_PAYLOAD;
+      continue;
+    }
+
+    const uint8_t *p = &rx->pkt[i][off % RTCM_FEC_PAYLOAD];
+    if (p[0] != 0xD3 || !fec_rx_have_range(rx, off, 3)) {
+      off++;
+      continue;
+    }
+
+    uint8_t b1 = rx->pkt[(off + 1) / RTCM_FEC_PAYLOAD][(off + 1) % RTCM_FEC_PAYLOAD];
+    uint8_t b2 = rx->pkt[(off + 2) / RTCM_FEC_PAYLOAD][(off + 2) % RTCM_FEC_PAYLOAD];
+    size_t flen = (((b1 & 0x03) << 8) | b2) + 6;
+    if (off + flen > total || w + flen > out_size ||
+        !fec_rx_have_range(rx, off, flen)) {
+      off++;
+      continue;
+    }
+
+    for (size_t n = 0; n < flen;) {
+      size_t pos = off + n;
+      size_t chunk = RTCM_FEC_PAYLOAD - pos % RTCM_FEC_PAYLOAD;
+      if (chunk > flen - n) {
+        chunk = flen - n;
+      }
+      memcpy(&out[w + n], &rx->pkt[pos / RTCM_FEC_PAYLOAD][pos % RTCM_FEC_PAYLOAD], chunk);
+      n += chunk;
+    }
+
+    uint32_t crc = gps_crc24q(&out[w], flen - 3);
+    if (out[w + flen - 3] != ((crc >> 16) & 0xFF) ||
+        out[w + flen - 2] != ((crc >> 8) & 0xFF) ||
+        out[w + flen - 1] != (crc & 0xFF)) {
+      off++;
+      continue;
+    }
+    w += flen;
+    off += flen;
+  }
+  return w;
+}
+
+size_t rtcm_fec_rx_push(rtcm_fec_rx_t *rx, const uint8_t *pkt, size_t len,
+                        uint8_t *out, size_t out_size) {
+  if (!rtcm_fec_is_packet(pkt, len)) {
+    rx->stats.pkts_invalid++;
+    return 0;
+  }
+  if ((pkt[0] & ~RTCM_FEC_MAGIC_MASK) != RTCM_FEC_VERSION) {
+    rx->stats.pkts_version++;
+    return 0;
+  }
+
+  uint8_t id = pkt[1];
+  uint8_t idx = pkt[2];
+  uint8_t k = pkt[3] >> 4;
+  uint8_t m = pkt[3] & 0x0F;
+  uint8_t last_len = pkt[4];
+  size_t plen = len - RTCM_FEC_HDR_SIZE;
+
+  if (k == 0 || k > RTCM_FEC_DATA_MAX || m > RTCM_FEC_PARITY_MAX ||
+      idx >= k + m || last_len == 0 || last_len > RTCM_FEC_PAYLOAD ||
+      plen > RTCM_FEC_PAYLOAD ||
+      (idx < k && plen != fec_slice_len(idx, k, last_len))) {
+    rx->stats.pkts_invalid++;
+    return 0;
+  }
+
+  rx->stats.pkts++;
+
+  size_t w = 0;
+  if (!rx->active || id != rx->block_id) {
+    if (rx->prev_valid && id == rx->prev_id) {
+      return 0; // 이미 넘어간 블록의 늦은 패킷
+    }
+    if (rx->active) {
+      if (!rx->done) {
+        w = fec_rx_salvage(rx, out, out_size);
+        if (w) {
+          rx->stats.blocks_partial++;
+        } else {
+          rx->stats.blocks_lost++;
+        }
+      }
+      rx->prev_id = rx->block_id;
+      rx->prev_valid = true;
+    }
+    rx->active = true;
+    rx->done = false;
+    rx->repaired = false;
+    rx->block_id = id;
+    rx->k = k;
+    rx->m = m;
+    rx->last_len = last_len;
+    rx->have = 0;
+    rx->stats.blocks++;
+  } else if (k != rx->k || m != rx->m || last_len != rx->last_len) {
+    rx->stats.pkts_invalid++;
+    return 0;
+  }
+
+  if (rx->done || (rx->have & (1UL << idx))) {
+    return w;
+  }
+
+  memcpy(rx->pkt[idx], &pkt[RTCM_FEC_HDR_SIZE], plen);
+  memset(&rx->pkt[idx][plen], 0, RTCM_FEC_PAYLOAD - plen);
+  rx->have |= 1UL << idx;
+
+  uint32_t data_mask = (1UL << k) - 1;
+  if ((rx->have & data_mask) != data_mask) {
+    fec_rx_repair(rx);
+    if ((rx->have & data_mask) != data_mask) {
+      return w;
+    }
+  }
+
+  size_t total = (k - 1) * RTCM_FEC_PAYLOAD + last_len;
+  if (w + total > out_size) {
+    rx->stats.blocks_lost++;
+    rx->done = true;
+    return w;
+  }
+  for (uint8_t i = 0; i < k; i++) {
+    memcpy(&out[w + i * RTCM_FEC_PAYLOAD], rx->pkt[i], fec_slice_len(i, k, last_len));
+  }
+
+  rx->done = true;
+  if (rx->repaired) {
+    rx->stats.blocks_recovered++;
+  } else {
+    rx->stats.blocks_ok++;
+  }
+  return w + total;
+}
@@ -0,0 +1,122 @@
+#ifndef RTCM_FEC_H
+#define RTCM_FEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * LoRa P2P RTCM fragment FEC
+ *
+ * 연속된 RTCM 프레임 (프레임을 자르지 않음) 을 한 블록으로 모아 payload 크기로 나누고,
+ * 데이터 fragment k 개 뒤에 interleave XOR parity m 개를 붙인다.
+ * parity j 는 i % m == j 인 데이터 fragment 의 XOR 이므로 클래스마다 하나씩,
+ * 즉 연속 m 개까지의 손실을 재전송 없이 복구한다.
+ *
+ * 패킷 = 헤더 5 byte + payload (최대 RTCM_FEC_PAYLOAD)
+ *   magic(0xF) << 4 | version, block id, index (0~k-1 데이터, k~ parity), k << 4 | m,
+ *   마지막 데이터 길이
+ * magic 이 RTCM preamble (0xD3) 과 다르므로 rover 는 FEC 없는 기존 패킷과 구분한다.
+ * 헤더 형식이 바뀌면 RTCM_FEC_VERSION 을 올린다. rover 는 버전이 다른 FEC 패킷과
+ * (FEC 를 끈 rover 는 모든 FEC 패킷을) 재조립기에 넣지 않고 버린다.
+ * FEC 이전 펌웨어의 rover 는 FEC 패킷을 알아보지 못하므로 기지국 FEC 를 켜기 전에
+ * rover 를 먼저 올린다.
+ */
+#define RTCM_FEC_PKT_MAX 118 ///< LoRa HEX 전송 최대 binary
+#define RTCM_FEC_HDR_SIZE 5
+#define RTCM_FEC_PAYLOAD (RTCM_FEC_PKT_MAX - RTCM_FEC_HDR_SIZE)
+#define RTCM_FEC_DATA_MAX 12  ///< 블록당 데이터 fragment (RTCM 최대 프레임 1029 이상)
+#define RTCM_FEC_PARITY_MAX 6 ///< 블록당 parity fragment
+#define RTCM_FEC_BLOCK_MAX (RTCM_FEC_DATA_MAX * RTCM_FEC_PAYLOAD)
+#define RTCM_FEC_OUT_MAX (2 * RTCM_FEC_BLOCK_MAX) ///< rx 출력 (이전 블록 잔여 + 새 블록)
+#define RTCM_FEC_MAGIC 0xF0      ///< 첫 byte 상위 4 bit
+#define RTCM_FEC_MAGIC_MASK 0xF0
+#define RTCM_FEC_VERSION 1        ///< 첫 byte 하위 4 bit
+
+typedef struct {
+  uint8_t parity_pct; ///< 데이터 대비 parity 비율 [%]
+  uint8_t block_id;
+  uint8_t k;
+  uint8_t m;
+  uint16_t len;
+  uint8_t data[RTCM_FEC_BLOCK_MAX];
+  uint8_t parity[RTCM_FEC_PARITY_MAX][RTCM_FEC_PAYLOAD];
+} rtcm_fec_tx_t;
+
+typedef struct {
+  uint32_t blocks;           ///< 시작된 블록
+  uint32_t blocks_ok;        ///< 손실 없이 받은 블록
+  uint32_t blocks_recovered; ///< parity 로 복구한 블록
+  uint32_t blocks_partial;   ///< 복구하지 못했지만 일부 프레임을 건진 블록
+  uint32_t blocks_lost;      ///< 프레임을 하나도 건지지 못한 블록
+  uint32_t pkts;
+  uint32_t pkts_recovered;   ///< parity 로 되살린 데이터 fragment
+  uint32_t pkts_invalid;     ///< 헤더가 맞지 않는 패킷
+  uint32_t pkts_version;     ///< 버전이 다른 패킷
+} rtcm_fec_rx_stats_t;
+
+typedef struct {
+  bool active;
+  bool done;     ///< 이미 출력한 블록
+  bool repaired; ///< parity 로 복구한 fragment 가 있음
+  bool prev_valid;
+  uint8_t prev_id; ///< 직전 블록 (늦게 온 중복 패킷 무시용)
+  uint8_t block_id;
+  uint8_t k;
+  uint8_t m;
+  uint8_t last_len;
+  uint32_t have; ///< 받은 fragment (bit)
+  uint8_t pkt[RTCM_FEC_DATA_MAX + RTCM_FEC_PARITY_MAX][RTCM_FEC_PAYLOAD];
+  rtcm_fec_rx_stats_t stats;
+} rtcm_fec_rx_t;
+
+void rtcm_fec_tx_init(rtcm_fec_tx_t *tx, uint8_t parity_pct);
+
+/**
+ * @brief 블록에 RTCM 프레임 추가
+ *
+ * @return false: 블록에 들어가지 않음 (rtcm_fec_tx_finish() 후 다음 블록에 추가)
+ */
+bool rtcm_fec_tx_add(rtcm_fec_tx_t *tx, const uint8_t *frame, size_t len);
+
+/**
+ * @brief 블록을 닫고 parity 계산
+ *
+ * @return 보낼 패킷 수 (k + m), 빈 블록이면 0
+ */
+uint8_t rtcm_fec_tx_finish(rtcm_fec_tx_t *tx);
+
+/**
+ * @brief 패킷 idx 생성 (finish 후)
+ *
+ * @param out 최소 RTCM_FEC_PKT_MAX
+ * @return 패킷 길이
+ */
+size_t rtcm_fec_tx_packet(const rtcm_fec_tx_t *tx, uint8_t idx, uint8_t *out);
+
+/**
+ * @brief 다음 블록 준비 (block id 증가)
+ */
+void rtcm_fec_tx_next(rtcm_fec_tx_t *tx);
+
+/**
+ * @brief FEC 패킷인지 (버전과 무관하게 magic 만 확인)
+ */
+bool rtcm_fec_is_packet(const uint8_t *pkt, size_t len);
+
+void rtcm_fec_rx_init(rtcm_fec_rx_t *rx);
+
+/**
+ * @brief 수신 패킷 처리
+ *
+ * 데이터가 모두 모이거나 parity 로 복구되면 블록 데이터 (RTCM 프레임 연속) 를 out 에 쓴다.
+ * 복구되지 못한 블록은 다음 블록 패킷이 올 때 받은 fragment 안에 온전히 들어 있는
+ * 프레임 (CRC 확인) 만 먼저 out 에 쓰고, 그 뒤에 새 블록 데이터가 이어질 수 있다.
+ *
+ * @param out 최소 RTCM_FEC_OUT_MAX
+ * @return out 에 쓴 길이, 없으면 0
+ */
+size_t rtcm_fec_rx_push(rtcm_fec_rx_t *rx, const uint8_t *pkt, size_t len,
+                        uint8_t *out, size_t out_size);
+
+#endif
@@ -0,0 +1,724 @@
+#include "rtcm_msm.h"
+#include "gps_crc.h"
+#include <string.h>
+
+#define MSM_HDR_BITS 169 ///< 고정 헤더 (type ~ signal mask)
+#define MSM_FRAME_OVERHEAD 6
+#define MSM_EMPTY_SIZE ((MSM_HDR_BITS + 7) / 8 + MSM_FRAME_OVERHEAD) ///< 위성 없는 MSM
+
+/* 레벨별 위성/셀 필드 비트 수 (index: level - 4) */
+static const uint8_t msm_sat_bits[4] = {18, 36, 18, 36};
+static const uint8_t msm_cell_bits[4] = {48, 63, 65, 80};
+
+/**
+ * @brief 신호 번호 -> 주파수 대역 (같은 대역의 신호는 서로 중복으로 본다)
+ *
+ * MSM 신호 번호는 시스템과 무관하게 대역별로 묶여 있으므로 번호 구간으로 나눈다.
+ * GPS/QZSS 의 L1C (30~32) 는 L1, GPS 의 L2C (15~17) 는 L2 로 합친다.
+ */
+static const uint8_t msm_sig_band[33] = {
+  0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 3, 3, 3,
+  3, 4, 4, 4, 4, 5, 5, 5, 6, 6, 6, 6, 6, 7, 7, 7,
+};
+
+static inline uint8_t msm_level(uint16_t msg_type) { return msg_type % 10; }
+
+static inline uint8_t msm_sys(uint16_t msg_type) {
+  return (msg_type - 1071) / 10;
+}
+
+static uint8_t msm_band(uint8_t sys, uint8_t sig) {
+  uint8_t band = msm_sig_band[sig];
+
+  if ((sys == 0 || sys == 4) && band == 7) {
+    return 1;
+  }
+  if (sys == 0 && band == 3) {
+    return 2;
+  }
+  return band;
+}
+
+/**
+ * @brief 최대 32 비트 읽기 (MSB first)
+ *
+ * 5 바이트 창으로 한 번에 읽으므로 비트 단위 루프보다 훨씬 빠르다.
+ */
+static uint32_t getbitu(const uint8_t *buf, uint32_t pos, uint8_t len) {
+  uint32_t byte = pos >> 3;
+  uint32_t end = (pos + len + 7) >> 3;
+  uint64_t v = 0;
+
+  for (uint32_t i = byte; i < end; i++) {
+    v = (v << 8) | buf[i];
+  }
+  v >>= (end << 3) - pos - len;
+  return (uint32_t)(v & ((1ULL << len) - 1));
+}
+
+static int32_t getbits(const uint8_t *buf, uint32_t pos, uint8_t len) {
+  uint32_t v = getbitu(buf, pos, len);
+
+  if (len < 32 && (v & (1UL << (len - 1)))) {
+    v |= ~((1UL << len) - 1);
+  }
+  return (int32_t)v;
+}
+
+/**
+ * @brief 최대 32 비트 쓰기 (0 으로 초기화된 버퍼에 OR)
+ */
+static void setbitu(uint8_t *buf, uint32_t pos, uint8_t len, uint32_t data) {
+  uint32_t shift = pos & 7;
+  uint32_t nbytes = (shift + len + 7) >> 3;
+  uint64_t v = (uint64_t)(data & (uint32_t)((1ULL << len) - 1));
+
+  v <<= (nbytes << 3) - shift - len;
+  for (uint32_t i = 0; i < nbytes; i++) {
+    buf[(pos >> 3) + i] |= (uint8_t)(v >> ((nbytes - 1 - i) << 3));
+  }
+}
+
+static inline int32_t clamp32(int32_t v, int32_t lim) {
+  return v > lim ? lim : (v < -lim ? -lim : v);
+}
+
+/**
+ * @brief DF407 확장 lock 지시자 -> [ms]
+ */
+static uint32_t lock_ext_to_ms(uint32_t l) {
+  if (l < 64) {
+    return l;
+  }
+  if (l > 704) {
+    l = 704;
+  }
+  uint32_t seg = l / 32;
+  return (1UL << (seg - 1)) * (l - (seg - 1) * 32);
+}
+
+static uint32_t lock_ms_to_ext(uint32_t ms) {
+  if (ms < 64) {
+    return ms;
+  }
+  if (ms >= (1UL << 26)) {
+    return 704;
+  }
+  uint32_t k = 31 - __builtin_clz(ms) - 5;
+  return (ms >> k) + 32 * k;
+}
+
+/**
+ * @brief DF402 lock 지시자 -> [ms]
+ */
+static uint32_t lock4_to_ms(uint32_t i) { return i ? 16UL << i : 0; }
+
+static uint32_t lock_ms_to_4(uint32_t ms) {
+  if (ms < 32) {
+    return 0;
+  }
+  uint32_t i = 31 - __builtin_clz(ms) - 4;
+  return i > 15 ? 15 : i;
+}
+
+bool rtcm_msm_is_msm(uint16_t msg_type) {
+  if (msg_type < 1071 || msg_type > 1137) {
+    return false;
+  }
+  uint8_t level = msm_level(msg_type);
+  return level >= 1 && level <= 7;
+}
+
+bool rtcm_msm_decode(const uint8_t *frame, size_t len, rtcm_msm_t *msm) {
+  if (!frame || !msm || len < MSM_FRAME_OVERHEAD || frame[0] != 0xD3) {
+    return false;
+  }
+
+  uint32_t plen = ((uint32_t)(frame[1] & 0x03) << 8) | frame[2];
+  if (plen + MSM_FRAME_OVERHEAD != len || plen * 8 < MSM_HDR_BITS) {
+    return false;
+  }
+
+  const uint8_t *p = frame + 3;
+  uint32_t bits = plen * 8;
+  uint16_t type = getbitu(p, 0, 12);
+  uint8_t level = msm_level(type);
+  if (!rtcm_msm_is_msm(type) || level < 4) {
+    return false;
+  }
+
+  msm->msg_type = type;
+  msm->level = level;
+  msm->ref_id = getbitu(p, 12, 12);
+  msm->epoch = getbitu(p, 24, 30);
+  msm->multi = getbitu(p, 54, 1);
+  msm->iods = getbitu(p, 55, 3);
+  msm->reserved = getbitu(p, 58, 7);
+  msm->clk_steer = getbitu(p, 65, 2);
+  msm->ext_clk = getbitu(p, 67, 2);
+  msm->smooth = getbitu(p, 69, 1);
+  msm->smooth_int = getbitu(p, 70, 3);
+
+  uint8_t sats[RTCM_MSM_SAT_MAX];
+  uint8_t sigs[32];
+  uint8_t nsat = 0, nsig = 0;
+  uint32_t pos = 73;
+
+  for (uint8_t i = 0; i < RTCM_MSM_SAT_MAX; i++, pos++) {
+    if (getbitu(p, pos, 1)) {
+      sats[nsat++] = i + 1;
+    }
+  }
+  for (uint8_t i = 0; i < 32; i++, pos++) {
+    if (getbitu(p, pos, 1)) {
+      sigs[nsig++] = i + 1;
+    }
+  }
+
+  uint32_t nmask = (uint32_t)nsat * nsig;
+  if (nmask > RTCM_MSM_CELL_MAX || pos + nmask > bits) {
+    return false;
+  }
+
+  uint8_t ncell = 0;
+  for (uint8_t s = 0; s < nsat; s++) {
+    for (uint8_t g = 0; g < nsig; g++, pos++) {
+      if (getbitu(p, pos, 1)) {
+        msm->cell[ncell].sat = sats[s];
+        msm->cell[ncell].sig = sigs[g];
+        ncell++;
+      }
+    }
+  }
+
+  uint8_t li = level - 4;
+  if (pos + (uint32_t)nsat * msm_sat_bits[li] +
+          (uint32_t)ncell * msm_cell_bits[li] > bits) {
+    return false;
+  }
+
+  bool ext = (level == 5 || level == 7);
+  bool hi = (level >= 6);
+
+  memset(msm->sat, 0, sizeof(msm->sat));
+  for (uint8_t s = 0; s < nsat; s++, pos += 8) {
+    msm->sat[sats[s] - 1].rough_ms = getbitu(p, pos, 8);
+  }
+  for (uint8_t s = 0; s < nsat && ext; s++, pos += 4) {
+    msm->sat[sats[s] - 1].ext = getbitu(p, pos, 4);
+  }
+  for (uint8_t s = 0; s < nsat; s++, pos += 10) {
+    msm->sat[sats[s] - 1].rough_mod = getbitu(p, pos, 10);
+  }
+  for (uint8_t s = 0; s < nsat; s++) {
+    int32_t rate = RTCM_MSM_RATE_INVALID;
+    if (ext) {
+      rate = getbits(p, pos, 14);
+      pos += 14;
+      if (rate == -8192) {
+        rate = RTCM_MSM_RATE_INVALID;
+      }
+    }
+    msm->sat[sats[s] - 1].rate = rate;
+  }
+
+  for (uint8_t c = 0; c < ncell; c++) {
+    int32_t v = getbits(p, pos, hi ? 20 : 15);
+    pos += hi ? 20 : 15;
+    if (v == (hi ? -524288 : -16384)) {
+      msm->cell[c].pr = RTCM_MSM_PR_INVALID;
+    } else {
+      msm->cell[c].pr = hi ? v : v * 32;
+    }
+  }
+  for (uint8_t c = 0; c < ncell; c++) {
+    int32_t v = getbits(p, pos, hi ? 24 : 22);
+    pos += hi ? 24 : 22;
+    if (v == (hi ? -8388608 : -2097152)) {
+      msm->cell[c].cp = RTCM_MSM_CP_INVALID;
+    } else {
+      msm->cell[c].cp = hi ? v : v * 4;
+    }
+  }
+  for (uint8_t c = 0; c < ncell; c++) {
+    uint32_t v = getbitu(p, pos, hi ? 10 : 4);
+    pos += hi ? 10 : 4;
+    msm->cell[c].lock = hi ? lock_ext_to_ms(v) : lock4_to_ms(v);
+  }
+  for (uint8_t c = 0; c < ncell; c++, pos++) {
+    msm->cell[c].half = getbitu(p, pos, 1);
+  }
+  for (uint8_t c = 0; c < ncell; c++) {
+    uint32_t v = getbitu(p, pos, hi ? 10 : 6);
+    pos += hi ? 10 : 6;
+    msm->cell[c].cnr = hi ? v : v << 4;
+  }
+  for (uint8_t c = 0; c < ncell; c++) {
+    int32_t rate = RTCM_MSM_RATE_INVALID;
+    if (ext) {
+      rate = getbits(p, pos, 15);
+      pos += 15;
+      if (rate == -16384) {
+        rate = RTCM_MSM_RATE_INVALID;
+      }
+    }
+    msm->cell[c].rate = rate;
+  }
+
+  msm->ncell = ncell;
+  return true;
+}
+
+/**
+ * @brief 남은 셀 (sat != 0) 기준 위성/신호 마스크
+ */
+static uint8_t msm_masks(const rtcm_msm_t *msm, uint64_t *sat_mask,
+                         uint32_t *sig_mask) {
+  uint64_t sm = 0;
+  uint32_t gm = 0;
+  uint8_t n = 0;
+
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    sm |= 1ULL << (cell->sat - 1);
+    gm |= 1UL << (cell->sig - 1);
+    n++;
+  }
+  *sat_mask = sm;
+  *sig_mask = gm;
+  return n;
+}
+
+size_t rtcm_msm_size(const rtcm_msm_t *msm, uint8_t level) {
+  if (!msm || level < 4 || level > 7) {
+    return 0;
+  }
+
+  uint64_t sm;
+  uint32_t gm;
+  uint32_t ncell = msm_masks(msm, &sm, &gm);
+  uint32_t nsat = __builtin_popcountll(sm);
+  uint32_t nsig = __builtin_popcount(gm);
+  uint32_t bits = MSM_HDR_BITS + nsat * nsig + nsat * msm_sat_bits[level - 4] +
+                  ncell * msm_cell_bits[level - 4];
+
+  return (bits + 7) / 8 + MSM_FRAME_OVERHEAD;
+}
+
+size_t rtcm_msm_encode(const rtcm_msm_t *msm, uint8_t level, uint8_t *frame,
+                       size_t size) {
+  size_t total = rtcm_msm_size(msm, level);
+  if (total == 0 || !frame || size < total) {
+    return 0;
+  }
+
+  uint64_t sm;
+  uint32_t gm;
+  msm_masks(msm, &sm, &gm);
+
+  uint8_t sats[RTCM_MSM_SAT_MAX];
+  uint8_t sig_idx[33];
+  uint8_t nsat = 0, nsig = 0;
+  for (uint8_t i = 0; i < RTCM_MSM_SAT_MAX; i++) {
+    if (sm & (1ULL << i)) {
+      sats[nsat++] = i + 1;
+    }
+  }
+  for (uint8_t i = 0; i < 32; i++) {
+    if (gm & (1UL << i)) {
+      sig_idx[i + 1] = nsig++;
+    }
+  }
+
+  uint32_t plen = total - MSM_FRAME_OVERHEAD;
+  uint8_t *p = frame + 3;
+  memset(frame, 0, total);
+  frame[0] = 0xD3;
+  frame[1] = (plen >> 8) & 0x03;
+  frame[2] = plen & 0xFF;
+
+  setbitu(p, 0, 12, (msm->msg_type / 10) * 10 + level);
+  setbitu(p, 12, 12, msm->ref_id);
+  setbitu(p, 24, 30, msm->epoch);
+  setbitu(p, 54, 1, msm->multi);
+  setbitu(p, 55, 3, msm->iods);
+  setbitu(p, 58, 7, msm->reserved);
+  setbitu(p, 65, 2, msm->clk_steer);
+  setbitu(p, 67, 2, msm->ext_clk);
+  setbitu(p, 69, 1, msm->smooth);
+  setbitu(p, 70, 3, msm->smooth_int);
+
+  uint32_t pos = 73;
+  for (uint8_t i = 0; i < RTCM_MSM_SAT_MAX; i++, pos++) {
+    if (sm & (1ULL << i)) {
+      setbitu(p, pos, 1, 1);
+    }
+  }
+  for (uint8_t i = 0; i < 32; i++, pos++) {
+    if (gm & (1UL << i)) {
+      setbitu(p, pos, 1, 1);
+    }
+  }
+
+  // 셀은 위성, 신호 순서로 저장되어 있으므로 마스크 순서와 같다
+  uint32_t mask_pos = pos;
+  uint8_t si = 0;
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    while (sats[si] != cell->sat) {
+      si++;
+    }
+    setbitu(p, mask_pos + (uint32_t)si * nsig + sig_idx[cell->sig], 1, 1);
+  }
+  pos += (uint32_t)nsat * nsig;
+
+  bool ext = (level == 5 || level == 7);
+  bool hi = (level >= 6);
+
+  for (uint8_t s = 0; s < nsat; s++, pos += 8) {
+    setbitu(p, pos, 8, msm->sat[sats[s] - 1].rough_ms);
+  }
+  for (uint8_t s = 0; s < nsat && ext; s++, pos += 4) {
+    setbitu(p, pos, 4, msm->sat[sats[s] - 1].ext);
+  }
+  for (uint8_t s = 0; s < nsat; s++, pos += 10) {
+    setbitu(p, pos, 10, msm->sat[sats[s] - 1].rough_mod);
+  }
+  for (uint8_t s = 0; s < nsat && ext; s++, pos += 14) {
+    int32_t rate = msm->sat[sats[s] - 1].rate;
+    setbitu(p, pos, 14, rate == RTCM_MSM_RATE_INVALID ? -8192 : rate);
+  }
+
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    int32_t v;
+    if (hi) {
+      v = cell->pr == RTCM_MSM_PR_INVALID ? -524288 : cell->pr;
+      setbitu(p, pos, 20, v);
+      pos += 20;
+    } else {
+      v = cell->pr == RTCM_MSM_PR_INVALID ? -16384
+                                           : clamp32((cell->pr + 16) >> 5, 16383);
+      setbitu(p, pos, 15, v);
+      pos += 15;
+    }
+  }
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    int32_t v;
+    if (hi) {
+      v = cell->cp == RTCM_MSM_CP_INVALID ? -8388608 : cell->cp;
+      setbitu(p, pos, 24, v);
+      pos += 24;
+    } else {
+      v = cell->cp == RTCM_MSM_CP_INVALID ? -2097152
+                                           : clamp32((cell->cp + 2) >> 2, 2097151);
+      setbitu(p, pos, 22, v);
+      pos += 22;
+    }
+  }
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    if (hi) {
+      setbitu(p, pos, 10, lock_ms_to_ext(cell->lock));
+      pos += 10;
+    } else {
+      setbitu(p, pos, 4, lock_ms_to_4(cell->lock));
+      pos += 4;
+    }
+  }
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    if (msm->cell[c].sat != 0) {
+      setbitu(p, pos++, 1, msm->cell[c].half);
+    }
+  }
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    if (hi) {
+      setbitu(p, pos, 10, cell->cnr > 1023 ? 1023 : cell->cnr);
+      pos += 10;
+    } else {
+      uint32_t v = (cell->cnr + 8) >> 4;
+      setbitu(p, pos, 6, v > 63 ? 63 : v);
+      pos += 6;
+    }
+  }
+  for (uint8_t c = 0; c < msm->ncell && ext; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat == 0) {
+      continue;
+    }
+    setbitu(p, pos, 15,
+            cell->rate == RTCM_MSM_RATE_INVALID ? -16384 : cell->rate);
+    pos += 15;
+  }
+
+  uint32_t crc = gps_crc24q(frame, plen + 3);
+  frame[plen + 3] = (crc >> 16) & 0xFF;
+  frame[plen + 4] = (crc >> 8) & 0xFF;
+  frame[plen + 5] = crc & 0xFF;
+
+  return total;
+}
+
+/**
+ * @brief 같은 위성, 같은 대역에 CNR 이 더 높은 셀이 있는 셀 중 CNR 최저
+ *
+ * @return 셀 인덱스, 없으면 -1
+ */
+static int msm_find_redundant(const rtcm_msm_t *msm, uint8_t sys) {
+  int victim = -1;
+
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *a = &msm->cell[c];
+    if (a->sat == 0 || (victim >= 0 && a->cnr >= msm->cell[victim].cnr)) {
+      continue;
+    }
+    uint8_t band = msm_band(sys, a->sig);
+    for (uint8_t o = 0; o < msm->ncell; o++) {
+      const rtcm_msm_cell_t *b = &msm->cell[o];
+      if (o == c || b->sat != a->sat || msm_band(sys, b->sig) != band) {
+        continue;
+      }
+      if (b->cnr > a->cnr || (b->cnr == a->cnr && o < c)) {
+        victim = c;
+        break;
+      }
+    }
+  }
+  return victim;
+}
+
+/**
+ * @brief 가장 좋은 셀의 CNR 이 최저인 위성
+ *
+ * 기지국은 궤도력이 없어 고도각을 모르므로 CNR 을 고도각 대용으로 쓴다.
+ */
+static uint8_t msm_find_weak_sat(const rtcm_msm_t *msm) {
+  uint16_t best[RTCM_MSM_SAT_MAX + 1] = {0};
+  uint8_t victim = 0;
+
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    const rtcm_msm_cell_t *cell = &msm->cell[c];
+    if (cell->sat != 0 && cell->cnr + 1 > best[cell->sat]) {
+      best[cell->sat] = cell->cnr + 1;
+    }
+  }
+  for (uint8_t s = 1; s <= RTCM_MSM_SAT_MAX; s++) {
+    if (best[s] && (victim == 0 || best[s] < best[victim])) {
+      victim = s;
+    }
+  }
+  return victim;
+}
+
+size_t rtcm_msm_trim(rtcm_msm_t *msm, size_t max_len, bool to_msm4) {
+  size_t size = rtcm_msm_size(msm, msm->level);
+  if (size <= max_len) {
+    return size;
+  }
+
+  if (to_msm4 && msm->level > 4) {
+    msm->level = 4;
+    size = rtcm_msm_size(msm, msm->level);
+  }
+
+  uint8_t sys = msm_sys(msm->msg_type);
+  while (size > max_len) {
+    int c = msm_find_redundant(msm, sys);
+    if (c < 0) {
+      break;
+    }
+    msm->cell[c].sat = 0;
+    size = rtcm_msm_size(msm, msm->level);
+  }
+
+  while (size > max_len) {
+    uint64_t sm;
+    uint32_t gm;
+    msm_masks(msm, &sm, &gm);
+    if (__builtin_popcountll(sm) <= RTCM_MSM_MIN_SAT) {
+      break;
+    }
+    uint8_t sat = msm_find_weak_sat(msm);
+    for (uint8_t c = 0; c < msm->ncell; c++) {
+      if (msm->cell[c].sat == sat) {
+        msm->cell[c].sat = 0;
+      }
+    }
+    size = rtcm_msm_size(msm, msm->level);
+  }
+
+  // 지운 셀 정리
+  uint8_t n = 0;
+  for (uint8_t c = 0; c < msm->ncell; c++) {
+    if (msm->cell[c].sat != 0) {
+      msm->cell[n++] = msm->cell[c];
+    }
+  }
+  msm->ncell = n;
+
+  return size;
+}
+
+/**
+ * @brief 최소 위성 수까지 줄였을 때의 크기 추정
+ *
+ * 남는 위성이 모든 신호를 가진다고 보므로 실제 trim 결과보다 작지 않다.
+ */
+static size_t msm_floor_size(const rtcm_msm_t *msm, bool to_msm4) {
+  uint64_t sm;
+  uint32_t gm;
+  uint32_t ncell = msm_masks(msm, &sm, &gm);
+  uint32_t nsat = __builtin_popcountll(sm);
+  uint32_t nsig = __builtin_popcount(gm);
+  uint8_t level = to_msm4 ? 4 : msm->level;
+
+  if (nsat > RTCM_MSM_MIN_SAT) {
+    nsat = RTCM_MSM_MIN_SAT;
+    if (ncell > nsat * nsig) {
+      ncell = nsat * nsig;
+    }
+  }
+  uint32_t bits = MSM_HDR_BITS + nsat * nsig + nsat * msm_sat_bits[level - 4] +
+                  ncell * msm_cell_bits[level - 4];
+
+  return (bits + 7) / 8 + MSM_FRAME_OVERHEAD;
+}
+
+void rtcm_msm_fit_init(rtcm_msm_fit_t *fit, uint16_t budget, bool to_msm4,
+                       uint8_t prio) {
+  memset(fit, 0, sizeof(*fit));
+  fit->budget = budget;
+  fit->to_msm4 = to_msm4;
+  fit->prio = prio;
+}
+
+rtcm_msm_fit_result_t rtcm_msm_fit(rtcm_msm_fit_t *fit, const uint8_t *frame,
+                                   size_t len, uint8_t *out, size_t out_size,
+                                   size_t *out_len) {
+  *out_len = len;
+  if (!fit || fit->budget == 0 || !frame || len < MSM_FRAME_OVERHEAD + 7) {
+    return RTCM_MSM_FIT_PASS;
+  }
+
+  uint16_t type = ((uint16_t)frame[3] << 4) | (frame[4] >> 4);
+  if (!rtcm_msm_is_msm(type) || msm_level(type) < 4 ||
+      msm_sys(type) >= RTCM_MSM_SYS_CNT) {
+    return RTCM_MSM_FIT_PASS;
+  }
+
+  uint8_t sys = msm_sys(type);
+  uint8_t bit = 1u << sys;
+  bool prio = fit->prio & bit;
+  if (fit->seen & bit) {
+    fit->cnt_last = fit->cnt;
+    fit->seen_last = fit->seen;
+    fit->cnt = 0;
+    fit->used = 0;
+    fit->seen = 0;
+  }
+  fit->seen |= bit;
+  fit->cnt++;
+
+  uint32_t left = fit->budget > fit->used ? fit->budget - fit->used : 0;
+  uint32_t cap = left;
+  uint32_t allow = left;
+  bool multi = (frame[9] >> 1) & 0x01; // DF393, payload bit 54
+  if (multi) {
+    // 마지막 메시지가 epoch 를 닫을 수 있도록 빈 MSM 자리와 아직 오지 않은
+    // 우선 시스템의 floor 를 남기고, 나머지를 이 메시지와 남은 메시지 수로
+    // 나눈다 (적어도 하나는 더 온다)
+    uint32_t reserve = MSM_EMPTY_SIZE;
+    uint8_t wait = fit->prio & fit->seen_last & ~fit->seen;
+    for (uint8_t s = 0; s < RTCM_MSM_SYS_CNT; s++) {
+      if (wait & (1u << s)) {
+        reserve += fit->floor[s] ? fit->floor[s] : RTCM_MSM_FLOOR_GUESS;
+      }
+    }
+    uint32_t expect = fit->cnt_last ? fit->cnt_last : RTCM_MSM_EPOCH_MSG_GUESS;
+    uint32_t share = expect > fit->cnt ? expect - fit->cnt + 1 : 2;
+    cap = left > reserve ? left - reserve : 0;
+    allow = cap / share;
+    if (prio) {
+      // 우선 시스템은 몫이 작아도 최소 위성 수 MSM4 까지는 받는다
+      uint32_t floor = fit->floor[sys] ? fit->floor[sys] : RTCM_MSM_FLOOR_GUESS;
+      cap = left > MSM_EMPTY_SIZE ? left - MSM_EMPTY_SIZE : 0;
+      if (allow < floor) {
+        allow = floor < cap ? floor : cap;
+      }
+    }
+  }
+
+  if (len <= allow) {
+    if (prio && (fit->floor[sys] == 0 || len < fit->floor[sys])) {
+      fit->floor[sys] = len;
+    }
+    fit->used += len;
+    return RTCM_MSM_FIT_PASS;
+  }
+
+  if (!rtcm_msm_decode(frame, len, &fit->msm)) {
+    // 줄일 수 없는 프레임은 남은 예산 안이면 그대로, 아니면 버린다
+    if (len <= cap) {
+      fit->used += len;
+      return RTCM_MSM_FIT_PASS;
+    }
+    fit->dropped++;
+    fit->prio_dropped += prio;
+    return RTCM_MSM_FIT_DROP;
+  }
+
+  if (prio) {
+    fit->floor[sys] = msm_floor_size(&fit->msm, fit->to_msm4);
+    if (multi && allow < fit->floor[sys] && fit->floor[sys] <= cap) {
+      allow = fit->floor[sys];
+    }
+  }
+
+  uint8_t before = fit->msm.ncell;
+  size_t n = rtcm_msm_trim(&fit->msm, allow, fit->to_msm4);
+  if (n > allow && !(prio && n <= cap)) {
+    // 최소 위성 수까지 줄여도 몫을 넘으면 메시지를 버린다 (뒤 메시지의 몫을
+    // 빼앗지 않도록). 우선 시스템은 빈 MSM 자리만 남으면 보낸다. epoch 의
+    // 마지막 메시지는 위성 없이 헤더만 보내 epoch 끝 (multiple message bit 0)
+    // 을 알린다
+    if (multi || left < MSM_EMPTY_SIZE) {
+      fit->dropped++;
+      fit->prio_dropped += prio;
+      return RTCM_MSM_FIT_DROP;
+    }
+    fit->msm.ncell = 0;
+  }
+
+  n = rtcm_msm_encode(&fit->msm, fit->msm.level, out, out_size);
+  if (n == 0) {
+    fit->dropped++;
+    fit->prio_dropped += prio;
+    return RTCM_MSM_FIT_DROP;
+  }
+
+  fit->trimmed++;
+  fit->cells_dropped += before - fit->msm.ncell;
+  fit->used += n;
+  *out_len = n;
+  return RTCM_MSM_FIT_TRIMMED;
+}
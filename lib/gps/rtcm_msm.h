@@ -0,0 +1,122 @@
+#ifndef RTCM_MSM_H
+#define RTCM_MSM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * RTCM3 MSM4~7 디코더/인코더와 epoch 예산 맞춤
+ *
+ * 값은 레벨과 무관하게 MSM7 해상도로 보관하므로 같은 레벨로 다시 인코딩하면
+ * 원본과 같은 프레임이 되고, MSM4 로 내리면 해상도만 줄어든다.
+ */
+#define RTCM_MSM_SAT_MAX 64
+#define RTCM_MSM_CELL_MAX 64
+
+#define RTCM_MSM_MIN_SAT 4 ///< 위성을 빼서 줄일 때 남기는 최소 위성 수
+#define RTCM_MSM_EPOCH_MSG_GUESS 3 ///< 지난 epoch 메시지 수를 모를 때 가정하는 수
+#define RTCM_MSM_FLOOR_GUESS 110 ///< 우선 시스템 최소 크기를 모를 때 (위성 4, 신호 3 MSM4)
+
+#define RTCM_MSM_SYS_CNT 7 ///< GPS, GLO, GAL, SBAS, QZS, BDS, NavIC
+/* 우선 시스템 bit (rtcm_msm_fit_init 의 prio) */
+#define RTCM_MSM_SYS_GPS (1u << 0)
+#define RTCM_MSM_SYS_GLO (1u << 1)
+#define RTCM_MSM_SYS_GAL (1u << 2)
+#define RTCM_MSM_SYS_SBAS (1u << 3)
+#define RTCM_MSM_SYS_QZS (1u << 4)
+#define RTCM_MSM_SYS_BDS (1u << 5)
+#define RTCM_MSM_SYS_NAVIC (1u << 6)
+
+#define RTCM_MSM_PR_INVALID INT32_MIN
+#define RTCM_MSM_CP_INVALID INT32_MIN
+#define RTCM_MSM_RATE_INVALID INT16_MIN
+#define RTCM_MSM_ROUGH_INVALID 0xFF
+
+typedef struct {
+  uint8_t rough_ms;   ///< DF397 rough range 정수 [ms] (RTCM_MSM_ROUGH_INVALID)
+  uint8_t ext;        ///< 확장 위성 정보 (MSM5/7, GLONASS 주파수 채널)
+  uint16_t rough_mod; ///< DF398 rough range 1ms 미만 [2^-10 ms]
+  int16_t rate;       ///< DF399 rough phaserange rate [m/s] (MSM5/7)
+} rtcm_msm_sat_t;
+
+typedef struct {
+  uint8_t sat;   ///< 위성 번호 1~64
+  uint8_t sig;   ///< 신호 번호 1~32
+  uint8_t half;  ///< DF420 half-cycle ambiguity
+  uint16_t cnr;  ///< [2^-4 dB-Hz] (0: 없음)
+  int16_t rate;  ///< DF404 fine phaserange rate [0.0001 m/s] (MSM5/7)
+  int32_t pr;    ///< fine pseudorange [2^-29 ms]
+  int32_t cp;    ///< fine phaserange [2^-31 ms]
+  uint32_t lock; ///< 최소 lock 시간 [ms]
+} rtcm_msm_cell_t;
+
+typedef struct {
+  uint16_t msg_type;
+  uint8_t level;      ///< MSM 레벨 4~7
+  uint8_t multi;      ///< multiple message bit (같은 epoch 메시지가 더 있음)
+  uint16_t ref_id;
+  uint32_t epoch;     ///< 시스템별 epoch time (30 bit)
+  uint8_t iods;
+  uint8_t reserved;
+  uint8_t clk_steer;
+  uint8_t ext_clk;
+  uint8_t smooth;
+  uint8_t smooth_int;
+  uint8_t ncell;
+  rtcm_msm_sat_t sat[RTCM_MSM_SAT_MAX]; ///< 위성 번호 - 1 로 접근
+  rtcm_msm_cell_t cell[RTCM_MSM_CELL_MAX]; ///< 위성, 신호 순서
+} rtcm_msm_t;
+
+/**
+ * @brief epoch 예산 맞춤 상태
+ *
+ * 같은 시스템의 MSM 이 다시 오면 새 epoch 로 본다. 남은 예산은 지난 epoch 의
+ * 메시지 수 기준으로 남은 메시지에 고르게 나누고, multiple message bit 가 없는
+ * 마지막 메시지는 남은 예산을 모두 쓴다.
+ *
+ * 예산은 넘지 않는다. 최소 위성 수까지 줄여도 넘치는 메시지는 버리고, 마지막
+ * 메시지는 epoch 가 닫히도록 위성 없는 헤더만 보낸다 (이를 위해 앞 메시지들은
+ * 빈 MSM 크기를 남겨 둔다).
+ *
+ * 우선 시스템 (prio) 은 몫이 작아도 최소 위성 수 MSM4 크기 (floor) 까지는 받는다.
+ * 지난 epoch 에 있었던 우선 시스템이 아직 오지 않았으면 다른 시스템은 그 floor 를
+ * 빼고 몫을 나누므로, 예산이 모자랄 때 먼저 버려지는 쪽은 우선 시스템이 아니다.
+ */
+typedef struct {
+  uint16_t budget;  ///< epoch 당 최대 바이트 (0: 제한 없음)
+  bool to_msm4;     ///< 예산 초과 시 MSM5~7 을 MSM4 로 내림
+  uint32_t used;    ///< 이번 epoch 에 내보낸 바이트
+  uint8_t prio;     ///< 우선 시스템 (RTCM_MSM_SYS_* bit)
+  uint8_t seen;     ///< 이번 epoch 에 받은 시스템 (bit)
+  uint8_t seen_last; ///< 지난 epoch 에 받은 시스템 (bit)
+  uint8_t cnt;      ///< 이번 epoch 메시지 수
+  uint8_t cnt_last; ///< 지난 epoch 메시지 수
+  uint32_t trimmed; ///< 줄인 메시지 수
+  uint32_t cells_dropped;
+  uint32_t dropped; ///< 예산에 못 맞춰 버린 메시지 수
+  uint32_t prio_dropped; ///< 그 중 우선 시스템 메시지 수
+  uint16_t floor[RTCM_MSM_SYS_CNT]; ///< 시스템별 최소 크기 추정 (0: 모름)
+  rtcm_msm_t msm;   ///< 작업 버퍼
+} rtcm_msm_fit_t;
+
+typedef enum {
+  RTCM_MSM_FIT_PASS,    ///< 원본 그대로 보냄
+  RTCM_MSM_FIT_TRIMMED, ///< out 에 줄인 프레임
+  RTCM_MSM_FIT_DROP,    ///< 보내지 않음
+} rtcm_msm_fit_result_t;
+
+bool rtcm_msm_is_msm(uint16_t msg_type);
+bool rtcm_msm_decode(const uint8_t *frame, size_t len, rtcm_msm_t *msm);
+size_t rtcm_msm_size(const rtcm_msm_t *msm, uint8_t level);
+size_t rtcm_msm_encode(const rtcm_msm_t *msm, uint8_t level, uint8_t *frame,
+                       size_t size);
+size_t rtcm_msm_trim(rtcm_msm_t *msm, size_t max_len, bool to_msm4);
+void rtcm_msm_fit_init(rtcm_msm_fit_t *fit, uint16_t budget, bool to_msm4,
+                       uint8_t prio);
+// out_len: 보낼 길이 (PASS: len, TRIMMED: out 에 쓴 길이)
+rtcm_msm_fit_result_t rtcm_msm_fit(rtcm_msm_fit_t *fit, const uint8_t *frame,
+                                   size_t len, uint8_t *out, size_t out_size,
+                                   size_t *out_len);
+
+#endif
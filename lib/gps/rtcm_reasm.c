@@ -0,0 +1,141 @@
+#include "rtcm_reasm.h"
+#include "gps_crc.h"
+#include <string.h>
+
+#define RING_MASK (RTCM_REASM_RING_SIZE - 1)
+
+_Static_assert((RTCM_REASM_RING_SIZE & RING_MASK) == 0, "ring size must be a power of 2");
+_Static_assert(RTCM_REASM_RING_SIZE > RTCM_REASM_FRAME_MAX, "ring must hold a full frame");
+
+void rtcm_reasm_init(rtcm_reasm_t *reasm, uint32_t timeout_ms) {
+  memset(reasm, 0, sizeof(*reasm));
+  reasm->timeout_ms = timeout_ms;
+}
+
+static inline uint8_t ring_at(const rtcm_reasm_t *reasm, uint32_t off) {
+  return reasm->ring[(reasm->tail + off) & RING_MASK];
+}
+
+/**
+ * @brief tail 부터 len byte 의 CRC24Q (링 끝에서 나뉘면 두 조각 누적)
+ */
+static uint32_t ring_crc(const rtcm_reasm_t *reasm, size_t len) {
+  uint32_t start = reasm->tail & RING_MASK;
+  size_t first = RTCM_REASM_RING_SIZE - start;
+
+  if (first >= len) {
+    return gps_crc24q(&reasm->ring[start], len);
+  }
+  return gps_crc24q_update(gps_crc24q(&reasm->ring[start], first), reasm->ring,
+                           len - first);
+}
+
+static void ring_copy(const rtcm_reasm_t *reasm, uint8_t *out, size_t len) {
+  uint32_t start = reasm->tail & RING_MASK;
+  size_t first = RTCM_REASM_RING_SIZE - start;
+
+  if (first >= len) {
+    memcpy(out, &reasm->ring[start], len);
+  } else {
+    memcpy(out, &reasm->ring[start], first);
+    memcpy(&out[first], reasm->ring, len - first);
+  }
+}
+
+/**
+ * @brief tail 의 후보를 버리고 다음 0xD3 찾기 시작
+ */
+static void reasm_skip(rtcm_reasm_t *reasm, uint32_t n) {
+  if (!reasm->syncing) {
+    reasm->syncing = true;
+    reasm->stats.resyncs++;
+  }
+  reasm->tail += n;
+  reasm->stats.skipped += n;
+}
+
+void rtcm_reasm_push(rtcm_reasm_t *reasm, const uint8_t *data, size_t len,
+                     uint32_t now_ms) {
+  if (reasm->timeout_ms && rtcm_reasm_pending(reasm) &&
+      now_ms - reasm->last_ms > reasm->timeout_ms) {
+    // 오래된 미완성 프레임은 새 데이터와 이어지지 않음
+    reasm->stats.partial_drops++;
+    reasm->tail = reasm->head;
+    reasm->syncing = false;
+  }
+  reasm->last_ms = now_ms;
+
+  if (len > RTCM_REASM_RING_SIZE) {
+    data += len - RTCM_REASM_RING_SIZE;
+    len = RTCM_REASM_RING_SIZE;
+  }
+
+  size_t room = RTCM_REASM_RING_SIZE - rtcm_reasm_pending(reasm);
+  if (len > room) {
+    reasm->stats.partial_drops++;
+    reasm_skip(reasm, len - room);
+  }
+
+  uint32_t start = reasm->head & RING_MASK;
+  size_t first = RTCM_REASM_RING_SIZE - start;
+  if (first >= len) {
+    memcpy(&reasm->ring[start], data, len);
+  } else {
+    memcpy(&reasm->ring[start], data, first);
+    memcpy(reasm->ring, &data[first], len - first);
+  }
+  reasm->head += len;
+}
+
+size_t rtcm_reasm_pop(rtcm_reasm_t *reasm, const uint8_t **frame) {
+  while (1) {
+    size_t avail = rtcm_reasm_pending(reasm);
+
+    // 다음 preamble 까지 건너뜀
+    uint32_t skip = 0;
+    while (skip < avail && ring_at(reasm, skip) != 0xD3) {
+      skip++;
+    }
+    if (skip) {
+      reasm_skip(reasm, skip);
+      avail -= skip;
+    }
+
+    if (avail < 3) {
+      return 0;
+    }
+
+    // reserved 6 bit 가 0 이 아니면 payload 속 0xD3
+    uint8_t b1 = ring_at(reasm, 1);
+    if (b1 & 0xFC) {
+      reasm_skip(reasm, 1);
+      continue;
+    }
+
+    size_t frame_len = ((size_t)(b1 & 0x03) << 8 | ring_at(reasm, 2)) + 6;
+    if (avail < frame_len) {
+      return 0;
+    }
+
+    uint32_t crc = (uint32_t)ring_at(reasm, frame_len - 3) << 16 |
+                   (uint32_t)ring_at(reasm, frame_len - 2) << 8 |
+                   ring_at(reasm, frame_len - 1);
+    if (ring_crc(reasm, frame_len - 3) != crc) {
+      reasm->stats.crc_fail++;
+      reasm_skip(reasm, 1);
+      continue;
+    }
+
+    uint32_t start = reasm->tail & RING_MASK;
+    if (start + frame_len <= RTCM_REASM_RING_SIZE) {
+      *frame = &reasm->ring[start];
+    } else {
+      ring_copy(reasm, reasm->linear, frame_len);
+      *frame = reasm->linear;
+    }
+    reasm->tail += frame_len;
+    reasm->syncing = false;
+    reasm->stats.frames++;
+    return frame_len;
+  }
+}
@@ -0,0 +1,67 @@
+#ifndef RTCM_REASM_H
+#define RTCM_REASM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * RTCM3 스트림 재조립 (링 버퍼)
+ *
+ * LoRa fragment 처럼 프레임 경계와 무관하게 잘린 바이트를 넣으면, 쌓인 바이트에서 완성된
+ * 프레임을 모두 꺼낼 수 있다. 0xD3 preamble + reserved 6 bit 가 0 인 헤더의 길이를 믿고
+ * 프레임 끝까지 모이면 CRC24Q 로 확인한다. CRC 가 틀리면 그 0xD3 만 버리고 다음 0xD3 에서
+ * 다시 맞춘다. 바이트는 링 안에서만 움직이며 앞으로 당기는 memmove 는 없다.
+ * 완성된 프레임은 링 안을 그대로 가리키고, 링 끝에서 나뉜 프레임만 linear[] 에 이어 붙인다.
+ */
+#define RTCM_REASM_RING_SIZE 2048 ///< 2의 거듭제곱, RTCM 최대 프레임 (1029) 보다 커야 함
+#define RTCM_REASM_FRAME_MAX 1029 ///< header 3 + payload 1023 + CRC 3
+
+typedef struct {
+  uint32_t frames;        ///< CRC 가 맞은 프레임
+  uint32_t resyncs;       ///< 프레임 경계를 잃고 다음 0xD3 을 찾은 횟수
+  uint32_t skipped;       ///< resync 로 버린 바이트
+  uint32_t crc_fail;      ///< 길이만큼 모였지만 CRC 가 틀린 후보
+  uint32_t partial_drops; ///< 타임아웃/넘침으로 버린 미완성 데이터
+} rtcm_reasm_stats_t;
+
+typedef struct {
+  uint8_t ring[RTCM_REASM_RING_SIZE];
+  uint32_t head;       ///< 쓰기 위치 (계속 증가, 링 인덱스는 & mask)
+  uint32_t tail;       ///< 읽기 위치
+  uint32_t last_ms;    ///< 마지막 push 시각
+  uint32_t timeout_ms; ///< 이 시간 동안 push 가 없으면 남은 데이터를 버림 (0: 없음)
+  bool syncing;        ///< 0xD3 을 찾는 중 (resync 한 번으로 셈)
+  rtcm_reasm_stats_t stats;
+  uint8_t linear[RTCM_REASM_FRAME_MAX]; ///< 링 끝에서 나뉜 프레임을 이어 붙일 곳
+} rtcm_reasm_t;
+
+void rtcm_reasm_init(rtcm_reasm_t *reasm, uint32_t timeout_ms);
+
+/**
+ * @brief fragment 추가
+ *
+ * 링이 넘치면 가장 오래된 바이트를 버리고 (partial_drops) 다음 0xD3 에서 다시 맞춘다.
+ */
+void rtcm_reasm_push(rtcm_reasm_t *reasm, const uint8_t *data, size_t len,
+                     uint32_t now_ms);
+
+/**
+ * @brief 완성된 프레임 하나 꺼내기
+ *
+ * fragment 를 넣은 뒤 0 이 나올 때까지 부른다. *frame 은 링 (또는 linear[]) 을
+ * 가리키므로 다음 rtcm_reasm_push() / rtcm_reasm_pop() 전까지만 유효하다.
+ *
+ * @param[out] frame 프레임 시작
+ * @return 프레임 길이, 완성된 프레임이 없으면 0
+ */
+size_t rtcm_reasm_pop(rtcm_reasm_t *reasm, const uint8_t **frame);
+
+/**
+ * @brief 링에 남은 (아직 프레임이 되지 않은) 바이트
+ */
+static inline size_t rtcm_reasm_pending(const rtcm_reasm_t *reasm) {
+  return reasm->head - reasm->tail;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "rtcm_sched.h"
+#include "rtcm_msm.h"
+#include <string.h>
+
+static int station_index(uint16_t msg_type) {
+  switch (msg_type) {
+  case 1005:
+    return 0;
+  case 1006:
+    return 1;
+  case 1033:
+    return 2;
+  default:
+    return -1;
+  }
+}
+
+void rtcm_sched_init(rtcm_sched_t *sched, const rtcm_sched_cfg_t *cfg) {
+  memset(sched, 0, sizeof(*sched));
+  sched->cfg = cfg;
+  sched->station_ms = cfg->station_ms;
+}
+
+bool rtcm_sched_update_link(rtcm_sched_t *sched, uint32_t now_ms, uint8_t depth,
+                            uint32_t busy_ms) {
+  const rtcm_sched_cfg_t *cfg = sched->cfg;
+  bool was = sched->congested;
+
+  sched->depth = depth;
+
+  if (!sched->win_valid) {
+    sched->win_start = now_ms;
+    sched->win_busy = busy_ms;
+    sched->win_valid = true;
+  } else if (now_ms - sched->win_start >= RTCM_SCHED_WINDOW_MS) {
+    uint32_t elapsed = now_ms - sched->win_start;
+    uint32_t busy = busy_ms - sched->win_busy;
+    uint32_t load = busy * 100 / elapsed;
+
+    sched->load = load > 100 ? 100 : load;
+    sched->win_start = now_ms;
+    sched->win_busy = busy_ms;
+
+    // 스테이션 메시지 간격은 구간마다 두 배로 늘리거나 절반으로 되돌린다
+    if (sched->congested) {
+      sched->station_ms *= 2;
+      if (sched->station_ms > cfg->station_max_ms) {
+        sched->station_ms = cfg->station_max_ms;
+      }
+    } else if (sched->station_ms > cfg->station_ms) {
+      sched->station_ms /= 2;
+      if (sched->station_ms < cfg->station_ms) {
+        sched->station_ms = cfg->station_ms;
+      }
+    }
+  }
+
+  if (!sched->congested) {
+    if (depth >= cfg->depth_high || sched->load >= cfg->load_high) {
+      sched->congested = true;
+    }
+  } else if (depth <= cfg->depth_low && sched->load <= cfg->load_low) {
+    sched->congested = false;
+  }
+
+  return was != sched->congested;
+}
+
+bool rtcm_sched_accept(rtcm_sched_t *sched, uint16_t msg_type,
+                       const uint8_t *frame, size_t len, uint32_t now_ms) {
+  const rtcm_sched_cfg_t *cfg = sched->cfg;
+
+  if (rtcm_msm_is_msm(msg_type)) {
+    uint8_t sys = (msg_type - 1071) / 10;
+    if (sys >= RTCM_SCHED_SYS_CNT) {
+      sched->sent++;
+      return true;
+    }
+
+    uint8_t bit = 1u << sys;
+    if (sched->seen & bit) {
+      sched->epoch++;
+      sched->seen = 0;
+    }
+    sched->seen |= bit;
+
+    if (sched->congested) {
+      uint8_t period = cfg->period[sys];
+      if (period == 0 || sched->epoch % period != cfg->phase[sys] % period) {
+        sched->skipped_msm[sys]++;
+        return false;
+      }
+    }
+    sched->sent++;
+    return true;
+  }
+
+  int idx = station_index(msg_type);
+  if (idx >= 0) {
+    uint32_t hash = 0;
+    if (len >= 6) {
+      hash = ((uint32_t)frame[len - 3] << 16) |
+             ((uint32_t)frame[len - 2] << 8) | frame[len - 1];
+    }
+
+    // 수신기 출력 주기의 흔들림으로 한 번씩 빠지지 않도록 1/8 여유
+    uint32_t gap = sched->station_ms - sched->station_ms / 8;
+    if (sched->station_sent[idx] && hash == sched->station_hash[idx] &&
+        now_ms - sched->station_last[idx] < gap) {
+      sched->skipped_station++;
+      return false;
+    }
+    sched->station_sent[idx] = true;
+    sched->station_last[idx] = now_ms;
+    sched->station_hash[idx] = hash;
+  }
+
+  sched->sent++;
+  return true;
+}
@@ -0,0 +1,77 @@
+#ifndef RTCM_SCHED_H
+#define RTCM_SCHED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * 기지국 RTCM 전송 스케줄러
+ *
+ * LoRa 가 혼잡하면 MSM 을 시스템별 주기로 돌아가며 보내고 (예: GPS 매 epoch,
+ * Galileo/BDS 격 epoch, GLONASS 3 epoch 마다), 스테이션 메시지 (1005/1006/1033)
+ * 간격을 늘린다. 혼잡 판단은 전송 대기열 깊이 (RTCM epoch 묶음에 남은 메시지 수)
+ * 와 LoRa TX 점유율로 하고, 여유가 생기면 다시 모든 메시지를 보낸다.
+ * 그 밖의 메시지는 항상 통과시킨다.
+ * 스테이션 메시지는 내용 (CRC24Q) 이 바뀌면 간격과 무관하게 바로 보낸다.
+ */
+#define RTCM_SCHED_SYS_CNT 7     ///< GPS, GLO, GAL, SBAS, QZS, BDS, NavIC
+#define RTCM_SCHED_WINDOW_MS 5000 ///< 점유율 측정 구간
+
+typedef struct {
+  uint8_t period[RTCM_SCHED_SYS_CNT]; ///< 혼잡 시 MSM 전송 주기 [epoch] (0: 보내지 않음)
+  uint8_t phase[RTCM_SCHED_SYS_CNT];  ///< 주기 안에서 보내는 epoch 위치
+  uint32_t station_ms;      ///< 스테이션 메시지 최소 간격 (여유 시)
+  uint32_t station_max_ms;  ///< 혼잡이 이어질 때 늘리는 최대 간격
+  uint8_t depth_high;       ///< 대기 메시지가 이 수 이상이면 혼잡
+  uint8_t depth_low;        ///< 이 수 이하이고
+  uint8_t load_high;        ///< 점유율 [%] 이 이 값 이상이면 혼잡
+  uint8_t load_low;         ///< 이 값 이하이면 해제
+} rtcm_sched_cfg_t;
+
+typedef struct {
+  const rtcm_sched_cfg_t *cfg;
+
+  bool congested;
+  uint8_t seen;       ///< 이번 epoch 에 받은 MSM 시스템 (bit)
+  uint32_t epoch;     ///< epoch 번호 (MSM 시스템이 다시 오면 증가)
+
+  uint32_t station_ms;      ///< 현재 스테이션 메시지 간격
+  uint32_t station_last[3]; ///< 1005, 1006, 1033 마지막 전송 시각 [ms]
+  uint32_t station_hash[3];  ///< 마지막으로 보낸 프레임의 CRC24Q
+  bool station_sent[3];
+
+  uint8_t depth;        ///< 마지막 대기 메시지 수
+  uint8_t load;         ///< 마지막 구간 TX 점유율 [%]
+  uint32_t win_start;   ///< 점유율 구간 시작 [ms]
+  uint32_t win_busy;    ///< 구간 시작 시 누적 TX 시간 [ms]
+  bool win_valid;
+
+  uint32_t sent;
+  uint32_t skipped_msm[RTCM_SCHED_SYS_CNT];
+  uint32_t skipped_station;
+} rtcm_sched_t;
+
+void rtcm_sched_init(rtcm_sched_t *sched, const rtcm_sched_cfg_t *cfg);
+
+/**
+ * @brief LoRa TX 상태 반영
+ *
+ * @param now_ms 현재 시각 [ms]
+ * @param depth 전송 대기 메시지 수 (rtcm_tx_stats_t.pending)
+ * @param busy_ms TX 누적 점유 시간 [ms]
+ * @return 혼잡 상태가 바뀌었으면 true
+ */
+bool rtcm_sched_update_link(rtcm_sched_t *sched, uint32_t now_ms, uint8_t depth,
+                            uint32_t busy_ms);
+
+/**
+ * @brief 메시지를 이번에 보낼지 결정
+ *
+ * @param frame RTCM 프레임 (스테이션 메시지 내용 비교용)
+ * @return true: 전송, false: 건너뜀
+ */
+bool rtcm_sched_accept(rtcm_sched_t *sched, uint16_t msg_type,
+                       const uint8_t *frame, size_t len, uint32_t now_ms);
+
+#endif
@@ -0,0 +1,94 @@
+#include "rtcm_station.h"
+#include "rtcm_msm.h"
+#include <string.h>
+
+static int station_index(uint16_t msg_type) {
+  switch (msg_type) {
+  case 1005:
+    return 0;
+  case 1006:
+    return 1;
+  case 1033:
+    return 2;
+  default:
+    return -1;
+  }
+}
+
+void rtcm_station_cache_init(rtcm_station_cache_t *cache, uint32_t interval_ms,
+                             uint32_t max_age_ms) {
+  memset(cache, 0, sizeof(*cache));
+  cache->interval_ms = interval_ms;
+  cache->max_age_ms = max_age_ms;
+}
+
+static void cache_flush(rtcm_station_cache_t *cache) {
+  for (uint8_t i = 0; i < RTCM_STATION_MSG_CNT; i++) {
+    cache->entry[i].len = 0;
+  }
+  cache->has_id = false;
+  cache->flushed++;
+}
+
+bool rtcm_station_cache_put(rtcm_station_cache_t *cache, const uint8_t *frame,
+                            size_t len, uint32_t now_ms) {
+  if (len < 8 || frame[0] != 0xD3) {
+    return false;
+  }
+
+  // 메시지 번호와 기준국 ID 는 모두 payload 앞 24 bit
+  uint16_t type = ((uint16_t)frame[3] << 4) | (frame[4] >> 4);
+  uint16_t id = ((uint16_t)(frame[4] & 0x0F) << 8) | frame[5];
+
+  int idx = station_index(type);
+  if (idx < 0) {
+    if (rtcm_msm_is_msm(type) && cache->has_id && id != cache->station_id) {
+      cache_flush(cache);
+    }
+    return false;
+  }
+
+  if (cache->has_id && id != cache->station_id) {
+    cache_flush(cache);
+  }
+  cache->station_id = id;
+  cache->has_id = true;
+
+  rtcm_station_entry_t *e = &cache->entry[idx];
+  if (len > RTCM_STATION_FRAME_MAX) {
+    e->len = 0;
+    return true;
+  }
+
+  uint32_t hash = ((uint32_t)frame[len - 3] << 16) |
+                  ((uint32_t)frame[len - 2] << 8) | frame[len - 1];
+  if (e->len != len || e->hash != hash) {
+    if (e->len) {
+      cache->changed++;
+    }
+    memcpy(e->frame, frame, len);
+    e->len = len;
+    e->hash = hash;
+  }
+  e->rx_ms = now_ms;
+  e->inject_ms = now_ms;
+  return true;
+}
+
+const uint8_t *rtcm_station_cache_due(rtcm_station_cache_t *cache,
+                                      uint32_t now_ms, size_t *len) {
+  for (uint8_t i = 0; i < RTCM_STATION_MSG_CNT; i++) {
+    rtcm_station_entry_t *e = &cache->entry[i];
+    if (e->len == 0 || now_ms - e->inject_ms < cache->interval_ms) {
+      continue;
+    }
+    if (cache->max_age_ms && now_ms - e->rx_ms > cache->max_age_ms) {
+      continue;
+    }
+    e->inject_ms = now_ms;
+    cache->injected++;
+    *len = e->len;
+    return e->frame;
+  }
+  return NULL;
+}
@@ -0,0 +1,61 @@
+#ifndef RTCM_STATION_H
+#define RTCM_STATION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * rover 쪽 RTCM 스테이션 메시지 (1005/1006/1033) 캐시
+ *
+ * LoRa 로 받은 검증된 스테이션 메시지를 보관하고 interval_ms 마다 GPS 로 다시 넣는다.
+ * 기지국은 내용이 바뀔 때와 긴 주기로만 보내면 되므로 그만큼 MSM 에 airtime 을 쓴다.
+ * MSM 의 기준국 ID 가 캐시된 ID 와 다르면 다른 기지국으로 보고 캐시를 비운다.
+ */
+#define RTCM_STATION_MSG_CNT 3     ///< 1005, 1006, 1033
+#define RTCM_STATION_FRAME_MAX 192 ///< 1033 문자열 포함 여유
+
+typedef struct {
+  uint16_t len;       ///< 0: 없음
+  uint32_t hash;      ///< 프레임 CRC24Q (내용 비교용)
+  uint32_t rx_ms;     ///< 마지막 수신 시각
+  uint32_t inject_ms; ///< 마지막으로 GPS 에 넣은 시각
+  uint8_t frame[RTCM_STATION_FRAME_MAX];
+} rtcm_station_entry_t;
+
+typedef struct {
+  rtcm_station_entry_t entry[RTCM_STATION_MSG_CNT];
+  uint16_t station_id;
+  bool has_id;
+  uint32_t interval_ms; ///< 재주입 주기
+  uint32_t max_age_ms;  ///< 이 시간 동안 다시 받지 못하면 재주입 중단
+
+  uint32_t injected;
+  uint32_t changed;     ///< 내용이 바뀐 횟수
+  uint32_t flushed;     ///< 기준국 변경으로 비운 횟수
+} rtcm_station_cache_t;
+
+void rtcm_station_cache_init(rtcm_station_cache_t *cache, uint32_t interval_ms,
+                             uint32_t max_age_ms);
+
+/**
+ * @brief 검증된 RTCM 프레임 반영
+ *
+ * 스테이션 메시지는 보관하고, MSM 은 기준국 ID 만 확인한다.
+ * 받은 프레임은 호출자가 그대로 GPS 로 보내므로 재주입 시각도 갱신한다.
+ *
+ * @return 스테이션 메시지면 true
+ */
+bool rtcm_station_cache_put(rtcm_station_cache_t *cache, const uint8_t *frame,
+                            size_t len, uint32_t now_ms);
+
+/**
+ * @brief 재주입할 프레임 하나 꺼내기
+ *
+ * @param len 프레임 길이
+ * @return 프레임, 없으면 NULL
+ */
+const uint8_t *rtcm_station_cache_due(rtcm_station_cache_t *cache,
+                                      uint32_t now_ms, size_t *len);
+
+#endif
@@ -0,0 +1,360 @@
+#include "capture.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef TAG
+  #define TAG "CAPTURE"
+#endif
+
+#include "log.h"
+
+#define BUF_MASK (CAPTURE_BUF_SIZE - 1)
+
+_Static_assert((CAPTURE_BUF_SIZE & BUF_MASK) == 0, "CAPTURE_BUF_SIZE must be power of 2");
+_Static_assert(CAPTURE_REC_MAX + CAPTURE_REC_HDR_SIZE <= CAPTURE_BUF_SIZE, "CAPTURE_REC_MAX too large");
+_Static_assert(CAPTURE_SRC_MAX <= 16, "src_mask is 16 bit");
+
+typedef struct {
+  uint32_t last_total; ///< 마지막으로 보고받은 누적 에러 수
+  uint32_t win_start;  ///< 현재 창 시작 [ms]
+  uint32_t win_cnt;    ///< 현재 창 안의 에러 수
+} capture_err_t;
+
+typedef struct {
+  SemaphoreHandle_t mutex;
+  volatile capture_state_t state;
+  volatile uint16_t src_mask;
+  capture_reason_t reason;
+  uint32_t head; ///< 다음 기록 위치 (free-running)
+  uint32_t tail; ///< 가장 오래된 레코드 위치 (free-running)
+  uint32_t post_left;
+  uint32_t trigger_tick;
+  uint32_t lost;
+  capture_err_t err[CAPTURE_SRC_MAX];
+} capture_t;
+
+static capture_t cap;
+
+/* DMA 로 접근하지 않으므로 CCM 에 둔다 */
+__attribute__((section(".ccmram"))) static uint8_t cap_buf[CAPTURE_BUF_SIZE];
+
+static inline uint32_t now_ms(void) {
+  return xTaskGetTickCount() * portTICK_PERIOD_MS;
+}
+
+static void buf_write(uint32_t pos, const uint8_t *src, size_t len) {
+  size_t idx = pos & BUF_MASK;
+  size_t first = CAPTURE_BUF_SIZE - idx;
+
+  if (first > len) {
+    first = len;
+  }
+  memcpy(&cap_buf[idx], src, first);
+  memcpy(cap_buf, &src[first], len - first);
+}
+
+static void buf_read(uint32_t pos, uint8_t *dst, size_t len) {
+  size_t idx = pos & BUF_MASK;
+  size_t first = CAPTURE_BUF_SIZE - idx;
+
+  if (first > len) {
+    first = len;
+  }
+  memcpy(dst, &cap_buf[idx], first);
+  memcpy(&dst[first], cap_buf, len - first);
+}
+
+static void put_le16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief 링에 레코드 하나 기록. 공간이 모자라면 오래된 레코드부터 버린다.
+ */
+static void record_put(capture_src_t src, uint32_t tick, const uint8_t *data,
+                       uint16_t len) {
+  uint32_t need = CAPTURE_REC_HDR_SIZE + len;
+  uint8_t hdr[CAPTURE_REC_HDR_SIZE];
+
+  while (CAPTURE_BUF_SIZE - (cap.head - cap.tail) < need) {
+    buf_read(cap.tail, hdr, sizeof(hdr));
+    uint16_t old_len = (uint16_t)(hdr[6] | hdr[7] << 8);
+    cap.tail += CAPTURE_REC_HDR_SIZE + old_len;
+    cap.lost += old_len;
+  }
+
+  put_le32(hdr, tick);
+  hdr[4] = (uint8_t)src;
+  hdr[5] = 0;
+  put_le16(&hdr[6], len);
+  buf_write(cap.head, hdr, sizeof(hdr));
+  buf_write(cap.head + CAPTURE_REC_HDR_SIZE, data, len);
+  cap.head += need;
+}
+
+void capture_init(void) {
+  memset(&cap, 0, sizeof(cap));
+  cap.mutex = xSemaphoreCreateMutex();
+}
+
+/**
+ * @brief 캡처 시작 (링을 비우고 다시 기록)
+ *
+ * @param src_mask 기록할 소스 (1 << capture_src_t), 0 이면 끔
+ */
+void capture_start(uint16_t src_mask) {
+  xSemaphoreTake(cap.mutex, portMAX_DELAY);
+  cap.head = 0;
+  cap.tail = 0;
+  cap.lost = 0;
+  cap.reason = CAPTURE_REASON_NONE;
+  cap.trigger_tick = 0;
+  cap.src_mask = src_mask & CAPTURE_SRC_ALL;
+  cap.state = cap.src_mask ? CAPTURE_STATE_ARMED : CAPTURE_STATE_OFF;
+  for (int i = 0; i < CAPTURE_SRC_MAX; i++) {
+    cap.err[i].win_cnt = 0;
+  }
+  xSemaphoreGive(cap.mutex);
+
+  LOG_INFO("capture %s (mask 0x%x)", cap.src_mask ? "armed" : "off",
+           cap.src_mask);
+}
+
+/**
+ * @brief 기록 중인 캡처를 바로 멈춘다 (읽기 가능 상태)
+ */
+void capture_stop(void) {
+  xSemaphoreTake(cap.mutex, portMAX_DELAY);
+  if (cap.state == CAPTURE_STATE_ARMED ||
+      cap.state == CAPTURE_STATE_TRIGGERED) {
+    if (cap.reason == CAPTURE_REASON_NONE) {
+      cap.reason = CAPTURE_REASON_CMD;
+      cap.trigger_tick = now_ms();
+    }
+    cap.state = CAPTURE_STATE_FROZEN;
+  }
+  xSemaphoreGive(cap.mutex);
+}
+
+/**
+ * @brief 트리거. CAPTURE_POST_TRIGGER 바이트를 더 기록한 뒤 멈춘다.
+ *
+ * 기록 중(ARMED)이 아니면 무시한다.
+ */
+void capture_trigger(capture_reason_t reason) {
+  bool fired = false;
+
+  if (cap.state != CAPTURE_STATE_ARMED) {
+    return;
+  }
+
+  xSemaphoreTake(cap.mutex, portMAX_DELAY);
+  if (cap.state == CAPTURE_STATE_ARMED) {
+    cap.state = CAPTURE_STATE_TRIGGERED;
+    cap.reason = reason;
+    cap.trigger_tick = now_ms();
+    cap.post_left = CAPTURE_POST_TRIGGER;
+    fired = true;
+  }
+  xSemaphoreGive(cap.mutex);
+
+  if (fired) {
+    LOG_WARN("capture triggered (reason %d)", reason);
+  }
+}
+
+/**
+ * @brief 수신 구간 기록 (수신 태스크에서 DMA 링 구간 단위로 호출)
+ *
+ * 꺼져 있거나 mask 에 없는 소스는 상태 확인만 하고 돌아간다.
+ *
+ * @param src
+ * @param data
+ * @param len
+ */
+void capture_write(capture_src_t src, const void *data, size_t len) {
+  const uint8_t *p = data;
+  uint32_t tick;
+
+  if ((cap.state != CAPTURE_STATE_ARMED &&
+       cap.state != CAPTURE_STATE_TRIGGERED) ||
+      !(cap.src_mask & (1u << src)) || len == 0) {
+    return;
+  }
+
+  tick = now_ms();
+
+  xSemaphoreTake(cap.mutex, portMAX_DELAY);
+  while (len > 0 && (cap.state == CAPTURE_STATE_ARMED ||
+                     cap.state == CAPTURE_STATE_TRIGGERED)) {
+    uint16_t n = len > CAPTURE_REC_MAX ? CAPTURE_REC_MAX : (uint16_t)len;
+
+    record_put(src, tick, p, n);
+
+    if (cap.state == CAPTURE_STATE_TRIGGERED) {
+      if (n >= cap.post_left) {
+        cap.post_left = 0;
+        cap.state = CAPTURE_STATE_FROZEN;
+      } else {
+        cap.post_left -= n;
+      }
+    }
+
+    p += n;
+    len -= n;
+  }
+  xSemaphoreGive(cap.mutex);
+}
+
+/**
+ * @brief 소스의 누적 체크섬 에러 수 보고 (에러 폭주 트리거)
+ *
+ * CAPTURE_ERR_BURST_MS 안에 CAPTURE_ERR_BURST_CNT 개 이상 늘면 트리거한다.
+ * 소스별 태스크 하나만 호출한다.
+ *
+ * @param src
+ * @param err_total 누적 에러 수
+ */
+void capture_report_errors(capture_src_t src, uint32_t err_total) {
+  capture_err_t *e = &cap.err[src];
+  uint32_t delta = err_total - e->last_total;
+  uint32_t now;
+
+  e->last_total = err_total;
+  if (delta == 0 || cap.state != CAPTURE_STATE_ARMED ||
+      !(cap.src_mask & (1u << src))) {
+    return;
+  }
+
+  now = now_ms();
+  if (e->win_cnt == 0 || now - e->win_start > CAPTURE_ERR_BURST_MS) {
+    e->win_start = now;
+    e->win_cnt = 0;
+  }
+  e->win_cnt += delta;
+
+  if (e->win_cnt >= CAPTURE_ERR_BURST_CNT) {
+    e->win_cnt = 0;
+    capture_trigger(CAPTURE_REASON_ERR_BURST);
+  }
+}
+
+void capture_get_info(capture_info_t *info) {
+  xSemaphoreTake(cap.mutex, portMAX_DELAY);
+  info->state = cap.state;
+  info->reason = cap.reason;
+  info->src_mask = cap.src_mask;
+  info->size = CAPTURE_HDR_SIZE + (cap.head - cap.tail);
+  info->lost = cap.lost;
+  xSemaphoreGive(cap.mutex);
+}
+
+/**
+ * @brief 멈춘 캡처를 내보내기 포맷으로 읽기
+ *
+ * @param offset 헤더 시작 기준 위치
+ * @param[out] buf
+ * @param len
+ * @return size_t 읽은 바이트 (0: 끝이거나 멈춘 상태가 아님)
+ */
+size_t capture_read(uint32_t offset, void *buf, size_t len) {
+  uint8_t hdr[CAPTURE_HDR_SIZE];
+  uint8_t *dst = buf;
+  size_t done = 0;
+  uint32_t size;
+
+  xSemaphoreTake(cap.mutex, portMAX_DELAY);
+  if (cap.state != CAPTURE_STATE_FROZEN) {
+    xSemaphoreGive(cap.mutex);
+    return 0;
+  }
+
+  size = CAPTURE_HDR_SIZE + (cap.head - cap.tail);
+  if (offset >= size) {
+    xSemaphoreGive(cap.mutex);
+    return 0;
+  }
+  if (len > size - offset) {
+    len = size - offset;
+  }
+
+  if (offset < CAPTURE_HDR_SIZE) {
+    memcpy(hdr, "GCAP", 4);
+    hdr[4] = CAPTURE_VERSION;
+    hdr[5] = (uint8_t)cap.reason;
+    put_le16(&hdr[6], cap.src_mask);
+    put_le32(&hdr[8], cap.trigger_tick);
+    put_le32(&hdr[12], cap.lost);
+
+    done = CAPTURE_HDR_SIZE - offset;
+    if (done > len) {
+      done = len;
+    }
+    memcpy(dst, &hdr[offset], done);
+    offset = CAPTURE_HDR_SIZE;
+  }
+
+  buf_read(cap.tail + (offset - CAPTURE_HDR_SIZE), &dst[done], len - done);
+  xSemaphoreGive(cap.mutex);
+
+  return len;
+}
+
+/**
+ * @brief 상태 포맷팅 (BLE/RS485 응답용)
+ *
+ * 포맷: state,reason,src_mask,size,lost
+ */
+int capture_format_info(char *buf, size_t size) {
+  capture_info_t info;
+
+  capture_get_info(&info);
+
+  return snprintf(buf, size, "%d,%d,%u,%lu,%lu", (int)info.state,
+                  (int)info.reason, (unsigned)info.src_mask,
+                  (unsigned long)info.size, (unsigned long)info.lost);
+}
+
+/**
+ * @brief 내보내기 한 줄 포맷팅 (텍스트 채널용)
+ *
+ * 포맷: offset,hex (최대 CAPTURE_LINE_BYTES 바이트, 끝이면 hex 가 비어 있음)
+ * 호스트는 offset 순서대로 hex 를 이어 붙이면 capture_read() 결과와 같다.
+ *
+ * @param offset
+ * @param[out] buf 2 * CAPTURE_LINE_BYTES + 12 이상
+ * @param size
+ * @return int 포맷한 data 바이트 수, buf 가 작으면 -1
+ */
+int capture_format_line(uint32_t offset, char *buf, size_t size) {
+  static const char hex[] = "0123456789ABCDEF";
+  uint8_t data[CAPTURE_LINE_BYTES];
+  size_t n;
+  int pos;
+
+  if (size < 2 * CAPTURE_LINE_BYTES + 12) {
+    return -1;
+  }
+
+  n = capture_read(offset, data, sizeof(data));
+  pos = snprintf(buf, size, "%lu,", (unsigned long)offset);
+
+  for (size_t i = 0; i < n; i++) {
+    buf[pos++] = hex[data[i] >> 4];
+    buf[pos++] = hex[data[i] & 0x0F];
+  }
+  buf[pos] = '\0';
+
+  return (int)n;
+}
@@ -0,0 +1,76 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * UART 원시 수신 캡처
+ *
+ * 각 수신 태스크가 DMA 링에서 꺼낸 구간을 그대로 RAM 링에 기록한다 (바이트 단위 hook 없음).
+ * 켜 두면 오래된 레코드부터 덮어쓰고, 트리거 후 CAPTURE_POST_TRIGGER 바이트를 더
+ * 기록하고 멈춘다. 멈춘 링은 capture_read() 로 아래 바이너리 포맷 그대로 읽어 간다.
+ *
+ * 포맷 (little endian)
+ *   헤더 16 byte : "GCAP", version, reason, src_mask(2), trigger_tick(4), lost(4)
+ *   레코드       : tick(4), src(1), flags(1), len(2), data[len] 반복
+ *   tick 은 [ms], lost 는 링이 차서 덮어쓴 data 바이트 수
+ */
+#define CAPTURE_BUF_SIZE 16384    ///< 2의 거듭제곱
+#define CAPTURE_POST_TRIGGER 4096 ///< 트리거 후 더 기록할 바이트
+#define CAPTURE_REC_MAX 1024      ///< 레코드 하나의 최대 data 길이 (넘으면 나눔)
+
+#define CAPTURE_ERR_BURST_CNT 8     ///< 이 개수 이상의 체크섬 에러가
+#define CAPTURE_ERR_BURST_MS 2000   ///< 이 시간 안에 나오면 트리거
+
+#define CAPTURE_LINE_BYTES 48 ///< capture_format_line() 한 줄의 data 바이트 (RS485 TX 버퍼 128 안)
+
+#define CAPTURE_VERSION 1
+#define CAPTURE_HDR_SIZE 16
+#define CAPTURE_REC_HDR_SIZE 8
+
+typedef enum {
+  CAPTURE_SRC_GPS_BASE = 0,
+  CAPTURE_SRC_GPS_ROVER = 1,
+  CAPTURE_SRC_LORA = 2,
+  CAPTURE_SRC_GSM = 3,
+  CAPTURE_SRC_MAX
+} capture_src_t;
+
+#define CAPTURE_SRC_ALL ((1u << CAPTURE_SRC_MAX) - 1)
+
+typedef enum {
+  CAPTURE_STATE_OFF = 0,
+  CAPTURE_STATE_ARMED,     ///< 기록 중, 트리거 대기
+  CAPTURE_STATE_TRIGGERED, ///< 트리거 후 기록 중
+  CAPTURE_STATE_FROZEN     ///< 기록 종료, 읽기 가능
+} capture_state_t;
+
+typedef enum {
+  CAPTURE_REASON_NONE = 0,
+  CAPTURE_REASON_CMD,
+  CAPTURE_REASON_ERR_BURST,
+  CAPTURE_REASON_FIX_LOST
+} capture_reason_t;
+
+typedef struct {
+  capture_state_t state;
+  capture_reason_t reason;
+  uint16_t src_mask;
+  uint32_t size;   ///< capture_read() 로 읽을 전체 길이 (헤더 포함)
+  uint32_t lost;   ///< 링이 차서 덮어쓴 data 바이트
+} capture_info_t;
+
+void capture_init(void);
+void capture_start(uint16_t src_mask);
+void capture_stop(void);
+void capture_trigger(capture_reason_t reason);
+void capture_write(capture_src_t src, const void *data, size_t len);
+void capture_report_errors(capture_src_t src, uint32_t err_total);
+void capture_get_info(capture_info_t *info);
+size_t capture_read(uint32_t offset, void *buf, size_t len);
+int capture_format_info(char *buf, size_t size);
+int capture_format_line(uint32_t offset, char *buf, size_t size);
+
+#endif
@@ -0,0 +1,118 @@
+#include "lora_airtime.h"
+#include <string.h>
+
+uint32_t lora_toa_us(const lora_phy_params_t *phy, size_t len) {
+  // 2^SF / BW [us], BW = 125kHz << bw
+  uint32_t tsym_us = ((1UL << phy->sf) * 8) >> phy->bw;
+  int32_t de = tsym_us >= 16000 ? 1 : 0;
+  int32_t num = 8 * (int32_t)len - 4 * phy->sf + 28 + (phy->crc ? 16 : 0) -
+                (phy->implicit ? 20 : 0);
+  int32_t den = 4 * (phy->sf - 2 * de);
+  uint32_t payload_sym = 8;
+
+  if (num > 0) {
+    payload_sym += (uint32_t)((num + den - 1) / den) * (phy->cr + 4);
+  }
+
+  // preamble + 4.25 심볼
+  return ((uint32_t)phy->preamble * 4 + 17) * tsym_us / 4 + payload_sym * tsym_us;
+}
+
+void lora_airtime_init(lora_airtime_t *ledger, uint16_t limit_permille) {
+  memset(ledger, 0, sizeof(*ledger));
+  ledger->limit_permille = limit_permille;
+}
+
+/**
+ * @brief 지난 칸을 비우고 현재 시각까지 장부를 굴림
+ *
+ * 마지막으로 반영한 시각보다 이르거나 같은 now_ms (다른 태스크가 먼저 더 늦은 시각으로
+ * 굴린 경우) 는 현재 칸으로 본다. now_ms 는 32 bit ms 로 wrap 되어도 차이로 비교한다.
+ */
+static void airtime_advance(lora_airtime_t *ledger, uint32_t now_ms) {
+  if (!ledger->started) {
+    ledger->now_ms = now_ms;
+    ledger->sec_now = now_ms / 1000;
+    ledger->min_now = now_ms / 60000;
+    ledger->started = true;
+    return;
+  }
+
+  if ((int32_t)(now_ms - ledger->now_ms) <= 0) {
+    return;
+  }
+
+  // 칸 번호는 마지막 시각에서 지난 시간만큼 더해 구함 (now_ms wrap 과 무관)
+  uint32_t elapsed = now_ms - ledger->now_ms;
+  uint32_t sec = ledger->sec_now + (ledger->now_ms % 1000 + elapsed) / 1000;
+  uint32_t min = ledger->min_now + (ledger->now_ms % 60000 + elapsed) / 60000;
+  ledger->now_ms = now_ms;
+
+  if (sec - ledger->sec_now >= LORA_AIRTIME_SLOTS) {
+    memset(ledger->sec_ms, 0, sizeof(ledger->sec_ms));
+    ledger->minute_sum = 0;
+  } else {
+    while (ledger->sec_now != sec) {
+      uint8_t slot = ++ledger->sec_now % LORA_AIRTIME_SLOTS;
+      ledger->minute_sum -= ledger->sec_ms[slot];
+      ledger->sec_ms[slot] = 0;
+    }
+  }
+  ledger->sec_now = sec;
+
+  if (min - ledger->min_now >= LORA_AIRTIME_SLOTS) {
+    memset(ledger->min_ms, 0, sizeof(ledger->min_ms));
+    ledger->hour_sum = 0;
+  } else {
+    while (ledger->min_now != min) {
+      uint8_t slot = ++ledger->min_now % LORA_AIRTIME_SLOTS;
+      ledger->hour_sum -= ledger->min_ms[slot];
+      ledger->min_ms[slot] = 0;
+    }
+  }
+  ledger->min_now = min;
+}
+
+void lora_airtime_add(lora_airtime_t *ledger, uint32_t now_ms, uint32_t airtime_ms) {
+  airtime_advance(ledger, now_ms);
+
+  uint16_t *sec = &ledger->sec_ms[ledger->sec_now % LORA_AIRTIME_SLOTS];
+  uint32_t room = UINT16_MAX - *sec;
+  uint32_t add = airtime_ms < room ? airtime_ms : room;
+  *sec += add;
+  ledger->minute_sum += add;
+
+  ledger->min_ms[ledger->min_now % LORA_AIRTIME_SLOTS] += airtime_ms;
+  ledger->hour_sum += airtime_ms;
+  ledger->total_ms += airtime_ms;
+  ledger->frames++;
+}
+
+bool lora_airtime_allow(lora_airtime_t *ledger, uint32_t now_ms, uint32_t airtime_ms) {
+  if (ledger->limit_permille == 0) {
+    return true;
+  }
+
+  airtime_advance(ledger, now_ms);
+
+  // 1시간 = 3600000ms, 한도 ‰ 이므로 3600 * limit
+  if (ledger->hour_sum + airtime_ms > 3600UL * ledger->limit_permille) {
+    ledger->deferred++;
+    return false;
+  }
+  return true;
+}
+
+void lora_airtime_get(lora_airtime_t *ledger, uint32_t now_ms,
+                      lora_airtime_stats_t *stats) {
+  airtime_advance(ledger, now_ms);
+
+  stats->minute_ms = ledger->minute_sum;
+  stats->hour_ms = ledger->hour_sum;
+  stats->minute_permille = ledger->minute_sum / 60;
+  stats->hour_permille = ledger->hour_sum / 3600;
+  stats->limit_permille = ledger->limit_permille;
+  stats->total_ms = ledger->total_ms;
+  stats->frames = ledger->frames;
+  stats->deferred = ledger->deferred;
+}
@@ -0,0 +1,86 @@
+#ifndef LORA_AIRTIME_H
+#define LORA_AIRTIME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * LoRa Time on Air 와 airtime 장부
+ *
+ * ToA 는 Semtech SX127x 데이터시트 식 (심볼 단위) 으로 계산한다.
+ *   Tsym = 2^SF / BW
+ *   Tpreamble = (preamble + 4.25) * Tsym
+ *   payload 심볼 = 8 + max(ceil((8PL - 4SF + 28 + 16CRC - 20IH) / (4(SF - 2DE))) * (CR + 4), 0)
+ * DE (low data rate optimize) 는 Tsym 이 16ms 이상이면 켠다.
+ *
+ * 장부는 최근 1분 (1초 칸 60개) 과 최근 1시간 (1분 칸 60개) 의 airtime 을 굴려 가며
+ * 더하고, 시간당 duty cycle 한도가 있으면 한도를 넘는 전송을 미루도록 알려 준다.
+ */
+#define LORA_AIRTIME_SLOTS 60
+
+typedef struct {
+  uint8_t sf;        ///< Spreading Factor (7~12)
+  uint8_t bw;        ///< Bandwidth (0:125kHz, 1:250kHz, 2:500kHz) - at+set_config=lorap2p 값
+  uint8_t cr;        ///< Coding Rate (1:4/5 ~ 4:4/8)
+  uint16_t preamble; ///< Preamble 심볼 수
+  bool crc;          ///< payload CRC 사용
+  bool implicit;     ///< implicit header
+} lora_phy_params_t;
+
+typedef struct {
+  uint32_t minute_ms;        ///< 최근 1분 airtime
+  uint32_t hour_ms;          ///< 최근 1시간 airtime
+  uint16_t minute_permille;  ///< 최근 1분 duty cycle [‰]
+  uint16_t hour_permille;    ///< 최근 1시간 duty cycle [‰]
+  uint16_t limit_permille;   ///< 시간당 한도 [‰] (0: 없음)
+  uint32_t total_ms;         ///< 누적 airtime
+  uint32_t frames;           ///< 누적 전송 수
+  uint32_t deferred;         ///< 한도 때문에 미룬 횟수
+} lora_airtime_stats_t;
+
+typedef struct {
+  uint16_t sec_ms[LORA_AIRTIME_SLOTS];  ///< 1초 칸
+  uint32_t min_ms[LORA_AIRTIME_SLOTS];  ///< 1분 칸
+  uint32_t now_ms;     ///< 마지막으로 반영한 시각
+  uint32_t sec_now;    ///< 마지막으로 반영한 초 (칸 번호)
+  uint32_t min_now;    ///< 마지막으로 반영한 분
+  uint32_t minute_sum;
+  uint32_t hour_sum;
+  bool started;
+
+  uint16_t limit_permille;
+  uint32_t total_ms;
+  uint32_t frames;
+  uint32_t deferred;
+} lora_airtime_t;
+
+/**
+ * @brief payload 하나의 Time on Air
+ *
+ * @param len 무선 payload 길이 [byte]
+ * @return ToA [us]
+ */
+uint32_t lora_toa_us(const lora_phy_params_t *phy, size_t len);
+
+/**
+ * @param limit_permille 시간당 duty cycle 한도 [‰] (0: 없음)
+ */
+void lora_airtime_init(lora_airtime_t *ledger, uint16_t limit_permille);
+
+/**
+ * @brief 전송한 airtime 기록
+ */
+void lora_airtime_add(lora_airtime_t *ledger, uint32_t now_ms, uint32_t airtime_ms);
+
+/**
+ * @brief 이번 전송이 시간당 한도 안인지 확인
+ *
+ * @return false: 한도 초과 (미룸으로 센다)
+ */
+bool lora_airtime_allow(lora_airtime_t *ledger, uint32_t now_ms, uint32_t airtime_ms);
+
+void lora_airtime_get(lora_airtime_t *ledger, uint32_t now_ms,
+                      lora_airtime_stats_t *stats);
+
+#endif
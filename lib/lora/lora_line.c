@@ -0,0 +1,172 @@
+#include "lora_line.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RECV_PREFIX_LEN 8 // "at+recv="
+
+enum {
+  LINE_TEXT = 0, ///< 일반 줄
+  LINE_HEADER,   ///< at+recv 헤더 (':' 까지)
+  LINE_HEX,      ///< at+recv payload
+  LINE_SKIP,     ///< 형식 오류 at+recv, 줄 끝까지 버림
+};
+
+// HEX 문자 -> 0x10 | 값, HEX 가 아니면 0
+#define H(v) (0x10 | (v))
+static const uint8_t hex_lut[256] = {
+  ['0'] = H(0), ['1'] = H(1), ['2'] = H(2), ['3'] = H(3), ['4'] = H(4),
+  ['5'] = H(5), ['6'] = H(6), ['7'] = H(7), ['8'] = H(8), ['9'] = H(9),
+  ['A'] = H(10), ['B'] = H(11), ['C'] = H(12), ['D'] = H(13), ['E'] = H(14), ['F'] = H(15),
+  ['a'] = H(10), ['b'] = H(11), ['c'] = H(12), ['d'] = H(13), ['e'] = H(14), ['f'] = H(15),
+};
+#undef H
+
+static void line_reset(lora_line_t *line) {
+  line->state = LINE_TEXT;
+  line->text_len = 0;
+  line->text_over = false;
+  line->nibble = 0xFF;
+}
+
+void lora_line_init(lora_line_t *line) {
+  memset(line, 0, sizeof(*line));
+  line_reset(line);
+}
+
+static void text_push(lora_line_t *line, char c) {
+  if (line->text_len < LORA_LINE_TEXT_MAX) {
+    line->text[line->text_len++] = c;
+  } else {
+    line->text_over = true;
+  }
+}
+
+/**
+ * @brief "<RSSI>,<SNR>,<Len>" 파싱
+ */
+static bool header_parse(lora_line_t *line) {
+  char *p = &line->text[RECV_PREFIX_LEN];
+  char *end;
+
+  line->text[line->text_len] = '\0';
+
+  line->rssi = (int16_t)strtol(p, &end, 10);
+  if (end == p || *end != ',') {
+    return false;
+  }
+  p = end + 1;
+  line->snr = (int16_t)strtol(p, &end, 10);
+  if (end == p || *end != ',') {
+    return false;
+  }
+  p = end + 1;
+  long n = strtol(p, &end, 10);
+  if (end == p || *end != '\0' || n < 0 || n > LORA_LINE_DATA_MAX) {
+    return false;
+  }
+
+  line->data_len = (uint16_t)n;
+  line->data_pos = 0;
+  return true;
+}
+
+static lora_line_type_t line_finish(lora_line_t *line) {
+  lora_line_type_t type;
+
+  line->stats.lines++;
+  if (line->text_over) {
+    line->stats.truncated++;
+  }
+
+  switch (line->state) {
+  case LINE_HEX:
+    if (line->nibble == 0xFF && line->data_pos == line->data_len) {
+      type = LORA_LINE_RECV;
+      line->stats.recv++;
+    } else {
+      type = LORA_LINE_RECV_BAD;
+      line->stats.recv_bad++;
+    }
+    break;
+
+  case LINE_HEADER:
+  case LINE_SKIP:
+    type = LORA_LINE_RECV_BAD;
+    line->stats.recv_bad++;
+    break;
+
+  default:
+    line->text[line->text_len] = '\0';
+    // "OK", "Initialization OK" 등 (대소문자 모두)
+    if (strstr(line->text, "OK") || strstr(line->text, "ok")) {
+      type = LORA_LINE_OK;
+    } else if (strstr(line->text, "ERROR") || strstr(line->text, "error")) {
+      type = LORA_LINE_ERROR;
+    } else {
+      type = LORA_LINE_OTHER;
+    }
+    break;
+  }
+
+  line_reset(line);
+  return type;
+}
+
+size_t lora_line_feed(lora_line_t *line, const char *buf, size_t len,
+                      lora_line_type_t *type) {
+  size_t i = 0;
+
+  *type = LORA_LINE_NONE;
+
+  while (i < len) {
+    char c = buf[i++];
+
+    if (c == '\r' || c == '\n') {
+      // 빈 줄 ("\r\n" 의 '\n' 포함) 은 건너뜀
+      if (line->state == LINE_TEXT && line->text_len == 0 && !line->text_over) {
+        continue;
+      }
+      *type = line_finish(line);
+      return i;
+    }
+
+    switch (line->state) {
+    case LINE_HEX: {
+      uint8_t v = hex_lut[(uint8_t)c];
+      if (v == 0 || line->data_pos >= line->data_len) {
+        line->state = LINE_SKIP;
+      } else if (line->nibble == 0xFF) {
+        line->nibble = v & 0x0F;
+      } else {
+        line->data[line->data_pos++] = (uint8_t)(line->nibble << 4 | (v & 0x0F));
+        line->nibble = 0xFF;
+      }
+      break;
+    }
+
+    case LINE_HEADER:
+      if (c == ':') {
+        line->state = header_parse(line) ? LINE_HEX : LINE_SKIP;
+      } else if (line->text_len < LORA_LINE_TEXT_MAX) {
+        line->text[line->text_len++] = c;
+      } else {
+        line->state = LINE_SKIP;
+      }
+      break;
+
+    case LINE_SKIP:
+      break;
+
+    default:
+      text_push(line, c);
+      if (line->text_len == RECV_PREFIX_LEN &&
+          (memcmp(line->text, "at+recv=", RECV_PREFIX_LEN) == 0 ||
+           memcmp(line->text, "AT+RECV=", RECV_PREFIX_LEN) == 0)) {
+        line->state = LINE_HEADER;
+      }
+      break;
+    }
+  }
+
+  return i;
+}
@@ -0,0 +1,66 @@
+#ifndef LORA_LINE_H
+#define LORA_LINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * LoRa 모듈 UART 수신 스트림 줄 단위 조립
+ *
+ * DMA idle 이벤트마다 들어온 바이트를 그대로 넣으면 한 줄이 끝날 때마다 결과를 알려 준다.
+ * 줄이 두 이벤트에 걸쳐 와도 상태를 이어서 조립한다.
+ *
+ * at+recv=<RSSI>,<SNR>,<Len>:<HEX> 줄은 헤더만 문자로 모으고, HEX 는 표로 바로
+ * binary 로 바꿔 data[] 에 쌓는다. 그 밖의 줄은 OK / ERROR 포함 여부로 구분한다.
+ */
+#define LORA_LINE_TEXT_MAX 64   ///< 일반 응답/at+recv 헤더 보관 길이 (넘으면 잘라서 판정)
+#define LORA_LINE_DATA_MAX 255  ///< at+recv payload 최대 길이 [byte]
+
+typedef enum {
+  LORA_LINE_NONE = 0, ///< 아직 줄이 끝나지 않음
+  LORA_LINE_OK,       ///< OK 포함 응답
+  LORA_LINE_ERROR,    ///< ERROR 포함 응답
+  LORA_LINE_RECV,     ///< at+recv 수신 완료 (rssi/snr/data/data_len 유효)
+  LORA_LINE_RECV_BAD, ///< at+recv 형식 오류 (HEX 오류, 길이 불일치)
+  LORA_LINE_OTHER,    ///< 그 밖의 줄
+} lora_line_type_t;
+
+typedef struct {
+  uint32_t lines;     ///< 완성된 줄
+  uint32_t recv;      ///< 정상 at+recv
+  uint32_t recv_bad;  ///< 형식 오류 at+recv
+  uint32_t truncated; ///< LORA_LINE_TEXT_MAX 를 넘은 줄
+} lora_line_stats_t;
+
+typedef struct {
+  uint8_t state;
+  char text[LORA_LINE_TEXT_MAX + 1];
+  uint8_t text_len;
+  bool text_over;
+
+  uint8_t nibble;     ///< 앞 HEX 자리 (0xFF: 없음)
+
+  int16_t rssi;
+  int16_t snr;
+  uint16_t data_len;  ///< 헤더의 길이
+  uint16_t data_pos;  ///< 지금까지 바꾼 길이
+  uint8_t data[LORA_LINE_DATA_MAX];
+
+  lora_line_stats_t stats;
+} lora_line_t;
+
+void lora_line_init(lora_line_t *line);
+
+/**
+ * @brief 수신 바이트를 넣고 한 줄이 끝나면 멈춤
+ *
+ * 남은 바이트는 다시 넣는다.
+ *
+ * @param[out] type 끝난 줄 종류, 줄이 안 끝났으면 LORA_LINE_NONE
+ * @return 소비한 바이트 수
+ */
+size_t lora_line_feed(lora_line_t *line, const char *buf, size_t len,
+                      lora_line_type_t *type);
+
+#endif
@@ -0,0 +1,314 @@
+#include "nmea_index.h"
+#include "parser.h"
+#include <string.h>
+
+static const int64_t pow10_tbl[] = {
+    1LL,        10LL,        100LL,        1000LL,        10000LL,
+    100000LL,   1000000LL,   10000000LL,   100000000LL,   1000000000LL,
+};
+
+/**
+ * @brief 필드 추가
+ *
+ * @param[inout] idx
+ * @param[in] start 필드 시작 위치
+ * @param[in] end 구분자(',' 또는 '*') 위치
+ */
+static inline void add_field(nmea_index_t *idx, size_t start, size_t end) {
+  if (idx->cnt < NMEA_INDEX_MAX_FIELDS) {
+    idx->field[idx->cnt].off = (uint8_t)start;
+    idx->field[idx->cnt].len = (uint8_t)(end - start);
+    idx->cnt++;
+  }
+}
+
+/**
+ * @brief 필드 범위 조회
+ *
+ * @param[in] idx
+ * @param[in] n
+ * @param[out] p 필드 시작
+ * @param[out] end 필드 끝 (구분자 위치)
+ * @return true: 비어있지 않은 필드
+ */
+static inline bool field_range(const nmea_index_t *idx, uint8_t n,
+                               const char **p, const char **end) {
+  if (n >= idx->cnt || idx->field[n].len == 0) {
+    return false;
+  }
+
+  *p = &idx->str[idx->field[n].off];
+  *end = *p + idx->field[n].len;
+
+  return true;
+}
+
+/**
+ * @brief 10진 숫자 누적 (오버플로우 검사)
+ *
+ * @param[inout] val 0 이상
+ * @param[in] ch '0'~'9'
+ * @param[in] max 허용 최대값
+ * @return true: success false: max 초과
+ */
+static inline bool dec_push(int64_t *val, char ch, int64_t max) {
+  int64_t d = PARSER_CHAR_DEC_TO_NUM(ch);
+
+  if (*val > (max - d) / 10) {
+    return false;
+  }
+  *val = *val * 10 + d;
+
+  return true;
+}
+
+/**
+ * @brief 부호 있는 10진 정수 필드 변환
+ *
+ * @param[in] idx
+ * @param[in] n
+ * @param[in] max 절대값 최대
+ * @param[out] val
+ * @return true: success
+ */
+static bool field_int(const nmea_index_t *idx, uint8_t n, int64_t max,
+                      int64_t *val) {
+  const char *p, *end;
+  int64_t v = 0;
+  bool minus = false;
+
+  if (!field_range(idx, n, &p, &end)) {
+    return false;
+  }
+
+  if (*p == '-' || *p == '+') {
+    minus = (*p == '-');
+    if (++p == end) {
+      return false;
+    }
+  }
+
+  for (; p < end; ++p) {
+    if (!PARSER_CHAR_IS_NUM(*p) || !dec_push(&v, *p, max)) {
+      return false;
+    }
+  }
+
+  *val = minus ? -v : v;
+  return true;
+}
+
+bool nmea_index_build(nmea_index_t *idx, const char *str, size_t len) {
+  uint8_t crc = 0;
+  size_t start = 0;
+  size_t i;
+
+  idx->str = str;
+  idx->len = 0;
+  idx->cnt = 0;
+  idx->crc = 0;
+  idx->chksum_ok = false;
+
+  if (!str || len > NMEA_INDEX_MAX_LEN) {
+    return false;
+  }
+
+  for (i = 0; i < len && str[i] != '*'; i++) {
+    if (str[i] == ',') {
+      add_field(idx, start, i);
+      start = i + 1;
+    }
+    crc ^= (uint8_t)str[i];
+  }
+  add_field(idx, start, i);
+
+  idx->len = (uint8_t)len;
+  idx->crc = crc;
+
+  /* '*' 뒤에 16진 2자리만 있어야 함 */
+  if (i + 3 == len && PARSER_CHAR_IS_HEX(str[i + 1]) &&
+      PARSER_CHAR_IS_HEX(str[i + 2])) {
+    uint8_t recv = (uint8_t)((PARSER_CHAR_HEX_TO_NUM(str[i + 1]) << 4) |
+                             PARSER_CHAR_HEX_TO_NUM(str[i + 2]));
+
+    idx->chksum_ok = (recv == crc);
+  }
+
+  return idx->chksum_ok;
+}
+
+bool nmea_index_msg_is(const nmea_index_t *idx, const char *msg) {
+  size_t len = strlen(msg);
+
+  if (idx->cnt == 0 || idx->field[0].len != len + 2) {
+    return false;
+  }
+
+  return memcmp(&idx->str[idx->field[0].off + 2], msg, len) == 0;
+}
+
+const char *nmea_field_ptr(const nmea_index_t *idx, uint8_t n, uint8_t *len) {
+  if (n >= idx->cnt) {
+    return NULL;
+  }
+
+  if (len) {
+    *len = idx->field[n].len;
+  }
+
+  return &idx->str[idx->field[n].off];
+}
+
+bool nmea_field_is_empty(const nmea_index_t *idx, uint8_t n) {
+  return n >= idx->cnt || idx->field[n].len == 0;
+}
+
+bool nmea_field_equal(const nmea_index_t *idx, uint8_t n, const char *str) {
+  size_t len = strlen(str);
+
+  if (n >= idx->cnt || idx->field[n].len != len) {
+    return false;
+  }
+
+  return memcmp(&idx->str[idx->field[n].off], str, len) == 0;
+}
+
+bool nmea_field_int32(const nmea_index_t *idx, uint8_t n, int32_t *val) {
+  int64_t v;
+
+  /* INT32_MIN 은 허용하지 않음 (NMEA 필드에 나오지 않는 값) */
+  if (!field_int(idx, n, INT32_MAX, &v)) {
+    return false;
+  }
+
+  *val = (int32_t)v;
+  return true;
+}
+
+bool nmea_field_uint32(const nmea_index_t *idx, uint8_t n, uint32_t *val) {
+  int64_t v;
+
+  if (!field_int(idx, n, UINT32_MAX, &v) || v < 0) {
+    return false;
+  }
+
+  *val = (uint32_t)v;
+  return true;
+}
+
+bool nmea_field_hex(const nmea_index_t *idx, uint8_t n, uint32_t *val) {
+  const char *p, *end;
+  uint32_t v = 0;
+
+  if (!field_range(idx, n, &p, &end) || end - p > 8) {
+    return false;
+  }
+
+  for (; p < end; ++p) {
+    if (!PARSER_CHAR_IS_HEX(*p)) {
+      return false;
+    }
+    v = (v << 4) | PARSER_CHAR_HEX_TO_NUM(*p);
+  }
+
+  *val = v;
+  return true;
+}
+
+bool nmea_field_fixed(const nmea_index_t *idx, uint8_t n, uint8_t frac_digits,
+                      int64_t *val) {
+  const char *p, *end;
+  int64_t v = 0;
+  uint8_t frac = 0;
+  bool minus = false;
+  bool digit = false;
+  bool round_up = false;
+
+  if (frac_digits > 9 || !field_range(idx, n, &p, &end)) {
+    return false;
+  }
+
+  if (*p == '-' || *p == '+') {
+    minus = (*p == '-');
+    ++p;
+  }
+
+  for (; p < end && PARSER_CHAR_IS_NUM(*p); ++p) {
+    if (!dec_push(&v, *p, INT64_MAX / pow10_tbl[frac_digits])) {
+      return false;
+    }
+    digit = true;
+  }
+
+  if (p < end && *p == '.') {
+    ++p;
+
+    /* frac_digits 까지 누적하고, 버리는 첫 자리로 반올림 */
+    for (; p < end && PARSER_CHAR_IS_NUM(*p); ++p) {
+      if (frac < frac_digits) {
+        v = v * 10 + PARSER_CHAR_DEC_TO_NUM(*p);
+        frac++;
+      } else if (frac == frac_digits) {
+        round_up = (*p >= '5');
+        frac++;
+      }
+      digit = true;
+    }
+  }
+
+  if (p != end || !digit) {
+    return false;
+  }
+
+  if (frac < frac_digits) {
+    v *= pow10_tbl[frac_digits - frac];
+  }
+  if (round_up) {
+    if (v == INT64_MAX) {
+      return false;
+    }
+    v++;
+  }
+
+  *val = minus ? -v : v;
+  return true;
+}
+
+bool nmea_field_float(const nmea_index_t *idx, uint8_t n, float *val) {
+  int64_t v;
+
+  if (!nmea_field_fixed(idx, n, 6, &v)) {
+    return false;
+  }
+
+  *val = (float)v / 1e6f;
+  return true;
+}
+
+char nmea_field_char(const nmea_index_t *idx, uint8_t n) {
+  if (nmea_field_is_empty(idx, n)) {
+    return 0;
+  }
+
+  return idx->str[idx->field[n].off];
+}
+
+size_t nmea_field_copy(const nmea_index_t *idx, uint8_t n, char *dst,
+                       size_t size) {
+  size_t len = 0;
+
+  if (!dst || size == 0) {
+    return 0;
+  }
+
+  if (n < idx->cnt) {
+    len = idx->field[n].len;
+    if (len > size - 1) {
+      len = size - 1;
+    }
+    memcpy(dst, &idx->str[idx->field[n].off], len);
+  }
+  dst[len] = '\0';
+
+  return len;
+}
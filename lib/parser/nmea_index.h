@@ -0,0 +1,114 @@
+#ifndef NMEA_INDEX_H
+#define NMEA_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NMEA_INDEX_MAX_FIELDS 24 ///< 주소 필드 포함 (GSV 최대 21)
+#define NMEA_INDEX_MAX_LEN 255   ///< 필드 위치를 uint8_t 로 기록
+
+/**
+ * @brief 문장 내 필드 위치
+ */
+typedef struct {
+  uint8_t off; ///< 문장 시작 기준 위치
+  uint8_t len; ///< 필드 길이 (',' 제외)
+} nmea_field_t;
+
+/**
+ * @brief NMEA 183 문장 인덱스
+ *
+ * 완성된 문장을 한번만 훑어 ',' 로 나뉜 필드의 위치/길이와 체크섬을 기록한다.
+ * 값 변환은 하지 않고, 필요한 필드만 nmea_field_*() 접근자로 변환한다.
+ *
+ * @note 문장 버퍼는 복사하지 않으므로 인덱스를 쓰는 동안 유효해야 한다.
+ * @note 필드 0 은 주소 필드 (예: "GPGGA"), 필드 수가
+ * NMEA_INDEX_MAX_FIELDS 를 넘으면 나머지는 기록하지 않는다.
+ */
+typedef struct {
+  const char *str; ///< '$' 다음 위치
+  uint8_t len;     ///< 문장 길이 ('*' 와 체크섬 포함, "\r\n" 제외)
+  uint8_t cnt;     ///< 기록한 필드 수
+  uint8_t crc;     ///< '$' 와 '*' 사이 XOR
+  bool chksum_ok;  ///< 체크섬 필드가 있고 crc 와 일치
+  nmea_field_t field[NMEA_INDEX_MAX_FIELDS];
+} nmea_index_t;
+
+/**
+ * @brief 문장 인덱스 생성
+ *
+ * @param[out] idx
+ * @param[in] str '$' 다음부터 "\r\n" 전까지 (예: "GPGGA,...*5B")
+ * @param[in] len
+ * @return true: 체크섬 일치 false: 체크섬 없음/불일치/길이 초과
+ */
+bool nmea_index_build(nmea_index_t *idx, const char *str, size_t len);
+
+/**
+ * @brief 주소 필드의 메시지 이름 비교 (talker 2자 제외)
+ *
+ * @param[in] idx
+ * @param[in] msg 예: "GGA"
+ * @return true: 일치
+ */
+bool nmea_index_msg_is(const nmea_index_t *idx, const char *msg);
+
+/**
+ * @brief 필드 시작 위치
+ *
+ * @param[in] idx
+ * @param[in] n 필드 번호
+ * @param[out] len 필드 길이 (NULL 가능)
+ * @return const char* 필드가 없으면 NULL (NUL 종료 문자열이 아님)
+ */
+const char *nmea_field_ptr(const nmea_index_t *idx, uint8_t n, uint8_t *len);
+
+bool nmea_field_is_empty(const nmea_index_t *idx, uint8_t n);
+bool nmea_field_equal(const nmea_index_t *idx, uint8_t n, const char *str);
+
+/*
+ * 숫자 접근자는 필드가 비었거나, 숫자가 아닌 문자가 있거나, 범위를 넘으면
+ * false 를 리턴하고 val 은 바꾸지 않는다.
+ */
+bool nmea_field_int32(const nmea_index_t *idx, uint8_t n, int32_t *val);
+bool nmea_field_uint32(const nmea_index_t *idx, uint8_t n, uint32_t *val);
+bool nmea_field_hex(const nmea_index_t *idx, uint8_t n, uint32_t *val);
+
+/**
+ * @brief 10진 고정소수점 필드 변환
+ *
+ * "-12.3456" 을 frac_digits=3 으로 변환하면 -12346 (반올림)
+ *
+ * @param[in] idx
+ * @param[in] n 필드 번호
+ * @param[in] frac_digits 결과의 소수 자리수 (최대 9)
+ * @param[out] val value * 10^frac_digits
+ * @return true: success false: 빈 필드/형식 오류/오버플로우
+ */
+bool nmea_field_fixed(const nmea_index_t *idx, uint8_t n, uint8_t frac_digits,
+                      int64_t *val);
+
+/**
+ * @brief 10진 실수 필드 변환 (소수 6자리까지)
+ *
+ * @note HDOP 처럼 정밀도가 필요 없는 값에만 사용 (좌표는 nmea_field_fixed)
+ */
+bool nmea_field_float(const nmea_index_t *idx, uint8_t n, float *val);
+
+/**
+ * @brief 필드 첫 문자
+ *
+ * @return char 빈 필드면 0
+ */
+char nmea_field_char(const nmea_index_t *idx, uint8_t n);
+
+/**
+ * @brief 필드를 NUL 종료 문자열로 복사
+ *
+ * @return size_t 복사한 문자 수 (size 보다 길면 잘림)
+ */
+size_t nmea_field_copy(const nmea_index_t *idx, uint8_t n, char *dst,
+                       size_t size);
+
+#endif
@@ -1,4 +1,6 @@
+#include "nmea_index.h"
 #include "parser.h"
+#include <string.h>
 
 void my_test(const char *test) {
   char my_test_dat[20];
@@ -21,6 +23,36 @@ void my_test(const char *test) {
          a1, a2, ch1, a3, ch2, n1, n2, a4, a5, ch3, a6, ch4, a7);
 }
 
+void nmea_index_test(const char *test) {
+  nmea_index_t idx;
+  const char *body = test + 1; // '$' 제외
+  size_t len = strcspn(body, "\r\n");
+  bool ok = nmea_index_build(&idx, body, len);
+  int64_t lat = 0, alt = 0;
+  uint32_t fix = 0;
+  int32_t big = 0;
+  bool ret;
+  float hdop = 0;
+
+  nmea_field_fixed(&idx, 2, 9, &lat);
+  nmea_field_uint32(&idx, 6, &fix);
+  nmea_field_float(&idx, 8, &hdop);
+  nmea_field_fixed(&idx, 9, 3, &alt);
+
+  printf("chksum %d fields %d GGA %d lat %lld fix %lu hdop %f alt %lld "
+         "empty %d\r\n",
+         ok, idx.cnt, nmea_index_msg_is(&idx, "GGA"), (long long)lat,
+         (unsigned long)fix, hdop, (long long)alt,
+         nmea_field_is_empty(&idx, 13));
+
+  /* 오버플로우는 false, 값은 그대로 */
+  nmea_index_build(&idx, "GPXXX,2147483648,-2147483647*00", 31);
+  ret = nmea_field_int32(&idx, 1, &big);
+  printf("overflow %d %ld, ", ret, (long)big);
+  ret = nmea_field_int32(&idx, 2, &big);
+  printf("min %d %ld\r\n", ret, (long)big);
+}
+
 int main() {
   printf("test\r\n");
 
@@ -28,6 +60,7 @@ int main() {
                       "499.6,M,48.0,M,,*5B\r\n";
 
   my_test(test1);
+  nmea_index_test(test1);
 
   return 0;
 }
@@ -8,6 +8,8 @@
 #include "flash_params.h"
 #include "ble.h"
 #include "ble_app.h"
+#include "gps_app.h"
+#include "capture.h"
 
 #ifndef TAG
 #define TAG "BLE_CMD"
@@ -40,6 +42,12 @@ static void gd_handler(ble_instance_t *inst, const char *param);
 static void gi_handler(ble_instance_t *inst, const char *param);
 static void gp_handler(ble_instance_t *inst, const char *param);
 static void gg_handler(ble_instance_t *inst, const char *param);
+static void gs_handler(ble_instance_t *inst, const char *param);
+static void cs_handler(ble_instance_t *inst, const char *param);
+static void ct_handler(ble_instance_t *inst, const char *param);
+static void cp_handler(ble_instance_t *inst, const char *param);
+static void cg_handler(ble_instance_t *inst, const char *param);
+static void cr_handler(ble_instance_t *inst, const char *param);
 static void rs_handler(ble_instance_t *inst, const char *param);
 
 void bot_ok_handler(ble_instance_t *inst, const char *param)
@@ -95,6 +103,12 @@ static const ble_at_cmd_entry_t at_cmd_table[] = {
     {"GI", gi_handler},
     {"GP", gp_handler},
     {"GG", gg_handler},
+    {"GS", gs_handler},
+    {"CS+", cs_handler},
+    {"CT", ct_handler},
+    {"CP", cp_handler},
+    {"CG", cg_handler},
+    {"CR+", cr_handler},
     {"RS", rs_handler},
     {NULL, NULL}};
 
@@ -429,6 +443,61 @@ static void gg_handler(ble_instance_t *inst, const char *param)
     sprintf(loc, "Get %s,%s,%s\n\r", params->lat, params->lon, params->alt);
     BLE_AT_RESP_SEND(loc);
 }
+// GPS 별 파서 통계 (gps_format_parser_stats 포맷) 한 줄씩
+static void gs_handler(ble_instance_t *inst, const char *param)
+{
+    char stats[224];
+    char resp[240];
+
+    for (gps_id_t id = 0; id < GPS_ID_MAX; id++)
+    {
+        if (gps_format_parser_stats(id, stats, sizeof(stats)) < 0)
+        {
+            continue;
+        }
+
+        snprintf(resp, sizeof(resp), "Get %s\n\r", stats);
+        BLE_AT_RESP_SEND(resp);
+    }
+}
+// 캡처 시작 (소스 mask, 0: 끔)
+static void cs_handler(ble_instance_t *inst, const char *param)
+{
+    capture_start((uint16_t)strtoul(param, NULL, 0));
+    BLE_AT_RESP_SEND_OK();
+}
+// 캡처 트리거 (CAPTURE_POST_TRIGGER 바이트 더 기록 후 멈춤)
+static void ct_handler(ble_instance_t *inst, const char *param)
+{
+    capture_trigger(CAPTURE_REASON_CMD);
+    BLE_AT_RESP_SEND_OK();
+}
+// 캡처 즉시 멈춤
+static void cp_handler(ble_instance_t *inst, const char *param)
+{
+    capture_stop();
+    BLE_AT_RESP_SEND_OK();
+}
+// 캡처 상태 (capture_format_info 포맷)
+static void cg_handler(ble_instance_t *inst, const char *param)
+{
+    char info[64];
+    char resp[80];
+
+    capture_format_info(info, sizeof(info));
+    snprintf(resp, sizeof(resp), "Get %s\n\r", info);
+    BLE_AT_RESP_SEND(resp);
+}
+// 멈춘 캡처 한 줄 (offset,hex), 끝이면 hex 가 비어 있음
+static void cr_handler(ble_instance_t *inst, const char *param)
+{
+    char line[2 * CAPTURE_LINE_BYTES + 12];
+    char resp[2 * CAPTURE_LINE_BYTES + 20];
+
+    capture_format_line(strtoul(param, NULL, 10), line, sizeof(line));
+    snprintf(resp, sizeof(resp), "Get %s\n\r", line);
+    BLE_AT_RESP_SEND(resp);
+}
 static void rs_handler(ble_instance_t *inst, const char *param)
 {
     ble_get_handle()->ops->send("Device Reset\n", strlen("Device Reset\n"));
@@ -24,7 +24,7 @@
 #define AVERAGING_DURATION_SEC 50     // 평균 계산 시간 (60초)
 #define MAX_SAMPLES 50               // 최대 샘플 수 (10Hz * 60초)
 #define MIN_SAMPLES 20                // 최소 샘플 수
-#define SIGMA_THRESHOLD 3.0           // 이상치 제거 임계값 (3σ)
+#define SIGMA_THRESHOLD 3.0f          // 이상치 제거 임계값 (3σ)
 
 // 상태 관리
 static base_auto_fix_state_t state = BASE_AUTO_FIX_DISABLED;
@@ -237,16 +237,14 @@ void base_auto_fix_on_gps_fix_changed(gps_fix_t fix) {
 /**
  * @brief GGA 데이터 업데이트
  */
-void base_auto_fix_on_gga_update(double lat, double lon, double alt) {
+void base_auto_fix_on_gga_update(const gps_coord_t *coord) {
 
   if (state != BASE_AUTO_FIX_AVERAGING) {
     return;
   }
 
   if (sample_count < MAX_SAMPLES) {
-    samples[sample_count].lat = lat;
-    samples[sample_count].lon = lon;
-    samples[sample_count].alt = alt;
+    samples[sample_count] = *coord;
     sample_count++;
 
     char buf[30];
@@ -329,7 +327,8 @@ static void averaging_timer_callback(TimerHandle_t xTimer) {
 
 static void status_timer_callback(TimerHandle_t xTimer) {
 
-  uint8_t fix = gps_get_instance_handle(0)->nmea_data.gga.fix;
+  gps_solution_t sol;
+  uint8_t fix = gps_get_solution(0, &sol) ? sol.fix : GPS_FIX_INVALID;
   led_color_t gsm_status = led_get_color(LED_ID_1);
 
   uint8_t connect_status = 2;
@@ -355,6 +354,9 @@ static void status_timer_callback(TimerHandle_t xTimer) {
 
 /**
  * @brief 이상치 제거 후 평균 계산 (3σ 방식)
+ *
+ * 평균은 정수(나노도, mm)로 누적해 손실 없이 계산하고, 평균 대비 편차는
+ * 작은 값이므로 표준편차/3σ 비교만 단정밀도(FPU)로 처리한다.
  */
 static bool calculate_average_with_outlier_removal(void) {
   if (sample_count == 0) {
@@ -363,37 +365,37 @@ static bool calculate_average_with_outlier_removal(void) {
 
   // 1차 평균 계산
 
-  double mean_lat = 0, mean_lon = 0, mean_alt = 0;
+  int64_t sum_lat = 0, sum_lon = 0, sum_alt = 0;
 
   for (uint32_t i = 0; i < sample_count; i++) {
 
-    mean_lat += samples[i].lat;
+    sum_lat += samples[i].lat;
 
-    mean_lon += samples[i].lon;
+    sum_lon += samples[i].lon;
 
-    mean_alt += samples[i].alt;
+    sum_alt += samples[i].alt;
 
   }
 
-  mean_lat /= sample_count;
+  int64_t mean_lat = sum_lat / (int64_t)sample_count;
 
-  mean_lon /= sample_count;
+  int64_t mean_lon = sum_lon / (int64_t)sample_count;
 
-  mean_alt /= sample_count;
+  int64_t mean_alt = sum_alt / (int64_t)sample_count;
 
 
 
   // 표준편차 계산
 
-  double var_lat = 0, var_lon = 0, var_alt = 0;
+  float var_lat = 0, var_lon = 0, var_alt = 0;
 
   for (uint32_t i = 0; i < sample_count; i++) {
 
-    double diff_lat = samples[i].lat - mean_lat;
+    float diff_lat = (float)(samples[i].lat - mean_lat);
 
-    double diff_lon = samples[i].lon - mean_lon;
+    float diff_lon = (float)(samples[i].lon - mean_lon);
 
-    double diff_alt = samples[i].alt - mean_alt;
+    float diff_alt = (float)(samples[i].alt - mean_alt);
 
     var_lat += diff_lat * diff_lat;
 
@@ -403,23 +405,28 @@ static bool calculate_average_with_outlier_removal(void) {
 
   }
 
-  double std_lat = sqrt(var_lat / sample_count);
+  float std_lat = sqrtf(var_lat / sample_count);
+
+  float std_lon = sqrtf(var_lon / sample_count);
 
-  double std_lon = sqrt(var_lon / sample_count);
+  float std_alt = sqrtf(var_alt / sample_count);
 
-  double std_alt = sqrt(var_alt / sample_count);
 
+  char lat_str[24], lon_str[24], alt_str[16];
 
+  gps_coord_format_fixed(lat_str, sizeof(lat_str), mean_lat, 9, 9);
+  gps_coord_format_fixed(lon_str, sizeof(lon_str), mean_lon, 9, 9);
+  gps_coord_format_fixed(alt_str, sizeof(alt_str), mean_alt, 3, 3);
 
-  LOG_INFO("1차 평균: lat=%.9f, lon=%.9f, alt=%.3f", mean_lat, mean_lon, mean_alt);
+  LOG_INFO("1차 평균: lat=%s, lon=%s, alt=%s", lat_str, lon_str, alt_str);
 
-  LOG_INFO("표준편차: lat=%.9f, lon=%.9f, alt=%.3f", std_lat, std_lon, std_alt);
+  LOG_INFO("표준편차: lat=%.1f, lon=%.1f [1e-9 deg], alt=%.1f [mm]", std_lat, std_lon, std_alt);
 
 
 
   // 3σ 밖의 샘플 제외하고 재계산
 
-  double final_lat = 0, final_lon = 0, final_alt = 0;
+  int64_t final_lat = 0, final_lon = 0, final_alt = 0;
 
   uint32_t valid_count = 0;
 
@@ -429,21 +436,21 @@ static bool calculate_average_with_outlier_removal(void) {
 
   for (uint32_t i = 0; i < sample_count; i++) {
 
-    double diff_lat = fabs(samples[i].lat - mean_lat);
+    float diff_lat = fabsf((float)(samples[i].lat - mean_lat));
 
-    double diff_lon = fabs(samples[i].lon - mean_lon);
+    float diff_lon = fabsf((float)(samples[i].lon - mean_lon));
 
-    double diff_alt = fabs(samples[i].alt - mean_alt);
+    float diff_alt = fabsf((float)(samples[i].alt - mean_alt));
 
 
 
-    // 3σ 이내 샘플만 사용
+    // 3σ 이내 샘플만 사용 (편차가 0 인 축은 모두 통과)
 
-    if (diff_lat < SIGMA_THRESHOLD * std_lat &&
+    if (diff_lat <= SIGMA_THRESHOLD * std_lat &&
 
-        diff_lon < SIGMA_THRESHOLD * std_lon &&
+        diff_lon <= SIGMA_THRESHOLD * std_lon &&
 
-        diff_alt < SIGMA_THRESHOLD * std_alt) {
+        diff_alt <= SIGMA_THRESHOLD * std_alt) {
 
       final_lat += samples[i].lat;
 
@@ -473,21 +480,13 @@ static bool calculate_average_with_outlier_removal(void) {
 
 
 
-  final_lat /= valid_count;
-
-  final_lon /= valid_count;
-
-  final_alt /= valid_count;
-
-
-
   // 결과 저장
 
-  avg_result.lat = final_lat;
+  avg_result.lat = final_lat / (int64_t)valid_count;
 
-  avg_result.lon = final_lon;
+  avg_result.lon = final_lon / (int64_t)valid_count;
 
-  avg_result.alt = final_alt;
+  avg_result.alt = (int32_t)(final_alt / (int64_t)valid_count);
 
   avg_result.count = valid_count;
 
@@ -515,43 +514,17 @@ static bool switch_to_base_fixed_mode(void) {
 
 
 
-  // 위도/경도/고도를 문자열로 변환 (NMEA 형식)
+  // 위도/경도/고도를 문자열로 변환 (십진 도, m)
 
   char lat_str[32], lon_str[32], alt_str[32];
 
 
 
-  // 위도: DDMM.MMMMM 형식
-
-  double lat_abs = fabs(avg_result.lat);
-
-  int lat_deg = (int)lat_abs;
-
-  double lat_min = (lat_abs - lat_deg) * 60.0;
-
-  snprintf(lat_str, sizeof(lat_str), "%02d%09.6f,%c",
-
-           lat_deg, lat_min, (avg_result.lat >= 0) ? 'N' : 'S');
+  gps_coord_format_fixed(lat_str, sizeof(lat_str), avg_result.lat, 9, 9);
 
+  gps_coord_format_fixed(lon_str, sizeof(lon_str), avg_result.lon, 9, 9);
 
-
-  // 경도: DDDMM.MMMMM 형식
-
-  double lon_abs = fabs(avg_result.lon);
-
-  int lon_deg = (int)lon_abs;
-
-  double lon_min = (lon_abs - lon_deg) * 60.0;
-
-  snprintf(lon_str, sizeof(lon_str), "%03d%09.6f,%c",
-
-           lon_deg, lon_min, (avg_result.lon >= 0) ? 'E' : 'W');
-
-
-
-  // 고도: m
-
-  snprintf(alt_str, sizeof(alt_str), "%.3f", avg_result.alt);
+  gps_coord_format_fixed(alt_str, sizeof(alt_str), avg_result.alt, 3, 4);
 
 
 
@@ -609,8 +582,8 @@ static bool switch_to_base_fixed_mode(void) {
 
   char cmd[128];
 
-  snprintf(cmd, sizeof(cmd), "MODE BASE %.10f %.10f %.4f\r\n",
-           avg_result.lat, avg_result.lon, avg_result.alt);
+  snprintf(cmd, sizeof(cmd), "MODE BASE %s %s %s\r\n",
+           lat_str, lon_str, alt_str);
 
   if (!gps_send_command_sync(gps_id, cmd, 1000)) {
     LOG_ERR("MODE BASE 명령 전송 실패");
@@ -696,11 +669,17 @@ static void base_auto_fix_worker_task(void *pvParameter) {
           continue;
         }
 
+        char lat_str[24], lon_str[24], alt_str[16];
+
+        gps_coord_format_fixed(lat_str, sizeof(lat_str), avg_result.lat, 9, 9);
+        gps_coord_format_fixed(lon_str, sizeof(lon_str), avg_result.lon, 9, 9);
+        gps_coord_format_fixed(alt_str, sizeof(alt_str), avg_result.alt, 3, 3);
+
         LOG_INFO("평균 좌표 계산 완료:");
-        LOG_INFO("  Lat: %.9f (유효: %lu, 제거: %lu)",
-                 avg_result.lat, avg_result.count, avg_result.rejected);
-        LOG_INFO("  Lon: %.9f", avg_result.lon);
-        LOG_INFO("  Alt: %.3f", avg_result.alt);
+        LOG_INFO("  Lat: %s (유효: %lu, 제거: %lu)",
+                 lat_str, avg_result.count, avg_result.rejected);
+        LOG_INFO("  Lon: %s", lon_str);
+        LOG_INFO("  Alt: %s", alt_str);
 
         // Base Fixed 모드로 전환
         state = BASE_AUTO_FIX_SWITCHING;
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "gps_coord.h"
 #include "gps_nmea.h"
 
   typedef enum
@@ -18,14 +19,9 @@
   } base_auto_fix_state_t;
 
   /**
-   * @brief 좌표 샘플
+   * @brief 좌표 샘플 (위경도 [1e-9 deg], 고도 [mm])
    */
-  typedef struct
-  {
-    double lat; // 위도 (도)
-    double lon; // 경도 (도)
-    double alt; // 고도 (m)
-  } coord_sample_t;
+  typedef gps_coord_t coord_sample_t;
 
   /**
 
@@ -35,9 +31,9 @@
 
   typedef struct
   {
-    double lat; // 평균 위도
-    double lon; // 평균 경도
-    double alt; // 평균 고도
+    int64_t lat; // 평균 위도 [1e-9 deg]
+    int64_t lon; // 평균 경도 [1e-9 deg]
+    int32_t alt; // 평균 고도 [mm]
     uint32_t count; // 유효 샘플 수
     uint32_t rejected; // 이상치 제거 샘플 수
   } coord_average_t;
@@ -96,11 +92,11 @@
 
    * @brief GGA 데이터 업데이트 (gps_app.c에서 호출)
 
-   * @param gga GGA 데이터
+   * @param coord 좌표 (위경도 [1e-9 deg], 고도 [mm])
 
    */
 
-void base_auto_fix_on_gga_update(double lat, double lon, double alt);
+void base_auto_fix_on_gga_update(const gps_coord_t *coord);
 
   /**
 
@@ -1,11 +1,17 @@
 #include "gps_app.h"
 #include "board_config.h"
+#include "capture.h"
 #include "gps.h"
+#include "gps_coord.h"
+#include "gps_evt_queue.h"
 #include "gps_port.h"
 #include "gps_unicore.h"
 #include "ubx_init.h"
 #include "ntrip_app.h"
 #include "rtcm.h"
+#include "rtcm_msm.h"
+#include "rtcm_sched.h"
+#include "lora_app.h"
 #include "led.h"
 #include <string.h>
 #include <stdlib.h>
@@ -22,12 +28,10 @@
 
 #include "log.h"
 
-#define GPS_UART_MAX_RECV_SIZE 2048
-
 #define GGA_AVG_SIZE 1
 #define HP_AVG_SIZE 1
 
-static bool gps_init_um982_base_fixed_async_internal(gps_id_t id, double lat, double lon, double alt,
+static bool gps_init_um982_base_fixed_async_internal(gps_id_t id, int64_t lat, int64_t lon, int64_t alt,
 
                                                       gps_init_callback_t callback, void *user_data);
 
@@ -37,20 +41,16 @@ static bool gps_init_um982_base_surveyin_async_internal(gps_id_t id, uint32_t ti
 
 
 typedef struct {
-  int32_t lon[HP_AVG_SIZE];
-  int32_t lat[HP_AVG_SIZE];
-  int32_t height[HP_AVG_SIZE];
-  int32_t msl[HP_AVG_SIZE];
-  int8_t lon_hp[HP_AVG_SIZE];
-  int8_t lat_hp[HP_AVG_SIZE];
-  int8_t height_hp[HP_AVG_SIZE];
-  int8_t msl_hp[HP_AVG_SIZE];
+  int64_t lon[HP_AVG_SIZE];    ///< [1e-9 deg]
+  int64_t lat[HP_AVG_SIZE];    ///< [1e-9 deg]
+  int32_t height[HP_AVG_SIZE]; ///< [0.1 mm]
+  int32_t msl[HP_AVG_SIZE];    ///< [0.1 mm]
   uint32_t hacc;
   uint32_t vacc;
-  double lon_avg;
-  double lat_avg;
-  double height_avg;
-  double msl_avg;
+  int64_t lon_avg;    ///< [1e-9 deg]
+  int64_t lat_avg;    ///< [1e-9 deg]
+  int32_t height_avg; ///< [0.1 mm]
+  int32_t msl_avg;    ///< [0.1 mm]
   uint8_t pos;
   uint8_t len;
   bool can_read;
@@ -67,12 +67,8 @@ typedef struct {
   ubx_hp_avg_data_t ubx_hp_avg;
 
   struct {
-    double lat[GGA_AVG_SIZE];
-    double lon[GGA_AVG_SIZE];
-    double alt[GGA_AVG_SIZE];
-    double lat_avg;
-    double lon_avg;
-    double alt_avg;
+    gps_coord_t coord[GGA_AVG_SIZE];
+    gps_coord_t avg;
     uint8_t pos;
     uint8_t len;
     bool can_read;
@@ -83,50 +79,96 @@ typedef struct {
   gps_cmd_request_t *current_cmd_req;
 
   gps_fix_t last_fix;
+
+  gps_solution_t sol; ///< 발행 전 항법해 작업 사본 (생산자 전용)
+
+  gps_evt_queue_t evt_queue;
+  TaskHandle_t evt_task;
+  uint8_t evt_data[GPS_FRAME_MAX_SIZE]; ///< 소비 태스크 이벤트 데이터 버퍼
 } gps_instance_t;
 
 static gps_instance_t gps_instances[GPS_ID_MAX] = {0};
 
-void _add_gga_avg_data(gps_instance_t *inst, double lat, double lon,
-                       double alt) {
-  uint8_t pos = inst->gga_avg_data.pos;
-  double lat_temp = 0.0, lon_temp = 0.0, alt_temp = 0.0;
+#if defined(USE_GPS_RTCM_MSM_TRIM)
+/* RTCM 은 기지국 GPS 한 대의 이벤트 태스크에서만 LoRa 로 나간다 */
+__attribute__((section(".ccmram"))) static rtcm_msm_fit_t rtcm_fit;
+__attribute__((section(".ccmram"))) static uint8_t rtcm_fit_buf[GPS_FRAME_MAX_SIZE];
+
+/**
+ * @brief epoch 당 MSM 예산
+ *
+ * 설정값이 0 이면 현재 LoRa P2P 설정에서 최대 fragment 를 이어 보낼 때 한 epoch 에
+ * 나가는 바이트로 계산한다. FEC 를 켜면 parity 몫을 뺀다.
+ */
+static uint16_t gps_rtcm_epoch_budget(void) {
+#if GPS_RTCM_EPOCH_BUDGET > 0
+  return GPS_RTCM_EPOCH_BUDGET;
+#else
+  uint32_t budget = (uint32_t)LORA_P2P_RAW_MAX * GPS_RTCM_EPOCH_MS /
+                    lora_p2p_send_ms(LORA_P2P_RAW_MAX) *
+                    GPS_RTCM_EPOCH_LINK_PCT / 100;
+#if defined(USE_GPS_RTCM_FEC)
+  budget = budget * 100 / (100 + GPS_RTCM_FEC_PARITY_PCT);
+#endif
+  return budget > UINT16_MAX ? UINT16_MAX : (uint16_t)budget;
+#endif
+}
+#endif
 
-  inst->gga_avg_data.lat[pos] = lat;
-  inst->gga_avg_data.lon[pos] = lon;
-  inst->gga_avg_data.alt[pos] = alt;
+#if defined(USE_GPS_RTCM_SCHED)
+/**
+ * @brief LoRa 혼잡 시 RTCM 전송 스케줄
+ *
+ * GPS 는 매 epoch, Galileo/BDS 는 번갈아, GLONASS 는 3 epoch 마다 보낸다.
+ * 스테이션 메시지는 수신기 출력 주기 (10초) 부터 혼잡이 이어지면 60초까지 늘린다.
+ * rover 가 스테이션 메시지를 캐시하면 내용이 바뀔 때와 긴 주기로만 보낸다.
+ */
+static const rtcm_sched_cfg_t rtcm_sched_cfg = {
+  //          GPS GLO GAL SBAS QZS BDS NavIC
+  .period = {  1,  3,  2,  0,   1,  2,  1 },
+  .phase  = {  0,  0,  0,  0,   0,  1,  0 },
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+  .station_ms = GPS_RTCM_STATION_INTERVAL_MS,
+  .station_max_ms = GPS_RTCM_STATION_INTERVAL_MS * 4,
+#else
+  .station_ms = 10000,
+  .station_max_ms = 60000,
+#endif
+  .depth_high = 8, // epoch 당 3~4 메시지이므로 두 epoch 이상 밀림
+  .depth_low = 2,
+  .load_high = 90,
+  .load_low = 70,
+};
 
+static rtcm_sched_t rtcm_sched;
+#endif
+
+void _add_gga_avg_data(gps_instance_t *inst, const gps_coord_t *coord) {
+  int64_t lat_sum = 0, lon_sum = 0, alt_sum = 0;
+
+  inst->gga_avg_data.coord[inst->gga_avg_data.pos] = *coord;
   inst->gga_avg_data.pos = (inst->gga_avg_data.pos + 1) % GGA_AVG_SIZE;
 
   /* 정확도를 중시한 코드 */
   if (inst->gga_avg_data.len < GGA_AVG_SIZE) {
     inst->gga_avg_data.len++;
 
-    if (inst->gga_avg_data.len == GGA_AVG_SIZE) {
-
-      for (int i = 0; i < GGA_AVG_SIZE; i++) {
-        lat_temp += inst->gga_avg_data.lat[i];
-        lon_temp += inst->gga_avg_data.lon[i];
-        alt_temp += inst->gga_avg_data.alt[i];
-      }
-
-      inst->gga_avg_data.lat_avg = lat_temp / (double)GGA_AVG_SIZE;
-      inst->gga_avg_data.lon_avg = lon_temp / (double)GGA_AVG_SIZE;
-      inst->gga_avg_data.alt_avg = alt_temp / (double)GGA_AVG_SIZE;
-
-      inst->gga_avg_data.can_read = true;
-    }
-  } else {
-    for (int i = 0; i < GGA_AVG_SIZE; i++) {
-      lat_temp += inst->gga_avg_data.lat[i];
-      lon_temp += inst->gga_avg_data.lon[i];
-      alt_temp += inst->gga_avg_data.alt[i];
+    if (inst->gga_avg_data.len < GGA_AVG_SIZE) {
+      return;
     }
+  }
 
-    inst->gga_avg_data.lat_avg = lat_temp / (double)GGA_AVG_SIZE;
-    inst->gga_avg_data.lon_avg = lon_temp / (double)GGA_AVG_SIZE;
-    inst->gga_avg_data.alt_avg = alt_temp / (double)GGA_AVG_SIZE;
+  for (int i = 0; i < GGA_AVG_SIZE; i++) {
+    lat_sum += inst->gga_avg_data.coord[i].lat;
+    lon_sum += inst->gga_avg_data.coord[i].lon;
+    alt_sum += inst->gga_avg_data.coord[i].alt;
   }
+
+  inst->gga_avg_data.avg.lat = lat_sum / GGA_AVG_SIZE;
+  inst->gga_avg_data.avg.lon = lon_sum / GGA_AVG_SIZE;
+  inst->gga_avg_data.avg.alt = (int32_t)(alt_sum / GGA_AVG_SIZE);
+
+  inst->gga_avg_data.can_read = true;
 }
 
 void _add_hp_avg_data(gps_instance_t *inst) {
@@ -136,16 +178,11 @@ void _add_hp_avg_data(gps_instance_t *inst) {
   ubx_hp_avg_data_t *avg_data = &inst->ubx_hp_avg;
 
   int64_t lat_sum = 0, lon_sum = 0, height_sum = 0, msl_sum = 0;
-  int16_t lat_hp_sum = 0, lon_hp_sum = 0, height_hp_sum = 0, msl_hp_sum = 0;
-
-  avg_data->lon[pos] = data->lon;
-  avg_data->lat[pos] = data->lat;
-  avg_data->height[pos] = data->height;
-  avg_data->msl[pos] = data->msl;
-  avg_data->lon_hp[pos] = data->lon_hp;
-  avg_data->lat_hp[pos] = data->lat_hp;
-  avg_data->height_hp[pos] = data->height_hp;
-  avg_data->msl_hp[pos] = data->msl_hp;
+
+  avg_data->lon[pos] = gps_coord_ndeg_from_ubx(data->lon, data->lon_hp);
+  avg_data->lat[pos] = gps_coord_ndeg_from_ubx(data->lat, data->lat_hp);
+  avg_data->height[pos] = data->height * 10 + data->height_hp;
+  avg_data->msl[pos] = data->msl * 10 + data->msl_hp;
   avg_data->hacc = data->hacc;
   avg_data->vacc = data->vacc;
 
@@ -154,52 +191,24 @@ void _add_hp_avg_data(gps_instance_t *inst) {
   if (avg_data->len < HP_AVG_SIZE) {
     avg_data->len++;
 
-    if (avg_data->len == HP_AVG_SIZE) {
-      for (int i = 0; i < HP_AVG_SIZE; i++) {
-        lon_sum += avg_data->lon[i];
-        lat_sum += avg_data->lat[i];
-        height_sum += avg_data->height[i];
-        msl_sum += avg_data->msl[i];
-        lon_hp_sum += avg_data->lon_hp[i];
-        lat_hp_sum += avg_data->lat_hp[i];
-        height_hp_sum += avg_data->height_hp[i];
-        msl_hp_sum += avg_data->msl_hp[i];
-      }
-
-      avg_data->lon_avg = (lon_sum / (double)HP_AVG_SIZE) +
-                          (lon_hp_sum / (double)HP_AVG_SIZE / (double)100);
-      avg_data->lat_avg = (lat_sum / (double)HP_AVG_SIZE) +
-                          (lat_hp_sum / (double)HP_AVG_SIZE / (double)100);
-      avg_data->height_avg = (height_sum / (double)HP_AVG_SIZE) +
-                             (height_hp_sum / (double)HP_AVG_SIZE / (double)10);
-      avg_data->msl_avg = (msl_sum / (double)HP_AVG_SIZE) +
-                          (msl_hp_sum / (double)HP_AVG_SIZE / (double)10);
-
-      avg_data->can_read = true;
-    }
-  } else if (avg_data->len == HP_AVG_SIZE) {
-    for (int i = 0; i < HP_AVG_SIZE; i++) {
-      lon_sum += avg_data->lon[i];
-      lat_sum += avg_data->lat[i];
-      height_sum += avg_data->height[i];
-      msl_sum += avg_data->msl[i];
-      lon_hp_sum += avg_data->lon_hp[i];
-      lat_hp_sum += avg_data->lat_hp[i];
-      height_hp_sum += avg_data->height_hp[i];
-      msl_hp_sum += avg_data->msl_hp[i];
+    if (avg_data->len < HP_AVG_SIZE) {
+      return;
     }
+  }
 
-    avg_data->lon_avg = (lon_sum / (double)HP_AVG_SIZE) +
-                        (lon_hp_sum / (double)HP_AVG_SIZE / (double)100);
-    avg_data->lat_avg = (lat_sum / (double)HP_AVG_SIZE) +
-                        (lat_hp_sum / (double)HP_AVG_SIZE / (double)100);
-    avg_data->height_avg = (height_sum / (double)HP_AVG_SIZE) +
-                           (height_hp_sum / (double)HP_AVG_SIZE / (double)10);
-    avg_data->msl_avg = (msl_sum / (double)HP_AVG_SIZE) +
-                        (msl_hp_sum / (double)HP_AVG_SIZE / (double)10);
-  } else {
-    LOG_ERR("HP AVG LEN mismatch");
+  for (int i = 0; i < HP_AVG_SIZE; i++) {
+    lon_sum += avg_data->lon[i];
+    lat_sum += avg_data->lat[i];
+    height_sum += avg_data->height[i];
+    msl_sum += avg_data->msl[i];
   }
+
+  avg_data->lon_avg = lon_sum / HP_AVG_SIZE;
+  avg_data->lat_avg = lat_sum / HP_AVG_SIZE;
+  avg_data->height_avg = (int32_t)(height_sum / HP_AVG_SIZE);
+  avg_data->msl_avg = (int32_t)(msl_sum / HP_AVG_SIZE);
+
+  avg_data->can_read = true;
 }
 
 #define GPS_INIT_MAX_RETRY 3
@@ -220,7 +229,11 @@ static const char *um982_base_cmds[] = {
   "rtcm1006 com1 10\r\n",
   "rtcm1074 com1 1\r\n", // gps msm4
   "rtcm1124 com1 1\r\n", // beidou msm4
+#if defined(USE_GPS_RTCM_MSM_TRIM)
+  "rtcm1084 com1 1\r\n", // glonass msm4 (epoch 예산 안에서 줄여 보냄)
+#else
   // "rtcm1084 com1 1\r\n", // glonass msm4
+#endif
   "rtcm1094 com1 1\r\n", // galileo msm4
   "gpgga com1 1\r\n",
   // "gpgsv com1 1\r\n",
@@ -242,7 +255,11 @@ static const char *um982_rover_cmds[] = {
   "unmask QZSS\r\n",
   "gpgga com1 1\r\n",
   // "gpgsv com1 1\r\n",
+#if defined(USE_GPS_UNICORE_HEADING)
+  "HEADINGB 1\r\n",
+#else
   "gpths com1 1\r\n",
+#endif
   // "OBSVHA COM1 1\r\n", // slave antenna
   "BESTNAVB 1\r\n",
   "CONFIG HEADING FIXLENGTH\r\n"
@@ -272,7 +289,12 @@ typedef struct {
 /**
  * @brief UM982 Base 스테이션을 Fixed 모드로 설정 (비동기)
  */
-static bool gps_init_um982_base_fixed_async_internal(gps_id_t id, double lat, double lon, double alt,
+/**
+ * @param lat 위도 [1e-9 deg]
+ * @param lon 경도 [1e-9 deg]
+ * @param alt 고도 [0.1 mm]
+ */
+static bool gps_init_um982_base_fixed_async_internal(gps_id_t id, int64_t lat, int64_t lon, int64_t alt,
                                                       gps_init_callback_t callback, void *user_data) {
   if (id >= GPS_ID_MAX || !gps_instances[id].enabled) {
     LOG_ERR("GPS[%d] invalid or disabled", id);
@@ -280,13 +302,18 @@ static bool gps_init_um982_base_fixed_async_internal(gps_id_t id, double lat, do
   }
 
   char buffer[128];
+  char lat_str[24], lon_str[24], alt_str[20];
+
+  gps_coord_format_fixed(lat_str, sizeof(lat_str), lat, 9, 10);
+  gps_coord_format_fixed(lon_str, sizeof(lon_str), lon, 9, 10);
+  gps_coord_format_fixed(alt_str, sizeof(alt_str), alt, 4, 4);
 
   snprintf(buffer, sizeof(buffer),
-           "mode base %.10f %.10f %.4f\r\n",
-           lat, lon, alt);
+           "mode base %s %s %s\r\n",
+           lat_str, lon_str, alt_str);
 
-  LOG_INFO("GPS[%d] Setting fixed base station mode: lat=%.10f, lon=%.10f, alt=%.4f",
-           id, lat, lon, alt);
+  LOG_INFO("GPS[%d] Setting fixed base station mode: lat=%s, lon=%s, alt=%s",
+           id, lat_str, lon_str, alt_str);
 
   return gps_send_command_async(id, buffer, 1000, callback, user_data);
 }
@@ -321,9 +348,9 @@ bool gps_configure_um982_base_mode_async(gps_id_t id, gps_init_callback_t callba
   user_params_t* params = flash_params_get_current();
 
     // Fixed base station mode with manual position
-    double lat = strtod(params->lat, NULL);
-    double lon = strtod(params->lon, NULL);
-    double alt = strtod(params->alt, NULL);
+    int64_t lat = gps_coord_parse_fixed(params->lat, 9, NULL);
+    int64_t lon = gps_coord_parse_fixed(params->lon, 9, NULL);
+    int64_t alt = gps_coord_parse_fixed(params->alt, 4, NULL);
 
     return gps_init_um982_base_fixed_async_internal(id, lat, lon, alt, callback, user_data);
 
@@ -516,6 +543,152 @@ bool gps_init_um982_rover_async(gps_id_t id, gps_init_callback_t callback) {
   return true;
 }
 
+/**
+ * @brief UNICORE 명령 응답 처리
+ *
+ * @note TX 태스크가 응답 세마포어를 기다리고 있으므로 파서 문맥에서 바로 처리
+ */
+static void gps_cmd_response(gps_instance_t *inst, gps_t *gps) {
+  if (inst->current_cmd_req != NULL) {
+    gps_unicore_resp_t resp = gps_get_unicore_response(gps);
+    if (resp == GPS_UNICORE_RESP_OK) {
+      if (inst->current_cmd_req->is_async) {
+        inst->current_cmd_req->async_result = true;
+      } else {
+        *(inst->current_cmd_req->result) = true;
+      }
+      xSemaphoreGive(inst->current_cmd_req->response_sem);
+    } else if (resp == GPS_UNICORE_RESP_ERROR || resp == GPS_UNICORE_RESP_UNKNOWN) {
+      if (inst->current_cmd_req->is_async) {
+        inst->current_cmd_req->async_result = false;
+      } else {
+        *(inst->current_cmd_req->result) = false;
+      }
+      xSemaphoreGive(inst->current_cmd_req->response_sem);
+    }
+  }
+}
+
+#define GPS_SOL_UPD_NONE 0x00
+#define GPS_SOL_UPD_POS 0x01   ///< 위치 (HPPOSLLH / BESTNAV)
+#define GPS_SOL_UPD_OTHER 0x02 ///< fix, 위성 수, 방위, GGA 원문
+
+/**
+ * @brief 항법해 작업 사본 갱신 후 스냅샷 발행 (생산자)
+ *
+ * 프로토콜별 단위 변환은 여기서만 한다.
+ * 위치/정확도/TOW 는 HPPOSLLH(F9P) / BESTNAV(UM982), fix 와 위성 수는
+ * GGA, BESTNAV, NAV-PVT 중 마지막으로 받은 것, 방위는 RELPOSNED / HEADINGB / THS 에서 가져온다.
+ *
+ * @return 갱신한 항목 (GPS_SOL_UPD_*)
+ */
+static uint8_t gps_sol_update(gps_instance_t *inst, gps_t *gps,
+                              gps_procotol_t protocol, gps_msg_t msg) {
+  gps_solution_t *sol = &inst->sol;
+  uint8_t upd = GPS_SOL_UPD_OTHER;
+
+  switch (protocol) {
+  case GPS_PROTOCOL_NMEA:
+    if (msg.nmea == GPS_NMEA_MSG_GGA) {
+      sol->fix = gps->nmea_data.gga.fix;
+      sol->sat_num = gps->nmea_data.gga.sat_num;
+      sol->ns = gps->nmea_data.gga.ns;
+      sol->ew = gps->nmea_data.gga.ew;
+#if defined(USE_STORE_RAW_GGA)
+      sol->gga_len = 0;
+      if (gps->nmea_data.gga_is_rdy) {
+        memcpy(sol->gga_raw, gps->nmea_data.gga_raw, gps->nmea_data.gga_raw_pos + 1);
+        sol->gga_len = gps->nmea_data.gga_raw_pos;
+      }
+#endif
+#if !defined(USE_GPS_UNICORE_HEADING)
+    } else if (msg.nmea == GPS_NMEA_MSG_THS) {
+      sol->heading = gps->nmea_data.ths.heading;
+#endif
+    } else {
+      return GPS_SOL_UPD_NONE;
+    }
+    break;
+
+  case GPS_PROTOCOL_UBX:
+    if (msg.ubx.class != GPS_UBX_CLASS_NAV)
+      return GPS_SOL_UPD_NONE;
+
+    if (msg.ubx.id == GPS_UBX_NAV_ID_HPPOSLLH) {
+      const gps_ubx_nav_hpposllh_t *hp = &gps->ubx_data.hpposllh;
+
+      sol->src = GPS_PROTOCOL_UBX;
+      sol->tow = hp->tow;
+      sol->lat = gps_coord_ndeg_from_ubx(hp->lat, hp->lat_hp);
+      sol->lon = gps_coord_ndeg_from_ubx(hp->lon, hp->lon_hp);
+      sol->height = (int64_t)hp->height * 10 + hp->height_hp;
+      sol->msl = (int64_t)hp->msl * 10 + hp->msl_hp;
+      sol->hacc = (hp->hacc + 5) / 10;
+      sol->vacc = (hp->vacc + 5) / 10;
+      upd = GPS_SOL_UPD_POS;
+#if defined(USE_GPS_UBX_NAV_PVT)
+    } else if (msg.ubx.id == GPS_UBX_NAV_ID_PVT) {
+      sol->fix = gps_ubx_pvt_fix(&gps->ubx_data.pvt);
+      sol->sat_num = gps->ubx_data.pvt.num_sv;
+#endif
+    } else if (msg.ubx.id == GPS_UBX_NAV_ID_RELPOSNED) {
+      sol->heading = gps->ubx_data.relposned.rel_pos_heading;
+    } else {
+      return GPS_SOL_UPD_NONE;
+    }
+    break;
+
+  case GPS_PROTOCOL_UNICORE_BIN:
+    if (msg.unicore_bin.msg == GPS_UNICORE_BIN_MSG_BESTNAV) {
+      const hpd_unicore_bestnavb_t *bestnav = &gps->unicore_bin_data.bestnav;
+
+      sol->src = GPS_PROTOCOL_UNICORE_BIN;
+      sol->tow = gps->unicore_bin.header.ms;
+      sol->fix = gps_unicore_pos_fix(bestnav->psol_status, bestnav->pos_type);
+      sol->sat_num = bestnav->used_sv;
+      sol->lat = gps_coord_ndeg_from_deg(bestnav->lat);
+      sol->lon = gps_coord_ndeg_from_deg(bestnav->lon);
+      sol->height = gps_coord_fixed_from_double(bestnav->height, 4);
+      sol->msl = sol->height - gps_coord_fixed_from_double(bestnav->geoid, 4);
+      sol->hacc = (uint32_t)lroundf(sqrtf(bestnav->lat_dev * bestnav->lat_dev +
+                                          bestnav->lon_dev * bestnav->lon_dev) * 1000.0f);
+      sol->vacc = (uint32_t)lroundf(bestnav->height_dev * 1000.0f);
+      upd = GPS_SOL_UPD_POS;
+#if defined(USE_GPS_UNICORE_HEADING)
+    } else if (msg.unicore_bin.msg == GPS_UNICORE_BIN_MSG_HEADING) {
+      gps_unicore_heading(&gps->unicore_bin_data, &sol->heading);
+#endif
+    } else {
+      return GPS_SOL_UPD_NONE;
+    }
+    break;
+
+  default:
+    return GPS_SOL_UPD_NONE;
+  }
+
+  sol->tick = xTaskGetTickCount();
+  gps_snapshot_publish(&gps->snapshot, sol);
+
+  return upd;
+}
+
+/**
+ * @brief 정규화한 항법해 위치를 이벤트 좌표로 변환
+ */
+static inline void gps_sol_to_coord(const gps_solution_t *sol, gps_coord_t *coord) {
+  coord->lat = sol->lat;
+  coord->lon = sol->lon;
+  coord->alt = (int32_t)((sol->height >= 0 ? sol->height + 5 : sol->height - 5) / 10);
+}
+
+/**
+ * @brief 파서 이벤트 핸들러 (생산자)
+ *
+ * gps_parse_process() 안에서 mutex 를 잡은 채로 호출되므로 LoRa/LTE 전송 같은
+ * 느린 작업은 하지 않는다. 필요한 값만 레코드로 복사해 이벤트 큐에 넣고
+ * 소비 태스크(gps_evt_task)를 깨운다. 큐가 가득 차면 기다리지 않고 버린다.
+ */
 void gps_evt_handler(gps_t *gps, gps_event_t event, gps_procotol_t protocol,
                      gps_msg_t msg) {
   gps_instance_t *inst = NULL;
@@ -531,101 +704,158 @@ void gps_evt_handler(gps_t *gps, gps_event_t event, gps_procotol_t protocol,
   if (!inst)
     return;
 
+  uint8_t upd = GPS_SOL_UPD_NONE;
+
+  if (event == GPS_EVENT_DATA_PARSED) {
+    upd = gps_sol_update(inst, gps, protocol, msg);
+  }
+
+  gps_evt_t evt = {0};
+  gps_span_t data[2];
+  uint8_t data_cnt = 0;
+
+  evt.tick = xTaskGetTickCount();
+  evt.protocol = protocol;
+  evt.event = event;
+  evt.msg = msg;
+  evt.fix = inst->sol.fix;
+
   switch (protocol) {
   case GPS_PROTOCOL_NMEA:
-    if (msg.nmea == GPS_NMEA_MSG_GGA) {
-    	if(config->board == BOARD_TYPE_BASE_F9P || config->board == BOARD_TYPE_BASE_UM982)
-    	{
-        LOG_ERR("%d", gps->nmea_data.gga.fix);
-          if (gps->nmea_data.gga.fix != inst->last_fix) {
-    	        base_auto_fix_on_gps_fix_changed(gps->nmea_data.gga.fix);
-    	        inst->last_fix = gps->nmea_data.gga.fix;
-    	    }
-              	    
-    	}
-
-      if (gps->nmea_data.gga_is_rdy)
-      {
-        if(config->board == BOARD_TYPE_ROVER_F9P)
-        {
-          if(inst->id == GPS_ID_BASE)
-          {
-            if(ntrip_gga_send_queue_initialized() && gps->nmea_data.gga.fix >= GPS_FIX_GPS) 
-            {
-              ntrip_send_gga_data(gps->nmea_data.gga_raw,
-                               gps->nmea_data.gga_raw_pos);
-            }
-          }
-        }
-        else
-        {
-          if(ntrip_gga_send_queue_initialized() && gps->nmea_data.gga.fix >= GPS_FIX_GPS)
-          {
-            ntrip_send_gga_data(gps->nmea_data.gga_raw,
-                              gps->nmea_data.gga_raw_pos);
-          }
-        }
-      } 
+    if (msg.nmea != GPS_NMEA_MSG_GGA)
+      return;
+
+#if defined(USE_STORE_RAW_GGA)
+    if (inst->sol.gga_len > 0) {
+      data[0].ptr = (const uint8_t *)inst->sol.gga_raw;
+      data[0].len = inst->sol.gga_len;
+      data_cnt = 1;
     }
+#endif
     break;
 
   case GPS_PROTOCOL_UBX:
-    if (msg.ubx.id == GPS_UBX_NAV_ID_HPPOSLLH) {
-      if(config->board == BOARD_TYPE_BASE_F9P)
-      {
-        if (gps->nmea_data.gga.fix == GPS_FIX_RTK_FIX) {
-          // _add_hp_avg_data(inst);
-          double lat = gps->ubx_data.hpposllh.lat * 1e-7 + gps->ubx_data.hpposllh.lat_hp * 1e-9;
-          double lon = gps->ubx_data.hpposllh.lon * 1e-7 + gps->ubx_data.hpposllh.lon_hp * 1e-9;
-          double alt = (gps->ubx_data.hpposllh.height + gps->ubx_data.hpposllh.height * 1e-2)/(double)1000.0;
-          base_auto_fix_on_gga_update(lat, lon, alt);
-        }
-      }
-    }
+  case GPS_PROTOCOL_UNICORE_BIN:
+    // HPPOSLLH / BESTNAV 모두 정규화한 위치 하나로 처리
+    if (!(upd & GPS_SOL_UPD_POS))
+      return;
+
+    gps_sol_to_coord(&inst->sol, &evt.pos);
+    break;
 
   case GPS_PROTOCOL_UNICORE:
-    if (inst->current_cmd_req != NULL) {
-      gps_unicore_resp_t resp = gps_get_unicore_response(gps);
-      if (resp == GPS_UNICORE_RESP_OK) {
-        if (inst->current_cmd_req->is_async) {
-          inst->current_cmd_req->async_result = true;
-        } else {
-          *(inst->current_cmd_req->result) = true;
-        }
-        xSemaphoreGive(inst->current_cmd_req->response_sem);
-      } else if (resp == GPS_UNICORE_RESP_ERROR || resp == GPS_UNICORE_RESP_UNKNOWN) {
-        if (inst->current_cmd_req->is_async) {
-          inst->current_cmd_req->async_result = false;
-        } else {
-          *(inst->current_cmd_req->result) = false;
-        }
-        xSemaphoreGive(inst->current_cmd_req->response_sem);
+    gps_cmd_response(inst, gps);
+    return;
+
+  case GPS_PROTOCOL_RTCM:
+    if (config->lora_mode != LORA_MODE_BASE || evt.fix != GPS_FIX_MANUAL_POS)
+      return;
+
+    // 수신 링 버퍼는 곧 덮어써지므로 프레임을 이벤트 데이터 링으로 복사
+    data[0] = gps->frame.seg[0];
+    data[1] = gps->frame.seg[1];
+    data_cnt = 2;
+    break;
+
+  default:
+    return;
+  }
+
+  gps_evt_queue_push(&inst->evt_queue, &evt, data, data_cnt);
+  xTaskNotifyGive(inst->evt_task);
+}
+
+/**
+ * @brief 이벤트 처리 (소비자)
+ *
+ * @param inst
+ * @param evt
+ * @param data 이벤트와 함께 적재된 데이터 (evt->data_len 바이트)
+ */
+static void gps_evt_dispatch(gps_instance_t *inst, const gps_evt_t *evt,
+                             const uint8_t *data) {
+  const board_config_t *config = board_get_config();
+
+  switch (evt->protocol) {
+  case GPS_PROTOCOL_NMEA:
+    if(config->board == BOARD_TYPE_BASE_F9P || config->board == BOARD_TYPE_BASE_UM982)
+    {
+      LOG_ERR("%d", evt->fix);
+      if (evt->fix != inst->last_fix) {
+        base_auto_fix_on_gps_fix_changed(evt->fix);
+        inst->last_fix = evt->fix;
       }
     }
 
+    if (evt->data_len > 0)
+    {
+      if(config->board == BOARD_TYPE_ROVER_F9P && inst->id != GPS_ID_BASE)
+      {
+        break;
+      }
+
+      if(ntrip_gga_send_queue_initialized() && evt->fix >= GPS_FIX_GPS)
+      {
+        ntrip_send_gga_data((const char *)data, evt->data_len);
+      }
+    }
     break;
 
-case GPS_PROTOCOL_UNICORE_BIN:
-    switch (msg.unicore_bin.msg) {
-      case GPS_UNICORE_BIN_MSG_BESTNAV: {
-        if(config->board == BOARD_TYPE_BASE_UM982)
-        {
-          if (gps->nmea_data.gga.fix == GPS_FIX_RTK_FIX)
-          {
-            hpd_unicore_bestnavb_t *bestnav = &gps->unicore_bin_data.bestnav;
-            base_auto_fix_on_gga_update(bestnav->lat, bestnav->lon, bestnav->height);
-          }
-        }
+  case GPS_PROTOCOL_UBX:
+  case GPS_PROTOCOL_UNICORE_BIN:
+    if(config->board == BOARD_TYPE_BASE_F9P || config->board == BOARD_TYPE_BASE_UM982)
+    {
+      if (evt->fix == GPS_FIX_RTK_FIX) {
+        // _add_hp_avg_data(inst);
+        base_auto_fix_on_gga_update(&evt->pos);
       }
     }
     break;
+
   case GPS_PROTOCOL_RTCM:
-    if(config->lora_mode == LORA_MODE_BASE)
+    if (evt->data_len > 0)
     {
-      if(gps->nmea_data.gga.fix == GPS_FIX_MANUAL_POS)
-      {
-        rtcm_send_to_lora(gps);
+#if defined(USE_GPS_RTCM_SCHED)
+      uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+      lora_tx_load_t load;
+      rtcm_tx_stats_t tx;
+
+      // LoRa TX 큐는 RTCM TX task 가 몇 fragment 만 넣어 두므로 깊이는
+      // epoch 묶음에 남은 메시지 수로 본다
+      lora_get_tx_load(&load);
+      rtcm_get_tx_stats(&tx);
+      uint8_t depth = tx.pending > UINT8_MAX ? UINT8_MAX : (uint8_t)tx.pending;
+      if (rtcm_sched_update_link(&rtcm_sched, now_ms, depth, load.busy_ms)) {
+        LOG_INFO("RTCM 스케줄 %s (pending=%d, load=%d%%)",
+                 rtcm_sched.congested ? "혼잡" : "해제", depth,
+                 rtcm_sched.load);
+      }
+      if (!rtcm_sched_accept(&rtcm_sched, evt->msg.rtcm.msg_type, data,
+                             evt->data_len, now_ms)) {
+        LOG_DEBUG("RTCM %d skipped by schedule", evt->msg.rtcm.msg_type);
+        break;
       }
+#endif
+#if defined(USE_GPS_RTCM_MSM_TRIM)
+      size_t fit_len;
+
+      rtcm_fit.budget = gps_rtcm_epoch_budget(); // P2P 설정이 바뀌면 따라간다
+      rtcm_msm_fit_result_t fit = rtcm_msm_fit(&rtcm_fit, data, evt->data_len,
+                                               rtcm_fit_buf, sizeof(rtcm_fit_buf),
+                                               &fit_len);
+      if (fit == RTCM_MSM_FIT_DROP) {
+        LOG_DEBUG("RTCM %d dropped by epoch budget %d", evt->msg.rtcm.msg_type,
+                  rtcm_fit.budget);
+        break;
+      }
+      if (fit == RTCM_MSM_FIT_TRIMMED) {
+        LOG_DEBUG("RTCM %d trimmed %d -> %d", evt->msg.rtcm.msg_type,
+                  evt->data_len, fit_len);
+        rtcm_send_to_lora(rtcm_fit_buf, fit_len, evt->msg.rtcm.msg_type);
+        break;
+      }
+#endif
+      rtcm_send_to_lora(data, evt->data_len, evt->msg.rtcm.msg_type);
     }
     break;
 
@@ -634,6 +864,36 @@ case GPS_PROTOCOL_UNICORE_BIN:
   }
 }
 
+static void gps_evt_task(void *pvParameter) {
+  gps_id_t id = (gps_id_t)(uintptr_t)pvParameter;
+  gps_instance_t *inst = &gps_instances[id];
+  gps_evt_t evt;
+  uint32_t dropped = 0;
+
+  LOG_INFO("GPS EVT 태스크[%d] 시작", id);
+
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while (gps_evt_queue_pop(&inst->evt_queue, &evt, inst->evt_data,
+                             sizeof(inst->evt_data), xTaskGetTickCount())) {
+      gps_evt_dispatch(inst, &evt, inst->evt_data);
+    }
+
+    if (inst->evt_queue.dropped != dropped) {
+      gps_evt_stats_t stats;
+
+      gps_evt_queue_get_stats(&inst->evt_queue, &stats);
+      LOG_WARN("GPS[%d] 이벤트 %lu개 버림 (누적 %lu, 최대 대기 %lu, 최대 지연 %lums)",
+               id, stats.dropped - dropped, stats.dropped, stats.depth_max,
+               stats.latency_max * portTICK_PERIOD_MS);
+      dropped = stats.dropped;
+    }
+  }
+
+  vTaskDelete(NULL);
+}
+
 static void gps_tx_task(void *pvParameter) {
   gps_id_t id = (gps_id_t)(uintptr_t)pvParameter;
   gps_instance_t *inst = &gps_instances[id];
@@ -741,10 +1001,12 @@ static void gps_process_task(void *pvParameter) {
   gps_id_t id = (gps_id_t)(uintptr_t)pvParameter;
   gps_instance_t *inst = &gps_instances[id];
 
-  size_t pos = 0;
-  size_t old_pos = 0;
+  uint32_t pos = 0;
+  uint32_t old_pos = 0;
   uint8_t dummy = 0;
   size_t total_received = 0;
+  capture_src_t cap_src = (capture_src_t)(CAPTURE_SRC_GPS_BASE + id);
+  gps_fix_t prev_fix = GPS_FIX_INVALID;
 
   gps_set_evt_handler(&inst->gps, gps_evt_handler);
   memset(&inst->gga_avg_data, 0, sizeof(inst->gga_avg_data));
@@ -813,15 +1075,15 @@ static void gps_process_task(void *pvParameter) {
 
     // base : quality 0,1,2 -> red, 4,5 -> yellow, 7 -> green, etc -> none
     // rover : quality 0,1,2 -> red, 5 -> yellow, 4 -> green, etc -> none
-    if (inst->gps.nmea_data.gga.fix <= GPS_FIX_DGPS) {
+    if (inst->sol.fix <= GPS_FIX_DGPS) {
       if (use_led) {
         led_set_color(2, LED_COLOR_RED);
       }
-    } else if (inst->gps.nmea_data.gga.fix == GPS_FIX_RTK_FLOAT) {
+    } else if (inst->sol.fix == GPS_FIX_RTK_FLOAT) {
       if (use_led) {
         led_set_color(2, LED_COLOR_YELLOW);
       }
-    } else if (inst->gps.nmea_data.gga.fix ==  GPS_FIX_RTK_FIX) {
+    } else if (inst->sol.fix ==  GPS_FIX_RTK_FIX) {
       if (use_led) {
         if(config->board == BOARD_TYPE_ROVER_F9P || config->board == BOARD_TYPE_ROVER_UM982)
         {
@@ -832,7 +1094,7 @@ static void gps_process_task(void *pvParameter) {
             led_set_color(2, LED_COLOR_YELLOW);
         }
       }
-    } else if(inst->gps.nmea_data.gga.fix == GPS_FIX_MANUAL_POS)
+    } else if(inst->sol.fix == GPS_FIX_MANUAL_POS)
     {
       if (use_led) {
         led_set_color(2, LED_COLOR_GREEN);
@@ -849,35 +1111,36 @@ static void gps_process_task(void *pvParameter) {
     }
 
     xSemaphoreTake(inst->gps.mutex, portMAX_DELAY);
-    pos = gps_port_get_rx_pos(id);
-    char *gps_recv = gps_port_get_recv_buf(id);
-
-    if (pos != old_pos) {
-      if (pos > old_pos) {
-        size_t len = pos - old_pos;
-        total_received = len;
-        LOG_DEBUG("[%d] %d received", id, (int)len);
-        LOG_DEBUG_RAW("RAW: ", &gps_recv[old_pos], len);
-        gps_parse_process(&inst->gps, &gps_recv[old_pos], pos - old_pos);
-      } else {
-        size_t len1 = GPS_UART_MAX_RECV_SIZE - old_pos;
-        size_t len2 = pos;
-        total_received = len1 + len2;
-        LOG_DEBUG("[%d] %d received (wrap around)", id, (int)(len1 + len2));
-        LOG_DEBUG_RAW("RAW: ", &gps_recv[old_pos], len1);
-        gps_parse_process(&inst->gps, &gps_recv[old_pos],
-                          GPS_UART_MAX_RECV_SIZE - old_pos);
-        if (pos > 0) {
-          LOG_DEBUG_RAW("RAW: ", gps_recv, len2);
-          gps_parse_process(&inst->gps, gps_recv, pos);
-        }
+    gps_span_t span[2];
+    uint8_t span_cnt = gps_port_get_rx_spans(id, old_pos, &pos, span);
+
+    if (span_cnt > 0) {
+      total_received = span[0].len + (span_cnt > 1 ? span[1].len : 0);
+      gps_stats_rx_pending(&inst->gps, total_received);
+      LOG_DEBUG("[%d] %d received%s", id, (int)total_received,
+                span_cnt > 1 ? " (wrap around)" : "");
+
+      // 링 버퍼를 복사 없이 그대로 파서에 전달 (바이너리 프레임은 버퍼를 직접 참조)
+      for (uint8_t i = 0; i < span_cnt; i++) {
+        LOG_DEBUG_RAW("RAW: ", span[i].ptr, span[i].len);
+        capture_write(cap_src, span[i].ptr, span[i].len);
+        gps_parse_process(&inst->gps, span[i].ptr, span[i].len);
       }
       old_pos = pos;
-      if (old_pos == GPS_UART_MAX_RECV_SIZE) {
-        old_pos = 0;
+
+      uint32_t err_total = 0;
+      for (int p = 0; p < GPS_PROTOCOL_CNT; p++) {
+        err_total += inst->gps.stats.chksum_err[p];
       }
+      capture_report_errors(cap_src, err_total);
     }
     xSemaphoreGive(inst->gps.mutex);
+
+    // 유효한 fix 를 잃으면 캡처 트리거
+    if (prev_fix != GPS_FIX_INVALID && inst->sol.fix == GPS_FIX_INVALID) {
+      capture_trigger(CAPTURE_REASON_FIX_LOST);
+    }
+    prev_fix = inst->sol.fix;
   }
 
   vTaskDelete(NULL);
@@ -886,6 +1149,18 @@ static void gps_process_task(void *pvParameter) {
 void gps_init_all(void) {
   const board_config_t *config = board_get_config();
 
+#if defined(USE_GPS_RTCM_MSM_TRIM)
+  rtcm_msm_fit_init(&rtcm_fit, gps_rtcm_epoch_budget(), GPS_RTCM_MSM_TO_MSM4,
+                    GPS_RTCM_MSM_PRIORITY);
+#endif
+#if defined(USE_GPS_RTCM_SCHED)
+  rtcm_sched_init(&rtcm_sched, &rtcm_sched_cfg);
+#endif
+
+  if (config->lora_mode == LORA_MODE_BASE) {
+    rtcm_tx_task_init();
+  }
+
   for (uint8_t i = 0; i < config->gps_cnt && i < GPS_ID_MAX; i++) {
     gps_type_t type = config->gps[i];
 
@@ -929,12 +1204,27 @@ void gps_init_all(void) {
       continue;
     }
 
-    gps_port_start(&gps_instances[i].gps);
+    gps_evt_queue_init(&gps_instances[i].evt_queue);
 
     char task_name[16];
-    snprintf(task_name, sizeof(task_name), "gps_rx_%d", i);
+    snprintf(task_name, sizeof(task_name), "gps_evt_%d", i);
 
     BaseType_t ret =
+        xTaskCreate(gps_evt_task, task_name, 1024,
+                    (void *)(uintptr_t)i, // GPS ID
+                    tskIDLE_PRIORITY + 1, &gps_instances[i].evt_task);
+
+    if (ret != pdPASS) {
+      LOG_ERR("GPS[%d] EVT 태스크 생성 실패", i);
+      gps_instances[i].enabled = false;
+      continue;
+    }
+
+    gps_port_start(&gps_instances[i].gps);
+
+    snprintf(task_name, sizeof(task_name), "gps_rx_%d", i);
+
+    ret =
         xTaskCreate(gps_process_task, task_name, 1024,
                     (void *)(uintptr_t)i, // GPS ID
                     tskIDLE_PRIORITY + 1, &gps_instances[i].task);
@@ -1009,25 +1299,92 @@ bool gps_gga_avg_can_read(gps_id_t id) {
 /**
  * @brief GGA 평균 데이터 가져오기
  */
-bool gps_get_gga_avg(gps_id_t id, double *lat, double *lon, double *alt) {
+bool gps_get_gga_avg(gps_id_t id, gps_coord_t *coord) {
   if (id >= GPS_ID_MAX || !gps_instances[id].enabled) {
     return false;
   }
 
-  if (!gps_instances[id].gga_avg_data.can_read) {
+  if (!gps_instances[id].gga_avg_data.can_read || !coord) {
     return false;
   }
 
-  if (lat)
-    *lat = gps_instances[id].gga_avg_data.lat_avg;
-  if (lon)
-    *lon = gps_instances[id].gga_avg_data.lon_avg;
-  if (alt)
-    *alt = gps_instances[id].gga_avg_data.alt_avg;
+  *coord = gps_instances[id].gga_avg_data.avg;
 
   return true;
 }
 
+/**
+ * @brief 마지막으로 발행된 항법해 가져오기
+ */
+bool gps_get_solution(gps_id_t id, gps_solution_t *sol) {
+  if (id >= GPS_ID_MAX || !gps_instances[id].enabled || !sol) {
+    return false;
+  }
+
+  return gps_snapshot_read(&gps_instances[id].gps.snapshot, sol);
+}
+
+/**
+ * @brief 파서 이벤트 큐 통계 가져오기
+ */
+bool gps_get_evt_stats(gps_id_t id, gps_evt_stats_t *stats) {
+  if (id >= GPS_ID_MAX || !gps_instances[id].enabled || !stats) {
+    return false;
+  }
+
+  gps_evt_queue_get_stats(&gps_instances[id].evt_queue, stats);
+
+  return true;
+}
+
+/**
+ * @brief 파서 통계 가져오기
+ */
+bool gps_get_parser_stats(gps_id_t id, gps_parse_stats_t *stats) {
+  if (id >= GPS_ID_MAX || !gps_instances[id].enabled || !stats) {
+    return false;
+  }
+
+  gps_get_parse_stats(&gps_instances[id].gps, stats);
+
+  return true;
+}
+
+/**
+ * @brief 파서 통계 포맷팅 (BLE/RS485 응답용)
+ *
+ * 포맷: id,rx,discarded,resync,len_reject,overflow,stall,
+ *       nmea_ok,nmea_err,ubx_ok,ubx_err,unib_ok,unib_err,unia_ok,unia_err,
+ *       rtcm_ok,rtcm_err,handler_max[us],ring_max[byte]
+ */
+int gps_format_parser_stats(gps_id_t id, char *buf, size_t size) {
+  gps_parse_stats_t st;
+
+  if (!gps_get_parser_stats(id, &st)) {
+    return -1;
+  }
+
+  return snprintf(buf, size,
+                  "%d,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,"
+                  "%lu,%lu,%lu,%lu",
+                  (int)id, (unsigned long)st.rx_bytes,
+                  (unsigned long)st.discarded, (unsigned long)st.resync,
+                  (unsigned long)st.len_reject, (unsigned long)st.overflow,
+                  (unsigned long)st.stall,
+                  (unsigned long)st.frames[GPS_PROTOCOL_NMEA],
+                  (unsigned long)st.chksum_err[GPS_PROTOCOL_NMEA],
+                  (unsigned long)st.frames[GPS_PROTOCOL_UBX],
+                  (unsigned long)st.chksum_err[GPS_PROTOCOL_UBX],
+                  (unsigned long)st.frames[GPS_PROTOCOL_UNICORE_BIN],
+                  (unsigned long)st.chksum_err[GPS_PROTOCOL_UNICORE_BIN],
+                  (unsigned long)st.frames[GPS_PROTOCOL_UNICORE],
+                  (unsigned long)st.chksum_err[GPS_PROTOCOL_UNICORE],
+                  (unsigned long)st.frames[GPS_PROTOCOL_RTCM],
+                  (unsigned long)st.chksum_err[GPS_PROTOCOL_RTCM],
+                  (unsigned long)(st.handler_max / (configCPU_CLOCK_HZ / 1000000UL)),
+                  (unsigned long)st.ring_max);
+}
+
 bool gps_send_command_sync(gps_id_t id, const char *cmd, uint32_t timeout_ms) {
   if (id >= GPS_ID_MAX || !gps_instances[id].enabled) {
     LOG_ERR("GPS[%d] invalid or disabled", id);
@@ -1198,50 +1555,44 @@ bool gps_format_position_data(char *buffer)
   gps_instance_t *inst = &gps_instances[0];
   gps_instance_t *heading_inst = &gps_instances[1];
   const board_config_t *config = board_get_config();
-  double lat, lon, msl_alt, ellipsoid_alt, heading;
-  char ns = 'N', ew = 'E';
-  int fix;
-  int sat_num;
+  gps_solution_t sol = {.ns = 'N', .ew = 'E'};
+  gps_solution_t heading_sol;
 
-  char ns_str[2] = {ns, '\0'};
-  char ew_str[2] = {ew, '\0'};
+  char lat_str[24], lon_str[24], msl_str[20], ellipsoid_str[20], heading_str[16];
 
-  taskENTER_CRITICAL();
-  if(config->board == BOARD_TYPE_ROVER_F9P)
+  // 파서가 발행한 스냅샷 복사 (파서를 멈추지 않음)
+  if (config->board == BOARD_TYPE_ROVER_F9P || config->board == BOARD_TYPE_ROVER_UM982)
   {
-    lat = inst->gps.ubx_data.hpposllh.lat * 1e-7 + inst->gps.ubx_data.hpposllh.lat_hp * 1e-9;
-    lon = inst->gps.ubx_data.hpposllh.lon * 1e-7 + inst->gps.ubx_data.hpposllh.lon_hp * 1e-9;
-    ellipsoid_alt = (inst->gps.ubx_data.hpposllh.height + inst->gps.ubx_data.hpposllh.height_hp * (double)0.1) / (double)1000.0;
-    msl_alt = (inst->gps.ubx_data.hpposllh.msl + inst->gps.ubx_data.hpposllh.msl_hp * (double)0.1) / (double)1000.0;
-    heading = heading_inst->gps.ubx_data.relposned.rel_pos_heading * 1e-5;
-    ns = inst->gps.nmea_data.gga.ns;
-    ew = inst->gps.nmea_data.gga.ew;
-    fix = inst->gps.nmea_data.gga.fix;
-    sat_num = inst->gps.nmea_data.gga.sat_num;
-  }
-  else if (config->board == BOARD_TYPE_ROVER_UM982) 
+    gps_snapshot_read(&inst->gps.snapshot, &sol);
+  }
+
+  if (config->board == BOARD_TYPE_ROVER_F9P)
   {
-    lat = inst->gps.unicore_bin_data.bestnav.lat;
-    lon = inst->gps.unicore_bin_data.bestnav.lon;
-    ellipsoid_alt = inst->gps.unicore_bin_data.bestnav.height;
-    msl_alt = ellipsoid_alt - inst->gps.unicore_bin_data.bestnav.geoid;
-    heading = inst->gps.nmea_data.ths.heading;
-    ns = inst->gps.nmea_data.gga.ns;
-    ew = inst->gps.nmea_data.gga.ew;
-    fix = inst->gps.nmea_data.gga.fix;
-    sat_num = inst->gps.nmea_data.gga.sat_num;
-  }
-  taskEXIT_CRITICAL();
-
-  // 포맷팅 (뮤텍스 밖에서 수행)
+    sol.heading = 0;
+    if (gps_snapshot_read(&heading_inst->gps.snapshot, &heading_sol))
+    {
+      sol.heading = heading_sol.heading;
+    }
+  }
+
+  char ns_str[2] = {sol.ns ? sol.ns : 'N', '\0'};
+  char ew_str[2] = {sol.ew ? sol.ew : 'E', '\0'};
+
+  // 포맷팅 (정수 연산만 사용)
+  gps_coord_format_fixed(lat_str, sizeof(lat_str), sol.lat, 9, 9);
+  gps_coord_format_fixed(lon_str, sizeof(lon_str), sol.lon, 9, 9);
+  gps_coord_format_fixed(msl_str, sizeof(msl_str), sol.msl, 4, 4);
+  gps_coord_format_fixed(ellipsoid_str, sizeof(ellipsoid_str), sol.height, 4, 4);
+  gps_coord_format_fixed(heading_str, sizeof(heading_str), sol.heading, 5, 5);
+
   int written = sprintf(buffer,
-                         "+GPS,%.9lf,%s,%.9lf,%s,%.4lf,%.4lf,%.5lf,%d,%d\r",
-                        lat, ns_str, lon, ew_str,
-                        msl_alt,
-                        ellipsoid_alt,
-                        heading,
-                        fix,
-                        sat_num);
+                         "+GPS,%s,%s,%s,%s,%s,%s,%s,%d,%d\r",
+                        lat_str, ns_str, lon_str, ew_str,
+                        msl_str,
+                        ellipsoid_str,
+                        heading_str,
+                        (int)sol.fix,
+                        (int)sol.sat_num);
 
   return true;
 }
@@ -4,6 +4,8 @@
 #include "FreeRTOS.h"
 #include "board_config.h"
 #include "gps.h"
+#include "gps_coord.h"
+#include "gps_evt_queue.h"
 #include "queue.h"
 #include "semphr.h"
 #include "task.h"
@@ -77,12 +79,48 @@ bool gps_gga_avg_can_read(gps_id_t id);
  * @brief GGA 평균 데이터 가져오기
  *
  * @param id GPS ID
- * @param lat 위도 출력 (NULL 가능)
- * @param lon 경도 출력 (NULL 가능)
- * @param alt 고도 출력 (NULL 가능)
+ * @param coord 평균 좌표 출력 (위경도 [1e-9 deg], 고도 [mm])
  * @return true: 성공, false: 실패
  */
-bool gps_get_gga_avg(gps_id_t id, double *lat, double *lon, double *alt);
+bool gps_get_gga_avg(gps_id_t id, gps_coord_t *coord);
+
+/**
+ * @brief 마지막으로 발행된 항법해 가져오기 (잠금 없이 복사)
+ *
+ * @param id GPS ID
+ * @param sol 정규화한 항법해 출력 (위경도 [1e-9 deg], 고도 [0.1 mm], 정확도 [mm])
+ * @return true: 성공, false: 아직 발행 없음
+ */
+bool gps_get_solution(gps_id_t id, gps_solution_t *sol);
+
+/**
+ * @brief 파서 이벤트 큐 통계 가져오기
+ *
+ * @param id GPS ID
+ * @param stats 적재/버림 횟수, 대기 깊이, 이벤트 지연 [tick]
+ * @return true: 성공, false: 실패
+ */
+bool gps_get_evt_stats(gps_id_t id, gps_evt_stats_t *stats);
+
+/**
+ * @brief 파서 통계 가져오기
+ *
+ * @param id GPS ID
+ * @param stats 프로토콜별 프레임/체크섬 오류, 재동기, 버린 바이트,
+ *              핸들러 최대 처리 시간 [cycle], 수신 링 최대 미처리량 [byte]
+ * @return true: 성공, false: 실패
+ */
+bool gps_get_parser_stats(gps_id_t id, gps_parse_stats_t *stats);
+
+/**
+ * @brief 파서 통계를 쉼표 구분 문자열로 포맷팅 (BLE/RS485 응답용)
+ *
+ * @param id GPS ID
+ * @param buf 출력 버퍼 (220 byte 이상 권장)
+ * @param size 버퍼 크기
+ * @return int 기록한 길이, 실패시 -1
+ */
+int gps_format_parser_stats(gps_id_t id, char *buf, size_t size);
 bool gps_factory_reset_async(gps_id_t id, gps_init_callback_t callback, void *user_data);
 bool gps_format_position_data(char *buffer);
 bool gps_config_heading_length_async(gps_id_t id, float baseline_len, float slave_distance,
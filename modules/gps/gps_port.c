@@ -626,6 +626,55 @@ char *gps_port_get_recv_buf(gps_id_t id)
   return gps_recv_buf[id];
 }
 
+/**
+ * @brief GPS 수신 링 버퍼에서 새로 수신된 구간 가져오기
+ *
+ * DMA 수신 위치가 링 버퍼 끝을 넘어간 경우 [old_pos, end), [0, rx_pos)
+ * 두 구간으로 나눠서 반환한다. 데이터는 복사하지 않고 링 버퍼를 직접 가리킨다.
+ *
+ * @param[in] id
+ * @param[in] old_pos 이전에 처리한 위치
+ * @param[out] new_pos 현재 DMA 수신 위치
+ * @param[out] span 수신 구간 (최대 2개)
+ * @return uint8_t 구간 개수 (0 ~ 2)
+ */
+uint8_t gps_port_get_rx_spans(gps_id_t id, uint32_t old_pos, uint32_t *new_pos,
+                              gps_span_t span[2])
+{
+  if (id >= GPS_CNT)
+    return 0;
+
+  const uint8_t *buf = (const uint8_t *)gps_recv_buf[id];
+  uint32_t size = sizeof(gps_recv_buf[id]);
+  uint32_t pos = gps_port_get_rx_pos(id);
+  uint8_t cnt = 0;
+
+  if (pos == size)
+  {
+    pos = 0;
+  }
+
+  if (pos > old_pos)
+  {
+    span[cnt].ptr = &buf[old_pos];
+    span[cnt++].len = pos - old_pos;
+  }
+  else if (pos < old_pos)
+  {
+    span[cnt].ptr = &buf[old_pos];
+    span[cnt++].len = size - old_pos;
+
+    if (pos > 0)
+    {
+      span[cnt].ptr = buf;
+      span[cnt++].len = pos;
+    }
+  }
+
+  *new_pos = pos;
+  return cnt;
+}
+
 /**
  * @brief GPS 인터럽트 핸들러용 큐 설정
  */
@@ -11,6 +11,8 @@ void gps_port_start(gps_t *gps_handle);
 void gps_port_stop(gps_t *gps_handle);
 uint32_t gps_port_get_rx_pos(gps_id_t id);
 char *gps_port_get_recv_buf(gps_id_t id);
+uint8_t gps_port_get_rx_spans(gps_id_t id, uint32_t old_pos, uint32_t *new_pos,
+                              gps_span_t span[2]);
 void gps_port_set_queue(gps_id_t id, QueueHandle_t queue);
 
 #endif
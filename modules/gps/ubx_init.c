@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "gps_ubx.h"
+#include "gps_coord.h"
 #include "ubx_init.h"
 #include <stdlib.h>
 #include <string.h>
@@ -510,15 +511,10 @@ bool ubx_set_fixed_position_async(gps_t* gps, const char* lat_str, const char* l
     snprintf(g_tmode_ctx.lon_str, sizeof(g_tmode_ctx.lon_str), "%s", lon_str);
     snprintf(g_tmode_ctx.alt_str, sizeof(g_tmode_ctx.alt_str), "%s", alt_str);
 
-    // 문자열을 double로 변환
-    double lat_deg = strtod(lat_str, NULL);
-    double lon_deg = strtod(lon_str, NULL);
-    double alt_m = strtod(alt_str, NULL);
-
-    // u-blox 포맷으로 변환
-    int32_t lat_e7 = (int32_t)(lat_deg * 1e7);
-    int32_t lon_e7 = (int32_t)(lon_deg * 1e7);
-    int32_t height_cm = (int32_t)(alt_m * 100);
+    // u-blox 포맷으로 변환 (문자열에서 바로 고정소수점, 반올림)
+    int32_t lat_e7 = (int32_t)gps_coord_parse_fixed(lat_str, 7, NULL);
+    int32_t lon_e7 = (int32_t)gps_coord_parse_fixed(lon_str, 7, NULL);
+    int32_t height_cm = (int32_t)gps_coord_parse_fixed(alt_str, 2, NULL);
 
     // STEP 1: 위치 정보 설정
     g_tmode_ctx.position_configs[0].key_id = CFG_TMODE_LLH_LAT;
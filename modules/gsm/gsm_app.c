@@ -1,5 +1,6 @@
 #include "gsm_app.h"
 #include "FreeRTOS.h"
+#include "capture.h"
 #include "gsm.h"
 #include "gsm_port.h"
 #include "led.h"
@@ -190,6 +191,7 @@ static void gsm_process_task(void *pvParameter) {
         size_t len = pos - old_pos;
         total_received = len;
         LOG_DEBUG("RX: %u bytes", len);
+        capture_write(CAPTURE_SRC_GSM, &gsm_mem[old_pos], len);
 //        LOG_DEBUG_RAW("RAW: ", &gsm_mem[old_pos], len);
         gsm_parse_process(&gsm_handle, &gsm_mem[old_pos], pos - old_pos);
       } else {
@@ -197,6 +199,8 @@ static void gsm_process_task(void *pvParameter) {
         size_t len2 = pos;
         total_received = len1 + len2;
         LOG_DEBUG("RX: %u bytes (wrapped: %u+%u)", total_received, len1, len2);
+        capture_write(CAPTURE_SRC_GSM, &gsm_mem[old_pos], len1);
+        capture_write(CAPTURE_SRC_GSM, gsm_mem, len2);
 
 //        LOG_DEBUG_RAW("RAW: ", &gsm_mem[old_pos], len1);
         gsm_parse_process(&gsm_handle, &gsm_mem[old_pos],
@@ -1,9 +1,15 @@
 #include "lora.h"
 #include "lora_app.h"
+#include "lora_line.h"
 #include "lora_port.h"
 #include "board_config.h"
 #include "gps.h"
 #include "gps_app.h"
+#include "gps_crc.h"
+#include "capture.h"
+#include "rtcm_station.h"
+#include "rtcm_fec.h"
+#include "rtcm_reasm.h"
 #include "semphr.h"
 #include <string.h>
 #include <stdio.h>
@@ -23,6 +29,19 @@
 
 #define LORA_RECV_BUF_SIZE 1024
 
+#define LORA_STATION_POLL_MS 1000 // 스테이션 메시지 재주입 확인 주기
+
+#define LORA_DUTY_CYCLE_PERMILLE 0 // 시간당 airtime 한도 [‰] (0: 없음, KR920 은 LBT 만 요구)
+#define LORA_P2P_SEND_PREFIX "at+send=lorap2p:"
+#define LORA_TX_FRAME_SIZE (sizeof(LORA_P2P_SEND_PREFIX) + LORA_P2P_RAW_MAX * 2 + 2)
+
+// at+send 118 byte 명령어 전송 시작 → OK 수신 실측값 (SF7/BW500, CR4/5, preamble 8).
+// 무선으로 나가는 것은 binary 118 byte 라 계산 ToA 는 약 50ms (lora_p2p_toa_ms(118)),
+// AT 명령어 254 문자의 UART 전송이 약 22ms 이고, 나머지 약 280ms 는 airtime 이 아닌
+// 모듈 처리 시간이다. 이 값은 fragment 타임아웃과 MSM epoch 예산의 하한이 된다.
+#define LORA_P2P_SEND_MEASURED_MS 350
+#define LORA_UART_BAUD 115200 // lora_port.c USART3 설정과 같게
+
 static void lora_process_task(void *pvParameter);
 static void lora_tx_task(void *pvParameter);
 static void lora_tx_test_task(void *pvParameter);
@@ -77,7 +96,22 @@ typedef struct
   lora_p2p_recv_callback_t p2p_recv_callback; // P2P 수신 콜백
   void *p2p_recv_user_data;                   // P2P 수신 콜백 사용자 데이터
 
-  rtcm_reassembly_t rtcm_reassembly;          // RTCM fragment 재조립 버퍼
+  lora_line_t rx_line;                        // 수신 스트림 줄 조립
+  rtcm_reasm_t rtcm_reasm;                    // RTCM fragment 재조립 링
+
+  volatile uint32_t tx_busy_ms;               // TX Task 명령어 처리 누적 시간 (ms)
+  lora_tx_stats_t tx_stats;                   // P2P 전송 응답 통계
+
+  lora_phy_params_t phy;                      // 현재 P2P 무선 설정 (ToA 계산용)
+  lora_airtime_t airtime;                     // 전송 airtime 장부
+
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+  rtcm_station_cache_t station_cache;         // rover 스테이션 메시지 캐시
+#endif
+
+#if defined(USE_GPS_RTCM_FEC)
+  rtcm_fec_rx_t rtcm_fec;                     // RTCM FEC 블록 복구
+#endif
 } lora_app_instance_t;
 
 static lora_app_instance_t instance;
@@ -265,35 +299,6 @@ static bool lora_init_p2p_rover_async(lora_init_callback_t callback)
   return true;
 }
 
-/**
- * @brief RTCM3 CRC24Q 계산
- *
- * @param buffer 데이터 버퍼
- * @param len 데이터 길이 (CRC 제외)
- * @return 24-bit CRC 값
- */
-static uint32_t rtcm_crc24q(const uint8_t *buffer, size_t len)
-{
-  // CRC24Q polynomial: 0x1864CFB
-  uint32_t crc = 0;
-
-  for (size_t i = 0; i < len; i++)
-  {
-    crc ^= ((uint32_t)buffer[i]) << 16;
-
-    for (int j = 0; j < 8; j++)
-    {
-      crc <<= 1;
-      if (crc & 0x1000000)
-      {
-        crc ^= 0x1864CFB;
-      }
-    }
-  }
-
-  return crc & 0xFFFFFF;
-}
-
 /**
  * @brief RTCM 패킷 검증 (헤더 및 CRC)
  *
@@ -329,7 +334,7 @@ static bool rtcm_validate_packet(const uint8_t *buffer, size_t len)
   }
 
   // CRC24Q 검증
-  uint32_t calculated_crc = rtcm_crc24q(buffer, len - 3);
+  uint32_t calculated_crc = gps_crc24q(buffer, len - 3);
   uint32_t received_crc = ((uint32_t)buffer[len - 3] << 16) |
                           ((uint32_t)buffer[len - 2] << 8) |
                           buffer[len - 1];
@@ -347,236 +352,142 @@ static bool rtcm_validate_packet(const uint8_t *buffer, size_t len)
 }
 
 /**
- * @brief AT 명령어 응답 파싱 (OK/ERROR 감지)
+ * @brief P2P 전송 명령어의 무선 payload 길이
  *
- * @param data 응답 데이터
- * @param len 데이터 길이
- * @return true: OK, false: ERROR or 미감지
+ * @return HEX 문자열을 binary 로 바꾼 길이, 전송 명령어가 아니면 0
  */
-static bool lora_parse_at_response(const char *data, size_t len)
+static size_t lora_cmd_air_len(const lora_cmd_request_t *req)
 {
-  // OK 응답 감지 (다양한 형식 지원)
-  // - "OK\r\n", "OK\n" (일반 응답)
-  // - "Initialization OK" (work_mode 변경 시)
-  // - 대소문자 무시
-  if (strstr(data, "OK") != NULL || strstr(data, "ok") != NULL)
+  const size_t prefix_len = sizeof(LORA_P2P_SEND_PREFIX) - 1;
+
+  if (req->raw_len > 0)
   {
-    return true;
+    return req->raw_len;
   }
-
-  // ERROR 응답 감지
-  if (strstr(data, "ERROR") != NULL || strstr(data, "error") != NULL)
+  if (strncmp(req->cmd, LORA_P2P_SEND_PREFIX, prefix_len) != 0)
   {
-    return false;
+    return 0;
   }
-
-  return false;
+  return strcspn(&req->cmd[prefix_len], "\r\n") / 2;
 }
 
 /**
- * @brief RTCM fragment 재조립 버퍼 초기화
- */
-static void rtcm_reassembly_reset(rtcm_reassembly_t *reasm)
-{
-  reasm->buffer_pos = 0;
-  reasm->expected_len = 0;
-  reasm->has_header = false;
-  reasm->last_recv_tick = 0;
-}
-
-/**
- * @brief RTCM fragment 처리 및 재조립 (개선된 버전)
- *
- * - Preamble(0xD3) 자동 탐색
- * - 완료 후 남은 데이터 자동 보존
+ * @brief P2P 전송 한 건의 응답 결과를 통계에 반영
  *
- * @param reasm 재조립 버퍼
- * @param data 수신된 fragment 데이터
- * @param len fragment 길이
- * @return true: 완전한 RTCM 패킷 재조립 완료, false: 더 많은 fragment 필요
+ * OK 지연을 ToA 와 나란히 기록해 실제 모듈에서 OK 가 TX 완료 뒤에 오는지
+ * (early_ok == 0) 와 ToA 외 처리 시간이 얼마인지 확인할 수 있게 한다.
  */
-static bool rtcm_reassembly_process(rtcm_reassembly_t *reasm, const uint8_t *data, size_t len)
+static void lora_tx_stats_record(size_t len, bool responded, bool ok,
+                                 uint32_t resp_ms, uint32_t toa_ms)
 {
-  TickType_t current_tick = xTaskGetTickCount();
+  lora_tx_stats_t *st = &instance.tx_stats;
 
-  // 타임아웃 체크 (마지막 수신 후 5초 경과 시 초기화)
-  if (reasm->buffer_pos > 0 && reasm->last_recv_tick > 0)
+  taskENTER_CRITICAL();
+  st->sent++;
+  if (!responded)
   {
-    TickType_t elapsed_ms = (current_tick - reasm->last_recv_tick) * 1000 / configTICK_RATE_HZ;
-    if (elapsed_ms > RTCM_REASSEMBLY_TIMEOUT_MS)
-    {
-      LOG_WARN("RTCM reassembly timeout - resetting buffer");
-      rtcm_reassembly_reset(reasm);
-    }
+    st->timeout++;
   }
-
-  // 버퍼 오버플로우 체크
-  if (reasm->buffer_pos + len > RTCM_REASSEMBLY_BUF_SIZE)
+  else if (!ok)
   {
-    LOG_ERR("RTCM reassembly buffer overflow - resetting");
-    rtcm_reassembly_reset(reasm);
-    return false;
+    st->error++;
   }
-
-  // Fragment 데이터 추가
-  memcpy(&reasm->buffer[reasm->buffer_pos], data, len);
-  reasm->buffer_pos += len;
-  reasm->last_recv_tick = current_tick;
-
-  LOG_INFO("RTCM fragment received: %d bytes, total: %d bytes", len, reasm->buffer_pos);
-
-  // 헤더가 없으면 Preamble 스캔
-  if (!reasm->has_header)
+  else
   {
-    // 0xD3(Preamble)를 찾을 때까지 스캔
-    size_t preamble_pos = 0;
-    bool found = false;
-
-    for (size_t i = 0; i < reasm->buffer_pos; i++)
+    st->ok++;
+    st->ok_ms_sum += resp_ms;
+    st->ok_ms_last = resp_ms;
+    if (resp_ms > st->ok_ms_max)
     {
-      if (reasm->buffer[i] == 0xD3)
-      {
-        preamble_pos = i;
-        found = true;
-        LOG_INFO("RTCM preamble found at offset %d", i);
-        break;
-      }
+      st->ok_ms_max = resp_ms;
     }
-
-    if (!found)
+    if (resp_ms < toa_ms)
     {
-      // Preamble을 못 찾으면 마지막 바이트만 남기고 버림
-      // (다음 fragment에서 0xD3가 올 수 있음)
-      if (reasm->buffer_pos > 1)
-      {
-        LOG_WARN("No preamble found, keeping last byte");
-        reasm->buffer[0] = reasm->buffer[reasm->buffer_pos - 1];
-        reasm->buffer_pos = 1;
-      }
-      return false;
+      st->early_ok++;
     }
-
-    // Preamble이 중간에 있으면 앞으로 이동
-    if (preamble_pos > 0)
+    else if (resp_ms - toa_ms > st->ok_excess_ms_max)
     {
-      LOG_INFO("Moving preamble from offset %d to start", preamble_pos);
-      memmove(reasm->buffer, &reasm->buffer[preamble_pos], reasm->buffer_pos - preamble_pos);
-      reasm->buffer_pos -= preamble_pos;
+      st->ok_excess_ms_max = resp_ms - toa_ms;
     }
-
-    // 헤더 파싱 시도 (최소 3바이트 필요: preamble + reserved+len)
-    if (reasm->buffer_pos >= 3)
+    if (len == LORA_P2P_RAW_MAX && resp_ms > st->ok_full_ms_max)
     {
-      // Payload 길이 파싱 (10 bits)
-      uint16_t payload_len = ((reasm->buffer[1] & 0x03) << 8) | reasm->buffer[2];
-      reasm->expected_len = 3 + payload_len + 3; // header(3) + payload + CRC(3)
-      reasm->has_header = true;
-
-      LOG_INFO("RTCM header parsed: payload=%d bytes, expected total=%d bytes",
-               payload_len, reasm->expected_len);
-
-      // 예상 길이가 비정상적으로 크면 리셋
-      if (reasm->expected_len > RTCM_REASSEMBLY_BUF_SIZE)
-      {
-        LOG_ERR("Invalid RTCM length: %d > %d - resetting",
-                reasm->expected_len, RTCM_REASSEMBLY_BUF_SIZE);
-        rtcm_reassembly_reset(reasm);
-        return false;
-      }
+      st->ok_full_ms_max = resp_ms;
     }
   }
-
-  // 완전한 패킷 수신 체크
-  if (reasm->has_header && reasm->buffer_pos >= reasm->expected_len)
-  {
-    LOG_INFO("RTCM packet reassembly complete: %d bytes (buffer has %d bytes)",
-             reasm->expected_len, reasm->buffer_pos);
-    return true;
-  }
-
-  // 더 많은 fragment 필요
-  return false;
+  taskEXIT_CRITICAL();
 }
 
 /**
- * @brief AT+RECV 응답 파싱
+ * @brief UART 로 보낼 AT 프레임 준비
  *
- * Format: at+recv=<RSSI>,<SNR>,<Data Length>:<Data>
- * Example: at+recv=-50,10,5:48656C6C6F
+ * binary payload 요청은 at+send=lorap2p:<HEX>\r\n 으로 바꾸고, 그 밖의 명령어는 그대로 쓴다.
  *
- * @param data 응답 데이터
- * @param recv_data 출력 구조체
- * @return true: 파싱 성공, false: 파싱 실패
+ * @param frame 최소 LORA_TX_FRAME_SIZE
+ * @return 보낼 프레임
  */
-static bool lora_parse_p2p_recv(const char *data, lora_p2p_recv_data_t *recv_data)
+static const char *lora_tx_build_frame(const lora_cmd_request_t *req, char *frame,
+                                       size_t *len)
 {
-  // "at+recv=" 또는 "AT+RECV=" 찾기
-  const char *start = strstr(data, "at+recv=");
-  if (!start)
-  {
-    start = strstr(data, "AT+RECV=");
-  }
-  if (!start)
-  {
-    return false;
-  }
+  static const char hex[] = "0123456789ABCDEF";
+  const size_t prefix_len = sizeof(LORA_P2P_SEND_PREFIX) - 1;
 
-  start += 8; // "at+recv=" 건너뛰기
-
-  // RSSI 파싱
-  char *end = NULL;
-  recv_data->rssi = (int16_t)strtol(start, &end, 10);
-  if (!end || *end != ',')
+  if (req->raw_len == 0)
   {
-    return false;
+    *len = strlen(req->cmd);
+    return req->cmd;
   }
 
-  // SNR 파싱
-  start = end + 1;
-  recv_data->snr = (int16_t)strtol(start, &end, 10);
-  if (!end || *end != ',')
+  char *p = frame;
+  memcpy(p, LORA_P2P_SEND_PREFIX, prefix_len);
+  p += prefix_len;
+  for (uint8_t i = 0; i < req->raw_len; i++)
   {
-    return false;
+    uint8_t b = (uint8_t)req->cmd[i];
+    *p++ = hex[b >> 4];
+    *p++ = hex[b & 0x0F];
   }
+  *p++ = '\r';
+  *p++ = '\n';
+  *p = '\0';
 
-  // Data Length 파싱
-  start = end + 1;
-  recv_data->data_len = (uint16_t)strtol(start, &end, 10);
-  if (!end || *end != ':')
-  {
-    return false;
-  }
-
-  // Data 파싱 (HEX string)
-  start = end + 1;
+  *len = p - frame;
+  return frame;
+}
 
-  // 데이터 길이 확인
-  if (recv_data->data_len > sizeof(recv_data->data) - 1)
+/**
+ * @brief 명령어 처리 완료 (비동기: 콜백, 동기: 호출자 세마포어)
+ */
+static void lora_tx_complete(lora_cmd_request_t *cmd_req)
+{
+  if (cmd_req->is_async)
   {
-    LOG_ERR("P2P recv data too long: %d bytes", recv_data->data_len);
-    return false;
+    if (cmd_req->callback)
+    {
+      cmd_req->callback(cmd_req->async_result, cmd_req->user_data);
+    }
   }
-
-  // HEX string을 바이너리로 변환
-  for (uint16_t i = 0; i < recv_data->data_len; i++)
+  else
   {
-    char hex[3] = {start[i * 2], start[i * 2 + 1], '\0'};
-    recv_data->data[i] = (char)strtol(hex, NULL, 16);
+    // 동기: 외부 호출자에게 처리 완료 알림 (세마포어 반환)
+    xSemaphoreGive(cmd_req->response_sem);
   }
-  recv_data->data[recv_data->data_len] = '\0';
-
-  LOG_INFO("P2P recv: RSSI=%d, SNR=%d, Len=%d",
-           recv_data->rssi, recv_data->snr, recv_data->data_len);
-
-  return true;
 }
 
 /**
  * @brief LoRa TX Task (명령어 송신 및 응답 대기)
+ *
+ * 모듈이 한 프레임을 내보내는 동안 다음 요청을 큐에서 꺼내 AT 프레임을 미리 만들어 두고,
+ * 모듈의 응답 (at+send=lorap2p 는 무선 전송이 끝난 뒤 OK) 을 받는 즉시 다음 프레임을 보낸다.
+ * 응답이 오지 않으면 요청의 timeout_ms (P2P 전송은 ToA 기반) 가 지나서 실패로 넘어간다.
  */
 static void lora_tx_task(void *pvParameter)
 {
-  lora_cmd_request_t cmd_req;
+  static char frame_buf[2][LORA_TX_FRAME_SIZE];
+  lora_cmd_request_t req[2];
+  const char *frame[2];
+  size_t frame_len[2];
+  uint8_t cur = 0;
+  bool have_next = false;
 
   LOG_INFO("LoRa TX Task started");
 
@@ -588,151 +499,398 @@ static void lora_tx_task(void *pvParameter)
 
   while (1)
   {
-    if (xQueueReceive(instance.cmd_queue, &cmd_req, portMAX_DELAY) == pdTRUE)
+    if (!have_next)
     {
-      if(config->lora_mode == LORA_MODE_BASE && instance.init_complete)
+      if (xQueueReceive(instance.cmd_queue, &req[cur], portMAX_DELAY) != pdTRUE)
       {
-        led_set_toggle(3);
+        continue;
       }
-      LOG_INFO("LoRa sending command: %s", cmd_req.cmd);
+      frame[cur] = lora_tx_build_frame(&req[cur], frame_buf[cur], &frame_len[cur]);
+    }
+    have_next = false;
 
-      // 현재 명령어 요청 저장 (RX Task에서 응답 처리용)
-      instance.current_cmd_req = &cmd_req;
-      if (cmd_req.is_async)
-      {
-        cmd_req.async_result = false;
-      }
-      else
-      {
-        *(cmd_req.result) = false;
-      }
+    lora_cmd_request_t *cmd_req = &req[cur];
+
+    if(config->lora_mode == LORA_MODE_BASE && instance.init_complete)
+    {
+      led_set_toggle(3);
+    }
+    if (cmd_req->raw_len > 0)
+    {
+      LOG_DEBUG("LoRa sending P2P frame: %d bytes", cmd_req->raw_len);
+    }
+    else
+    {
+      LOG_INFO("LoRa sending command: %s", cmd_req->cmd);
+    }
+
+    // 현재 명령어 요청 저장 (RX Task에서 응답 처리용)
+    instance.current_cmd_req = cmd_req;
+    if (cmd_req->is_async)
+    {
+      cmd_req->async_result = false;
+    }
+    else
+    {
+      *(cmd_req->result) = false;
+    }
+
+    // 시작 시간 기록 (ToA 계산용)
+    TickType_t start_tick = xTaskGetTickCount();
+
+    // 앞 명령어의 타임아웃 뒤에 늦게 온 응답 알림 제거
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    // 명령어 전송 (UART 충돌 방지를 위해 mutex 사용)
+    if (instance.lora.ops && instance.lora.ops->send)
+    {
+      xSemaphoreTake(instance.mutex, portMAX_DELAY);
+      instance.lora.ops->send(frame[cur], frame_len[cur]);
+      xSemaphoreGive(instance.mutex);
+    }
+    else
+    {
+      LOG_ERR("LoRa send ops not available");
+      instance.current_cmd_req = NULL;
+      lora_tx_complete(cmd_req);
+      continue;
+    }
+
+    // 모듈이 전송하는 동안 다음 요청의 AT 프레임을 미리 만든다
+    // (다음 명령어는 OK 뒤에 보낸다. OK 가 TX 완료 뒤에 오는지는 early_ok 로 확인)
+    uint8_t next = cur ^ 1;
+    if (xQueueReceive(instance.cmd_queue, &req[next], 0) == pdTRUE)
+    {
+      frame[next] = lora_tx_build_frame(&req[next], frame_buf[next], &frame_len[next]);
+      have_next = true;
+    }
+
+    bool responded = false;
+    uint32_t resp_ms = 0;
 
-      // 시작 시간 기록 (ToA 계산용)
-      TickType_t start_tick = xTaskGetTickCount();
+    // skip_response이면 응답 파싱 건너뛰고 delay 후 성공 처리
+    if (cmd_req->skip_response)
+    {
+      LOG_INFO("Skipping response check, waiting %d ms", cmd_req->timeout_ms);
+      vTaskDelayUntil(&start_tick, pdMS_TO_TICKS(cmd_req->timeout_ms));
 
-      // 명령어 전송 (UART 충돌 방지를 위해 mutex 사용)
-      if (instance.lora.ops && instance.lora.ops->send)
+      // 성공으로 처리
+      if (cmd_req->is_async)
       {
-        xSemaphoreTake(instance.mutex, portMAX_DELAY);
-        instance.lora.ops->send(cmd_req.cmd, strlen(cmd_req.cmd));
-        xSemaphoreGive(instance.mutex);
+        cmd_req->async_result = true;
       }
       else
       {
-        LOG_ERR("LoRa send ops not available");
-        instance.current_cmd_req = NULL;
-        if (cmd_req.is_async)
-        {
-          cmd_req.async_result = false;
-          if (cmd_req.callback)
-          {
-            cmd_req.callback(false, cmd_req.user_data);
-          }
-          vSemaphoreDelete(cmd_req.response_sem);
-        }
-        else
-        {
-          *(cmd_req.result) = false;
-          xSemaphoreGive(cmd_req.response_sem);
-        }
-        continue;
+        *(cmd_req->result) = true;
       }
+    }
+    else
+    {
+      // 응답 대기 (타임아웃은 전송 시작부터, 다음 프레임 준비 시간 포함)
+      TickType_t waited = xTaskGetTickCount() - start_tick;
+      TickType_t timeout = pdMS_TO_TICKS(cmd_req->timeout_ms);
+      timeout = waited < timeout ? timeout - waited : 0;
 
-      // skip_response이면 응답 파싱 건너뛰고 delay 후 성공 처리
-      if (cmd_req.skip_response)
+      if (ulTaskNotifyTake(pdTRUE, timeout) > 0)
       {
-        LOG_INFO("Skipping response check, waiting %d ms", cmd_req.timeout_ms);
-        vTaskDelay(pdMS_TO_TICKS(cmd_req.timeout_ms));
-
-        // 성공으로 처리
-        if (cmd_req.is_async)
+        // 응답 수신 완료 (RX Task가 알림)
+        responded = true;
+        resp_ms = (xTaskGetTickCount() - start_tick) * portTICK_PERIOD_MS;
+        if (cmd_req->is_async)
         {
-          cmd_req.async_result = true;
+          LOG_DEBUG("LoRa response received: %s",
+                    cmd_req->async_result ? "OK" : "ERROR");
         }
         else
         {
-          *(cmd_req.result) = true;
+          LOG_INFO("LoRa response received: %s",
+                   *(cmd_req->result) ? "OK" : "ERROR");
         }
-      }
-      else
-      {
-        // 응답 대기 (타임아웃 적용)
-        if (xSemaphoreTake(cmd_req.response_sem, pdMS_TO_TICKS(cmd_req.timeout_ms)) == pdTRUE)
+
+        // ToA 대기: AT 명령어 전송 시작 시점부터 ToA 경과 보장
+        if (cmd_req->toa_ms > 0)
         {
-          // 응답 수신 완료 (RX Task가 세마포어를 줌)
-          if (cmd_req.is_async)
+          TickType_t elapsed_tick = xTaskGetTickCount() - start_tick;
+          uint32_t elapsed_ms = elapsed_tick * 1000 / configTICK_RATE_HZ;
+
+          if (elapsed_ms < cmd_req->toa_ms)
           {
-            LOG_INFO("LoRa response received: %s",
-                     cmd_req.async_result ? "OK" : "ERROR");
+            uint32_t remaining_ms = cmd_req->toa_ms - elapsed_ms;
+            LOG_INFO("Waiting remaining ToA %dms (elapsed=%dms, total=%dms)",
+                     remaining_ms, elapsed_ms, cmd_req->toa_ms);
+            vTaskDelay(pdMS_TO_TICKS(remaining_ms));
           }
           else
           {
-            LOG_INFO("LoRa response received: %s",
-                     *(cmd_req.result) ? "OK" : "ERROR");
-          }
-
-          // ToA 대기: AT 명령어 전송 시작 시점부터 ToA 경과 보장
-          if (cmd_req.toa_ms > 0)
-          {
-            TickType_t elapsed_tick = xTaskGetTickCount() - start_tick;
-            uint32_t elapsed_ms = elapsed_tick * 1000 / configTICK_RATE_HZ;
-
-            if (elapsed_ms < cmd_req.toa_ms)
-            {
-              uint32_t remaining_ms = cmd_req.toa_ms - elapsed_ms;
-              LOG_INFO("Waiting remaining ToA %dms (elapsed=%dms, total=%dms)",
-                       remaining_ms, elapsed_ms, cmd_req.toa_ms);
-              vTaskDelay(pdMS_TO_TICKS(remaining_ms));
-            }
-            else
-            {
-              LOG_INFO("ToA already satisfied: elapsed=%dms >= ToA=%dms",
-                       elapsed_ms, cmd_req.toa_ms);
-            }
+            LOG_INFO("ToA already satisfied: elapsed=%dms >= ToA=%dms",
+                     elapsed_ms, cmd_req->toa_ms);
           }
         }
+      }
+      else
+      {
+        // 타임아웃
+        LOG_WARN("LoRa command timeout");
+        if (cmd_req->is_async)
+        {
+          cmd_req->async_result = false;
+        }
         else
         {
-          // 타임아웃
-          LOG_WARN("LoRa command timeout");
-          if (cmd_req.is_async)
-          {
-            cmd_req.async_result = false;
-          }
-          else
-          {
-            *(cmd_req.result) = false;
-          }
+          *(cmd_req->result) = false;
         }
       }
+    }
 
-      // 현재 명령어 요청 초기화
-      instance.current_cmd_req = NULL;
+    // 현재 명령어 요청 초기화
+    instance.current_cmd_req = NULL;
+    instance.tx_busy_ms +=
+        (xTaskGetTickCount() - start_tick) * 1000 / configTICK_RATE_HZ;
 
-      // 비동기: 콜백 호출
-      if (cmd_req.is_async)
-      {
-        if (cmd_req.callback)
-        {
-          cmd_req.callback(cmd_req.async_result, cmd_req.user_data);
-        }
+    // P2P 전송이면 응답과 관계없이 모듈이 내보낸 것으로 보고 airtime 기록
+    size_t air_len = lora_cmd_air_len(cmd_req);
+    if (air_len > 0)
+    {
+      uint32_t toa_ms = lora_p2p_toa_ms(air_len);
+      taskENTER_CRITICAL();
+      lora_airtime_add(&instance.airtime, start_tick * portTICK_PERIOD_MS, toa_ms);
+      taskEXIT_CRITICAL();
 
-        // 비동기는 세마포어를 TX Task에서 삭제
-        vSemaphoreDelete(cmd_req.response_sem);
-      }
-      else
+      if (!cmd_req->skip_response)
       {
-        // 동기: 외부 호출자에게 처리 완료 알림 (세마포어 반환)
-        xSemaphoreGive(cmd_req.response_sem);
+        bool ok = cmd_req->is_async ? cmd_req->async_result : *(cmd_req->result);
+        lora_tx_stats_record(air_len, responded, ok, resp_ms, toa_ms);
       }
     }
+
+    lora_tx_complete(cmd_req);
+
+    if (have_next)
+    {
+      cur = next;
+    }
   }
 
   vTaskDelete(NULL);
 }
 
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+/**
+ * @brief 캐시된 스테이션 메시지 중 주기가 된 것을 GPS 로 다시 전송
+ *
+ * 수신 RTCM 과 같은 RX Task 에서 보내므로 GPS UART 에 프레임이 섞이지 않는다.
+ */
+static void lora_station_inject(void)
+{
+  uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+  const uint8_t *frame;
+  size_t len;
+
+  while ((frame = rtcm_station_cache_due(&instance.station_cache, now_ms, &len)) != NULL)
+  {
+    LOG_DEBUG("Re-injecting cached station message: %d bytes", len);
+    if (!gps_send_raw_data(GPS_ID_BASE, frame, len))
+    {
+      LOG_ERR("Failed to inject station message to GPS");
+    }
+  }
+}
+#endif
+
+#if defined(USE_GPS_RTCM_FEC)
+/**
+ * @brief FEC 블록 패킷 처리
+ *
+ * 블록이 완성되거나 parity 로 복구되면 안의 RTCM 프레임을 하나씩 검증해 GPS 로 보낸다.
+ */
+static void lora_rtcm_fec_process(const uint8_t *data, size_t len)
+{
+  __attribute__((section(".ccmram"))) static uint8_t block[RTCM_FEC_OUT_MAX];
+  size_t block_len = rtcm_fec_rx_push(&instance.rtcm_fec, data, len, block, sizeof(block));
+  size_t off = 0;
+
+  while (off + 6 <= block_len)
+  {
+    size_t frame_len = (((block[off + 1] & 0x03) << 8) | block[off + 2]) + 6;
+
+    if (block[off] != 0xD3 || off + frame_len > block_len ||
+        !rtcm_validate_packet(&block[off], frame_len))
+    {
+      LOG_ERR("Invalid RTCM frame in FEC block - discarding rest");
+      break;
+    }
+
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+    rtcm_station_cache_put(&instance.station_cache, &block[off], frame_len,
+                           xTaskGetTickCount() * portTICK_PERIOD_MS);
+#endif
+
+    if (!gps_send_raw_data(GPS_ID_BASE, &block[off], frame_len))
+    {
+      LOG_ERR("Failed to send RTCM data to GPS");
+    }
+    off += frame_len;
+  }
+
+  if (block_len)
+  {
+    const rtcm_fec_rx_stats_t *st = &instance.rtcm_fec.stats;
+    LOG_INFO("RTCM FEC block: %d bytes (ok=%lu recovered=%lu partial=%lu lost=%lu)",
+             block_len, st->blocks_ok, st->blocks_recovered, st->blocks_partial,
+             st->blocks_lost);
+  }
+}
+#endif
+
+/**
+ * @brief 수신한 RTCM payload 처리
+ *
+ * FEC 블록 패킷 (기지국 USE_GPS_RTCM_FEC) 은 블록 단위로 복구, 그 밖에는 링 재조립기에 넣고
+ * 완성된 프레임을 모두 GPS 로 보낸다.
+ *
+ * data 는 줄 조립기의 data[] 다. HEX 오류와 길이는 줄 끝에서야 확정되고 FEC 패킷과
+ * 수신 콜백은 패킷 전체가 연속으로 필요하므로, 링에 바로 풀지 않고 검증된 패킷만
+ * 한 번 복사한다 (최대 255 byte, 링크 속도상 초당 몇 번). 프레임은 링에서 바로 보낸다.
+ */
+static void lora_rtcm_rx(const uint8_t *data, size_t len)
+{
+  const uint8_t *frame;
+  size_t frame_len;
+
+  if (rtcm_fec_is_packet(data, len))
+  {
+#if defined(USE_GPS_RTCM_FEC)
+    lora_rtcm_fec_process(data, len);
+#else
+    // FEC 를 켠 기지국의 패킷: 재조립기에 섞이지 않도록 통째로 버린다
+    LOG_DEBUG("RTCM FEC packet ignored (FEC disabled): %d bytes", len);
+#endif
+    return;
+  }
+
+  rtcm_reasm_push(&instance.rtcm_reasm, data, len, xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+  // 한 fragment 에 여러 프레임의 끝이 들어 있을 수 있으므로 모두 꺼냄
+  while ((frame_len = rtcm_reasm_pop(&instance.rtcm_reasm, &frame)) > 0)
+  {
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+    rtcm_station_cache_put(&instance.station_cache, frame, frame_len,
+                           xTaskGetTickCount() * portTICK_PERIOD_MS);
+#endif
+
+    // GPS UART로 직접 전송
+    if (!gps_send_raw_data(GPS_ID_BASE, frame, frame_len))
+    {
+      LOG_ERR("Failed to send RTCM data to GPS");
+    }
+  }
+
+  LOG_DEBUG("RTCM reasm: frames=%lu resync=%lu crc_fail=%lu partial=%lu pending=%d",
+            instance.rtcm_reasm.stats.frames, instance.rtcm_reasm.stats.resyncs,
+            instance.rtcm_reasm.stats.crc_fail, instance.rtcm_reasm.stats.partial_drops,
+            rtcm_reasm_pending(&instance.rtcm_reasm));
+}
+
+/**
+ * @brief 조립이 끝난 한 줄 처리
+ */
+static void lora_rx_line(lora_line_type_t type)
+{
+  lora_line_t *line = &instance.rx_line;
+
+  switch (type)
+  {
+  case LORA_LINE_OK:
+  case LORA_LINE_ERROR:
+    // AT 명령어 응답 처리
+    if (instance.current_cmd_req == NULL)
+    {
+      LOG_DEBUG("current_cmd_req is NULL, skipping response handling");
+      break;
+    }
+
+    // 응답 결과 저장
+    if (instance.current_cmd_req->is_async)
+    {
+      instance.current_cmd_req->async_result = (type == LORA_LINE_OK);
+    }
+    else
+    {
+      *(instance.current_cmd_req->result) = (type == LORA_LINE_OK);
+    }
+
+    // TX Task로 응답 완료 알림 (P2P 전송은 무선 전송 완료)
+    xTaskNotifyGive(instance.tx_task);
+    break;
+
+  case LORA_LINE_RECV:
+    // P2P 수신 데이터 처리 (at+recv=...)
+    // 초기화 완료 후에만 처리 (초기화 중 데이터는 무시)
+    if (!instance.init_complete)
+    {
+      LOG_WARN("Ignoring P2P data during initialization");
+      break;
+    }
+
+    if (board_get_config()->lora_mode == LORA_MODE_ROVER)
+    {
+      led_set_toggle(3);
+    }
+
+    LOG_DEBUG("P2P recv: RSSI=%d, SNR=%d, Len=%d",
+              line->rssi, line->snr, line->data_len);
+
+    // 콜백이 등록되어 있으면 콜백 호출, 없으면 RTCM fragment 재조립 및 GPS로 전송
+    if (instance.p2p_recv_callback)
+    {
+      lora_p2p_recv_data_t recv_data;
+
+      recv_data.rssi = line->rssi;
+      recv_data.snr = line->snr;
+      recv_data.data_len = line->data_len;
+      memcpy(recv_data.data, line->data, line->data_len);
+      recv_data.data[line->data_len] = '\0';
+      instance.p2p_recv_callback(&recv_data, instance.p2p_recv_user_data);
+    }
+    else
+    {
+      lora_rtcm_rx(line->data, line->data_len);
+    }
+    break;
+
+  case LORA_LINE_RECV_BAD:
+    LOG_WARN("Malformed P2P recv line (bad=%d)", line->stats.recv_bad);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief 수신 바이트를 줄 조립기에 넣고 끝난 줄마다 처리
+ */
+static void lora_rx_feed(const char *buf, size_t len)
+{
+  while (len > 0)
+  {
+    lora_line_type_t type;
+    size_t used = lora_line_feed(&instance.rx_line, buf, len, &type);
+
+    buf += used;
+    len -= used;
+    if (type != LORA_LINE_NONE)
+    {
+      lora_rx_line(type);
+    }
+  }
+}
+
 /**
  * @brief LoRa RX Task (수신 데이터 처리)
+ *
+ * DMA 수신 링 버퍼의 새 구간을 복사 없이 줄 조립기에 넣는다. 한 줄이 여러 idle 이벤트에
+ * 걸쳐 와도 조립기가 상태를 이어 간다.
  */
 static void lora_process_task(void *pvParameter)
 {
@@ -740,7 +898,6 @@ static void lora_process_task(void *pvParameter)
   size_t old_pos = 0;
   uint8_t dummy = 0;
 
-  __attribute__((section(".ccmram"))) static char temp_buf[1024];
   LOG_INFO("LoRa RX Task started");
 
   // RX Task 준비 완료 플래그 설정
@@ -770,252 +927,35 @@ static void lora_process_task(void *pvParameter)
 
   while (1)
   {
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+    xQueueReceive(instance.queue, &dummy, pdMS_TO_TICKS(LORA_STATION_POLL_MS));
+    lora_station_inject();
+#else
     xQueueReceive(instance.queue, &dummy, portMAX_DELAY);
+#endif
 
     pos = lora_port_get_rx_pos();
     char *lora_recv = lora_port_get_recv_buf();
 
-    if (pos != old_pos)
+    if (pos == old_pos)
     {
-      size_t len = 0;
-
-      if (pos > old_pos)
-      {
-        len = pos - old_pos;
-
-        // 데이터 처리
-        memcpy(temp_buf, &lora_recv[old_pos], len);
-        temp_buf[len] = '\0';
-
-        // AT 명령어 응답 처리
-        if (instance.current_cmd_req != NULL)
-        {
-          bool result = lora_parse_at_response(temp_buf, len);
-          LOG_INFO("Parse result: %s", result ? "OK" : "ERROR/NONE");
-
-          if (strstr(temp_buf, "OK") || strstr(temp_buf, "ERROR"))
-          {
-            // 응답 결과 저장
-            if (instance.current_cmd_req->is_async)
-            {
-              instance.current_cmd_req->async_result = result;
-            }
-            else
-            {
-              *(instance.current_cmd_req->result) = result;
-            }
-
-            // 세마포어 해제 (TX Task로 응답 완료 알림)
-            xSemaphoreGive(instance.current_cmd_req->response_sem);
-          }
-          else
-          {
-            LOG_WARN("No OK/ERROR in response");
-          }
-        }
-        else
-        {
-          LOG_WARN("current_cmd_req is NULL, skipping response handling");
-        }
-
-        // P2P 수신 데이터 처리 (at+recv=...)
-        // 초기화 완료 후에만 처리 (초기화 중 데이터는 무시)
-
-        if ((strstr(temp_buf, "at+recv=") || strstr(temp_buf, "AT+RECV=")) && instance.init_complete)
-        {
-          if(config->lora_mode == LORA_MODE_ROVER)
-          {
-            led_set_toggle(3);
-          }
-
-          lora_p2p_recv_data_t recv_data;
-
-          if (lora_parse_p2p_recv(temp_buf, &recv_data))
-          {
-            // 콜백이 등록되어 있으면 콜백 호출
-            if (instance.p2p_recv_callback)
-            {
-              instance.p2p_recv_callback(&recv_data, instance.p2p_recv_user_data);
-            }
-            else
-            {
-              // 콜백이 없으면 RTCM fragment 재조립 및 GPS로 전송
-              LOG_INFO("P2P data received: %d bytes, RSSI=%d, SNR=%d",
-                       recv_data.data_len, recv_data.rssi, recv_data.snr);
-
-              // RTCM fragment 재조립
-              bool complete = rtcm_reassembly_process(&instance.rtcm_reassembly,
-                                                      (uint8_t *)recv_data.data,
-                                                      recv_data.data_len);
-
-              if (complete)
-              {
-                // 완전한 RTCM 패킷 수신 - 검증 후 GPS로 전송
-                if (rtcm_validate_packet(instance.rtcm_reassembly.buffer,
-                                        instance.rtcm_reassembly.expected_len))
-                {
-                  LOG_INFO("Valid RTCM packet - sending to GPS via UART");
-
-                  // GPS UART로 직접 전송
-                  if (!gps_send_raw_data(GPS_ID_BASE,
-                                         instance.rtcm_reassembly.buffer,
-                                         instance.rtcm_reassembly.expected_len))
-                  {
-                    LOG_ERR("Failed to send RTCM data to GPS");
-                  }
-                }
-                else
-                {
-                  LOG_ERR("Invalid RTCM packet - discarding");
-                }
-
-                // 남은 데이터 처리 (다음 RTCM 패킷의 시작일 수 있음)
-                if (instance.rtcm_reassembly.buffer_pos > instance.rtcm_reassembly.expected_len)
-                {
-                  size_t remaining = instance.rtcm_reassembly.buffer_pos - instance.rtcm_reassembly.expected_len;
-                  LOG_INFO("Remaining %d bytes in buffer - moving to front", remaining);
-
-                  // 남은 데이터를 버퍼 앞으로 이동
-                  memmove(instance.rtcm_reassembly.buffer,
-                          &instance.rtcm_reassembly.buffer[instance.rtcm_reassembly.expected_len],
-                          remaining);
-                  instance.rtcm_reassembly.buffer_pos = remaining;
-                  instance.rtcm_reassembly.has_header = false;
-                  instance.rtcm_reassembly.expected_len = 0;
-
-                  // 남은 데이터로 다음 패킷 시작 시도
-                  // (재귀 호출 대신 다음 수신에서 처리됨)
-                }
-                else
-                {
-                  // 남은 데이터가 없으면 완전히 초기화
-                  rtcm_reassembly_reset(&instance.rtcm_reassembly);
-                }
-              }
-            }
-          }
-        }
-        else if ((strstr(temp_buf, "at+recv=") || strstr(temp_buf, "AT+RECV=")) && !instance.init_complete)
-        {
-          LOG_WARN("Ignoring P2P data during initialization");
-        }
-
-        old_pos = pos;
-      }
-      else
-      {
-        // Circular buffer wrap-around
-        len = LORA_RECV_BUF_SIZE - old_pos + pos;
-
-        size_t first_part = LORA_RECV_BUF_SIZE - old_pos;
-        memcpy(temp_buf, &lora_recv[old_pos], first_part);
-        memcpy(&temp_buf[first_part], &lora_recv[0], pos);
-        temp_buf[len] = '\0';
-
-        LOG_INFO("LoRa recv (wrap): %s", temp_buf);
-
-        // 동일한 처리 로직
-        if (instance.current_cmd_req != NULL)
-        {
-          bool result = lora_parse_at_response(temp_buf, len);
-
-          if (strstr(temp_buf, "OK") || strstr(temp_buf, "ERROR"))
-          {
-            if (instance.current_cmd_req->is_async)
-            {
-              instance.current_cmd_req->async_result = result;
-            }
-            else
-            {
-              *(instance.current_cmd_req->result) = result;
-            }
-
-            xSemaphoreGive(instance.current_cmd_req->response_sem);
-          }
-        }
-
-        if ((strstr(temp_buf, "at+recv=") || strstr(temp_buf, "AT+RECV=")) && instance.init_complete)
-        {
-          if(config->lora_mode == LORA_MODE_ROVER)
-          {
-            led_set_toggle(3);
-          }
-
-          lora_p2p_recv_data_t recv_data;
-
-          if (lora_parse_p2p_recv(temp_buf, &recv_data))
-          {
-            // 콜백이 등록되어 있으면 콜백 호출
-            if (instance.p2p_recv_callback)
-            {
-              instance.p2p_recv_callback(&recv_data, instance.p2p_recv_user_data);
-            }
-            else
-            {
-              // 콜백이 없으면 RTCM fragment 재조립 및 GPS로 전송
-              LOG_INFO("P2P data received (wrap): %d bytes, RSSI=%d, SNR=%d",
-                       recv_data.data_len, recv_data.rssi, recv_data.snr);
-
-              // RTCM fragment 재조립
-              bool complete = rtcm_reassembly_process(&instance.rtcm_reassembly,
-                                                      (uint8_t *)recv_data.data,
-                                                      recv_data.data_len);
-
-              if (complete)
-              {
-                // 완전한 RTCM 패킷 수신 - 검증 후 GPS로 전송
-                if (rtcm_validate_packet(instance.rtcm_reassembly.buffer,
-                                        instance.rtcm_reassembly.expected_len))
-                {
-                  LOG_INFO("Valid RTCM packet - sending to GPS via UART (wrap)");
-
-                  // GPS UART로 직접 전송
-                  if (!gps_send_raw_data(GPS_ID_BASE,
-                                         instance.rtcm_reassembly.buffer,
-                                         instance.rtcm_reassembly.expected_len))
-                  {
-                    LOG_ERR("Failed to send RTCM data to GPS (wrap)");
-                  }
-                }
-                else
-                {
-                  LOG_ERR("Invalid RTCM packet - discarding (wrap)");
-                }
-
-                // 남은 데이터 처리 (다음 RTCM 패킷의 시작일 수 있음)
-                if (instance.rtcm_reassembly.buffer_pos > instance.rtcm_reassembly.expected_len)
-                {
-                  size_t remaining = instance.rtcm_reassembly.buffer_pos - instance.rtcm_reassembly.expected_len;
-                  LOG_INFO("Remaining %d bytes in buffer - moving to front (wrap)", remaining);
-
-                  // 남은 데이터를 버퍼 앞으로 이동
-                  memmove(instance.rtcm_reassembly.buffer,
-                          &instance.rtcm_reassembly.buffer[instance.rtcm_reassembly.expected_len],
-                          remaining);
-                  instance.rtcm_reassembly.buffer_pos = remaining;
-                  instance.rtcm_reassembly.has_header = false;
-                  instance.rtcm_reassembly.expected_len = 0;
-
-                  // 남은 데이터로 다음 패킷 시작 시도
-                  // (재귀 호출 대신 다음 수신에서 처리됨)
-                }
-                else
-                {
-                  // 남은 데이터가 없으면 완전히 초기화
-                  rtcm_reassembly_reset(&instance.rtcm_reassembly);
-                }
-              }
-            }
-          }
-        }
-        else if ((strstr(temp_buf, "at+recv=") || strstr(temp_buf, "AT+RECV=")) && !instance.init_complete)
-        {
-          LOG_WARN("Ignoring P2P data during initialization (wrap)");
-        }
+      continue;
+    }
 
-        old_pos = pos;
-      }
+    if (pos > old_pos)
+    {
+      capture_write(CAPTURE_SRC_LORA, &lora_recv[old_pos], pos - old_pos);
+      lora_rx_feed(&lora_recv[old_pos], pos - old_pos);
     }
+    else
+    {
+      // Circular buffer wrap-around
+      capture_write(CAPTURE_SRC_LORA, &lora_recv[old_pos], LORA_RECV_BUF_SIZE - old_pos);
+      capture_write(CAPTURE_SRC_LORA, lora_recv, pos);
+      lora_rx_feed(&lora_recv[old_pos], LORA_RECV_BUF_SIZE - old_pos);
+      lora_rx_feed(lora_recv, pos);
+    }
+    old_pos = pos;
   }
 
   vTaskDelete(NULL);
@@ -1026,8 +966,27 @@ void lora_instance_init(void)
   memset(&instance, 0, sizeof(lora_app_instance_t));
   lora_init(&instance.lora);
 
-  // RTCM 재조립 버퍼 초기화
-  rtcm_reassembly_reset(&instance.rtcm_reassembly);
+  // 수신 줄 조립기 / RTCM 재조립 링 초기화
+  lora_line_init(&instance.rx_line);
+  rtcm_reasm_init(&instance.rtcm_reasm, RTCM_REASSEMBLY_TIMEOUT_MS);
+
+#if defined(USE_GPS_RTCM_STATION_CACHE)
+  rtcm_station_cache_init(&instance.station_cache, GPS_RTCM_STATION_INJECT_MS,
+                          GPS_RTCM_STATION_MAX_AGE_MS);
+#endif
+
+#if defined(USE_GPS_RTCM_FEC)
+  rtcm_fec_rx_init(&instance.rtcm_fec);
+#endif
+
+  // lora_p2p_base_cmds / lora_p2p_rover_cmds 와 같은 값 (SF7, BW500kHz, CR4/5, Preamble8)
+  instance.phy.sf = 7;
+  instance.phy.bw = 2;
+  instance.phy.cr = 1;
+  instance.phy.preamble = 8;
+  instance.phy.crc = true;
+  instance.phy.implicit = false;
+  lora_airtime_init(&instance.airtime, LORA_DUTY_CYCLE_PERMILLE);
 
   if (lora_port_init_instance(&instance.lora) != 0)
   {
@@ -1165,21 +1124,13 @@ bool lora_send_command_async(const char *cmd, uint32_t timeout_ms, uint32_t toa_
     return false;
   }
 
-  // 세마포어 생성 (TX Task 내부에서 응답 대기용)
-  SemaphoreHandle_t response_sem = xSemaphoreCreateBinary();
-  if (response_sem == NULL)
-  {
-    LOG_ERR("Failed to create semaphore");
-    return false;
-  }
-
   // 명령어 요청 구조체 생성 (비동기 방식)
   lora_cmd_request_t cmd_req = {
       .timeout_ms = timeout_ms,
       .toa_ms = toa_ms,
       .is_async = true,
       .skip_response = skip_response,
-      .response_sem = response_sem,
+      .response_sem = NULL,
       .result = NULL,
       .callback = callback,
       .user_data = user_data,
@@ -1193,7 +1144,6 @@ bool lora_send_command_async(const char *cmd, uint32_t timeout_ms, uint32_t toa_
   if (xQueueSend(instance.cmd_queue, &cmd_req, pdMS_TO_TICKS(1000)) != pdTRUE)
   {
     LOG_ERR("Failed to send command to TX task");
-    vSemaphoreDelete(response_sem);
     return false;
   }
 
@@ -1216,7 +1166,19 @@ bool lora_set_p2p_config(uint32_t freq, uint8_t sf, uint8_t bw, uint8_t cr,
   snprintf(cmd, sizeof(cmd),
            "at+set_config=lorap2p:%lu:%d:%d:%d:%d:%d\r\n",
            freq, sf, bw, cr, preamlen, pwr);
-  return lora_send_command_sync(cmd, timeout_ms);
+  if (!lora_send_command_sync(cmd, timeout_ms))
+  {
+    return false;
+  }
+
+  // 이후 ToA 계산에 새 설정 반영
+  taskENTER_CRITICAL();
+  instance.phy.sf = sf;
+  instance.phy.bw = bw;
+  instance.phy.cr = cr;
+  instance.phy.preamble = preamlen;
+  taskEXIT_CRITICAL();
+  return true;
 }
 
 bool lora_set_p2p_transfer_mode(lora_p2p_transfer_mode_t mode, uint32_t timeout_ms)
@@ -1239,7 +1201,13 @@ bool lora_send_p2p_data(const char *data, uint32_t timeout_ms)
   return lora_send_command_sync(cmd, timeout_ms);
 }
 
-bool lora_send_p2p_raw(const uint8_t *data, size_t len, uint32_t timeout_ms)
+/**
+ * @brief binary payload 전송 요청 준비
+ *
+ * HEX 변환은 TX Task 가 앞 프레임이 전송되는 동안 한다.
+ */
+static bool lora_p2p_raw_request(lora_cmd_request_t *cmd_req, const uint8_t *data,
+                                 size_t len)
 {
   if (!instance.initialized)
   {
@@ -1254,109 +1222,199 @@ bool lora_send_p2p_raw(const uint8_t *data, size_t len, uint32_t timeout_ms)
   }
 
   // HEX conversion doubles the size, so max binary is 118 bytes (-> 236 HEX chars)
-  if (len > 118)
+  if (len > LORA_P2P_RAW_MAX)
   {
-    LOG_ERR("Data too large: %d > 118 (max binary for HEX ASCII)", len);
+    LOG_ERR("Data too large: %d > %d (max binary for HEX ASCII)", len, LORA_P2P_RAW_MAX);
     return false;
   }
 
-  // Convert binary data to HEX ASCII string
-  // Each byte becomes 2 HEX characters, plus null terminator
-  char hex_string[512];  // 236 * 2 + 1 = 473 bytes max
-  if (len * 2 >= sizeof(hex_string))
+  memcpy(cmd_req->cmd, data, len);
+  cmd_req->raw_len = len;
+  return true;
+}
+
+bool lora_send_p2p_raw(const uint8_t *data, size_t len, uint32_t timeout_ms)
+{
+  bool result = false;
+  lora_cmd_request_t cmd_req = {
+      .timeout_ms = timeout_ms,
+      .is_async = false,
+      .skip_response = false,
+      .result = &result,
+  };
+
+  if (!lora_p2p_raw_request(&cmd_req, data, len))
   {
-    LOG_ERR("HEX string buffer too small");
     return false;
   }
 
-  for (size_t i = 0; i < len; i++)
+  cmd_req.response_sem = xSemaphoreCreateBinary();
+  if (cmd_req.response_sem == NULL)
   {
-    snprintf(&hex_string[i * 2], 3, "%02X", data[i]);
+    LOG_ERR("Failed to create semaphore");
+    return false;
   }
-  hex_string[len * 2] = '\0';
 
-  LOG_INFO("Sending raw P2P data: %d bytes -> %d HEX chars", len, len * 2);
-  if (len >= 4) {
-    LOG_INFO("First 4 bytes (binary): %02X %02X %02X %02X", data[0], data[1], data[2], data[3]);
-    LOG_INFO("First 8 HEX chars: %.8s", hex_string);
-  }
+  LOG_INFO("Sending raw P2P data: %d bytes", len);
 
-  // Create AT command: at+send=lorap2p:<HEX_STRING>\r\n
-  char cmd[600];
-  snprintf(cmd, sizeof(cmd), "at+send=lorap2p:%s\r\n", hex_string);
+  if (xQueueSend(instance.cmd_queue, &cmd_req, pdMS_TO_TICKS(1000)) != pdTRUE)
+  {
+    LOG_ERR("Failed to send command to TX task");
+    vSemaphoreDelete(cmd_req.response_sem);
+    return false;
+  }
 
-  // Use the standard command sending mechanism
-  return lora_send_command_sync(cmd, timeout_ms);
+  if (xSemaphoreTake(cmd_req.response_sem, pdMS_TO_TICKS(timeout_ms + 1000)) != pdTRUE)
+  {
+    LOG_ERR("TX task did not respond");
+    result = false;
+  }
+  vSemaphoreDelete(cmd_req.response_sem);
+  return result;
 }
 
 bool lora_send_p2p_raw_async(const uint8_t *data, size_t len, uint32_t timeout_ms,
                               lora_command_callback_t callback, void *user_data)
 {
-  if (!instance.initialized)
-  {
-    LOG_ERR("LoRa not initialized");
-    return false;
-  }
+  // 모듈이 전송을 마친 뒤 OK 를 주므로 응답 후 추가 대기는 없다 (ToA 는 timeout_ms 에 포함)
+  lora_cmd_request_t cmd_req = {
+      .timeout_ms = timeout_ms,
+      .toa_ms = 0,
+      .is_async = true,
+      .skip_response = false,
+      .callback = callback,
+      .user_data = user_data,
+  };
 
-  if (!data || len == 0)
+  if (!lora_p2p_raw_request(&cmd_req, data, len))
   {
-    LOG_ERR("NULL data or zero length");
     return false;
   }
 
-  // HEX conversion doubles the size, so max binary is 118 bytes (-> 236 HEX chars)
-  if (len > 118)
+  if (xQueueSend(instance.cmd_queue, &cmd_req, pdMS_TO_TICKS(1000)) != pdTRUE)
   {
-    LOG_ERR("Data too large: %d > 118 (max binary for HEX ASCII)", len);
+    LOG_ERR("Failed to send command to TX task");
     return false;
   }
 
-  // Convert binary data to HEX ASCII string
-  // Each byte becomes 2 HEX characters, plus null terminator
-  char hex_string[300];  // 118 * 2 + 1 = 237 bytes max
-  if (len * 2 >= sizeof(hex_string))
-  {
-    LOG_ERR("HEX string buffer too small");
-    return false;
-  }
+  LOG_DEBUG("Raw P2P data queued: %d bytes", len);
+  return true;
+}
 
-  for (size_t i = 0; i < len; i++)
-  {
-    snprintf(&hex_string[i * 2], 3, "%02X", data[i]);
-  }
-  hex_string[len * 2] = '\0';
+void lora_set_p2p_recv_callback(lora_p2p_recv_callback_t callback, void *user_data)
+{
+  instance.p2p_recv_callback = callback;
+  instance.p2p_recv_user_data = user_data;
+}
 
-  LOG_INFO("Sending raw P2P data (async): %d bytes -> %d HEX chars", len, len * 2);
-  if (len >= 4) {
-    LOG_INFO("First 4 bytes (binary): %02X %02X %02X %02X", data[0], data[1], data[2], data[3]);
-  }
+lora_t *lora_get_handle(void)
+{
+  return &instance.lora;
+}
 
-  // Calculate ToA (Time on Air): (bytes / 118) * 350ms * 1.2
-  // uint32_t toa_ms = (len * 350 / 118);  // Base ToA
-  // toa_ms = toa_ms * 12 / 10;  // Add 20% margin (x1.2)
-  // if (toa_ms < 60) {
-  //   toa_ms = 60;  // Minimum ToA
-  // }
+void lora_get_tx_load(lora_tx_load_t *load)
+{
+  load->queue_depth =
+      instance.cmd_queue ? uxQueueMessagesWaiting(instance.cmd_queue) : 0;
+  load->queue_size = LORA_CMD_QUEUE_SIZE;
+  load->busy_ms = instance.tx_busy_ms;
+}
 
-  uint32_t toa_ms = 0;
+uint32_t lora_p2p_toa_ms(size_t len)
+{
+  lora_phy_params_t phy;
 
-  // Create AT command: at+send=lorap2p:<HEX_STRING>\r\n
-  char cmd[300];
-  snprintf(cmd, sizeof(cmd), "at+send=lorap2p:%s\r\n", hex_string);
+  taskENTER_CRITICAL();
+  phy = instance.phy;
+  taskEXIT_CRITICAL();
 
-  // Use async command sending mechanism
-  return lora_send_command_async(cmd, timeout_ms, toa_ms, callback, user_data, false);
+  return (lora_toa_us(&phy, len) + 999) / 1000;
 }
 
-void lora_set_p2p_recv_callback(lora_p2p_recv_callback_t callback, void *user_data)
+uint32_t lora_p2p_send_ms(size_t len)
 {
-  instance.p2p_recv_callback = callback;
-  instance.p2p_recv_user_data = user_data;
+  size_t chars = sizeof(LORA_P2P_SEND_PREFIX) - 1 + len * 2 + 2;
+  uint32_t uart_ms = (chars * 10 * 1000 + LORA_UART_BAUD - 1) / LORA_UART_BAUD;
+  uint32_t model_ms = lora_p2p_toa_ms(len) + uart_ms;
+  uint32_t floor_ms = LORA_P2P_SEND_MEASURED_MS * len / LORA_P2P_RAW_MAX;
+
+  return model_ms > floor_ms ? model_ms : floor_ms;
 }
 
-lora_t *lora_get_handle(void)
+bool lora_p2p_airtime_allow(size_t len)
 {
-  return &instance.lora;
+  uint32_t toa_ms = lora_p2p_toa_ms(len);
+  uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+  bool allow;
+
+  taskENTER_CRITICAL();
+  allow = lora_airtime_allow(&instance.airtime, now_ms, toa_ms);
+  taskEXIT_CRITICAL();
+
+  return allow;
+}
+
+void lora_get_airtime_stats(lora_airtime_stats_t *stats)
+{
+  uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+  taskENTER_CRITICAL();
+  lora_airtime_get(&instance.airtime, now_ms, stats);
+  taskEXIT_CRITICAL();
+}
+
+int lora_format_airtime_stats(char *buf, size_t size)
+{
+  lora_airtime_stats_t st;
+
+  lora_get_airtime_stats(&st);
+
+  return snprintf(buf, size, "%lu,%lu,%u,%u,%u,%lu,%lu,%lu",
+                  (unsigned long)st.minute_ms, (unsigned long)st.hour_ms,
+                  st.minute_permille, st.hour_permille, st.limit_permille,
+                  (unsigned long)st.total_ms, (unsigned long)st.frames,
+                  (unsigned long)st.deferred);
+}
+
+void lora_get_tx_stats(lora_tx_stats_t *stats)
+{
+  taskENTER_CRITICAL();
+  *stats = instance.tx_stats;
+  taskEXIT_CRITICAL();
+}
+
+int lora_format_tx_stats(char *buf, size_t size)
+{
+  lora_tx_stats_t st;
+
+  lora_get_tx_stats(&st);
+
+  return snprintf(buf, size, "%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+                  (unsigned long)st.sent, (unsigned long)st.ok,
+                  (unsigned long)st.error, (unsigned long)st.timeout,
+                  (unsigned long)st.early_ok,
+                  (unsigned long)(st.ok ? st.ok_ms_sum / st.ok : 0),
+                  (unsigned long)st.ok_ms_max,
+                  (unsigned long)st.ok_full_ms_max,
+                  (unsigned long)st.ok_excess_ms_max);
+}
+
+void lora_get_rtcm_rx_stats(rtcm_reasm_stats_t *stats)
+{
+  taskENTER_CRITICAL();
+  *stats = instance.rtcm_reasm.stats;
+  taskEXIT_CRITICAL();
+}
+
+int lora_format_rtcm_rx_stats(char *buf, size_t size)
+{
+  rtcm_reasm_stats_t st;
+
+  lora_get_rtcm_rx_stats(&st);
+
+  return snprintf(buf, size, "%lu,%lu,%lu,%lu,%lu", (unsigned long)st.frames,
+                  (unsigned long)st.resyncs, (unsigned long)st.skipped,
+                  (unsigned long)st.crc_fail, (unsigned long)st.partial_drops);
 }
 
 void lora_instance_deinit(void) {
@@ -1469,9 +1527,10 @@ void lora_instance_deinit(void) {
 
  
 
-  // 7. RTCM 재조립 버퍼 초기화
+  // 7. RTCM 재조립 링 / 수신 줄 조립기 초기화
 
-  memset(&instance.rtcm_reassembly, 0, sizeof(instance.rtcm_reassembly));
+  rtcm_reasm_init(&instance.rtcm_reasm, RTCM_REASSEMBLY_TIMEOUT_MS);
+  lora_line_init(&instance.rx_line);
  
   led_set_color(3, LED_COLOR_NONE);
   led_set_state(3, false);
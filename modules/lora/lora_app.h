@@ -2,6 +2,8 @@
 #define LORA_APP_H
 
 #include "lora.h"
+#include "lora_airtime.h"
+#include "rtcm_reasm.h"
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "semphr.h"
@@ -20,19 +22,11 @@ typedef struct {
 } lora_p2p_recv_data_t;
 
 /**
- * @brief RTCM fragment 재조립 버퍼
+ * @brief RTCM fragment 재조립 타임아웃 (마지막 수신 후 이 시간이 지나면 미완성 데이터 버림)
  */
-#define RTCM_REASSEMBLY_BUF_SIZE 512
 #define RTCM_REASSEMBLY_TIMEOUT_MS 5000  // 5초 타임아웃
 
-typedef struct {
-  
-  uint8_t buffer[RTCM_REASSEMBLY_BUF_SIZE];  // 재조립 버퍼
-  uint16_t buffer_pos;                        // 현재 버퍼 위치
-  uint16_t expected_len;                      // 예상 RTCM 패킷 전체 길이
-  bool has_header;                            // 헤더 수신 완료 여부
-  TickType_t last_recv_tick;                  // 마지막 수신 시간
-} rtcm_reassembly_t;
+#define LORA_P2P_RAW_MAX 118 // at+send=lorap2p 한 번에 보내는 최대 binary (HEX 변환 시 236 문자)
 
 void lora_start_tx_test(void);
 /**
@@ -55,13 +49,14 @@ typedef void (*lora_command_callback_t)(bool success, void *user_data);
  * @brief LoRa 명령어 요청 구조체
  */
 typedef struct {
-  char cmd[256];                  // 전송할 AT 명령어
+  char cmd[256];                  // 전송할 AT 명령어 (raw_len > 0 이면 binary payload)
+  uint8_t raw_len;                // P2P binary payload 길이 (TX Task 가 at+send 프레임으로 변환)
   uint32_t timeout_ms;            // 타임아웃 (ms)
   uint32_t toa_ms;                // Time on Air (ms) - OK 응답 후 추가 대기 시간
   bool is_async;                  // true: 비동기, false: 동기
   bool skip_response;             // true: 응답 파싱 건너뛰기 (명령어만 전송)
 
-  SemaphoreHandle_t response_sem; // 응답 대기용 세마포어
+  SemaphoreHandle_t response_sem; // 동기 요청 처리 완료 알림용 세마포어 (비동기는 NULL)
   bool *result;                   // 동기 응답 결과 (true: OK, false: ERROR/TIMEOUT)
 
   lora_command_callback_t callback; // 비동기 완료 콜백
@@ -172,7 +167,7 @@ bool lora_send_p2p_raw(const uint8_t *data, size_t len, uint32_t timeout_ms);
 /**
  * @brief LoRa P2P Raw Binary 데이터 전송 (비동기)
  *
- * Binary 데이터를 HEX ASCII로 변환하여 비동기 전송
+ * Binary 데이터를 큐에 넣고, TX Task 가 앞 프레임 전송 중에 HEX ASCII로 변환해 보낸다.
  * 최대 118바이트까지 전송 가능 (HEX 변환 시 236 문자)
  *
  * @param data 전송할 raw binary 데이터
@@ -199,6 +194,112 @@ void lora_set_p2p_recv_callback(lora_p2p_recv_callback_t callback, void *user_da
  * @return lora_t* LoRa 핸들
  */
 lora_t *lora_get_handle(void);
+
+/**
+ * @brief LoRa TX 부하
+ */
+typedef struct {
+  uint8_t queue_depth; // TX 명령어 큐에 대기 중인 요청 수
+  uint8_t queue_size;  // TX 명령어 큐 크기
+  uint32_t busy_ms;    // TX Task 가 명령어 처리(ToA 대기 포함)에 쓴 누적 시간 (ms)
+} lora_tx_load_t;
+
+/**
+ * @brief P2P 전송 응답 통계
+ *
+ * 응답 지연은 AT 명령어 전송 시작부터 OK 수신까지.
+ */
+typedef struct {
+  uint32_t sent;             // 응답을 기다린 P2P 전송 수
+  uint32_t ok;               // OK 응답
+  uint32_t error;            // ERROR 응답
+  uint32_t timeout;          // 응답 없이 타임아웃
+  uint32_t early_ok;         // ToA 가 지나기 전에 온 OK (모듈이 TX 완료 전에 응답)
+  uint32_t ok_ms_sum;        // OK 지연 합 (평균 = ok_ms_sum / ok)
+  uint32_t ok_ms_last;       // 마지막 OK 지연 [ms]
+  uint32_t ok_ms_max;        // 최대 OK 지연 [ms]
+  uint32_t ok_full_ms_max;   // 최대 길이 (118 byte) 전송의 최대 OK 지연 [ms]
+  uint32_t ok_excess_ms_max; // OK 지연 - ToA 최대값 [ms]
+} lora_tx_stats_t;
+
+/**
+ * @brief LoRa TX 부하 조회
+ *
+ * busy_ms 는 누적값이므로 두 시점의 차이로 점유율을 구한다.
+ *
+ * @param load 결과
+ */
+void lora_get_tx_load(lora_tx_load_t *load);
+
+/**
+ * @brief 현재 P2P 설정 (SF/BW/CR/preamble) 에서 payload 의 Time on Air
+ *
+ * 모듈은 at+send=lorap2p 의 HEX 문자열을 binary 로 바꿔 보내므로 binary 길이를 넣는다.
+ *
+ * @param len payload 길이 [byte]
+ * @return ToA [ms] (올림)
+ */
+uint32_t lora_p2p_toa_ms(size_t len);
+
+/**
+ * @brief at+send 명령어 하나가 OK 를 받을 때까지 걸리는 예상 시간
+ *
+ * ToA 와 UART 전송 시간의 합과, 실측값 (118 byte 에 350ms) 을 길이로 비례한
+ * 값 중 큰 쪽. 모듈 처리 시간이 ToA 계산에 드러나지 않으므로 실측값이 하한이다.
+ *
+ * @param len payload 길이 [byte]
+ * @return 예상 시간 [ms]
+ */
+uint32_t lora_p2p_send_ms(size_t len);
+
+/**
+ * @brief len byte 를 지금 보내도 시간당 duty cycle 한도 안인지 확인
+ *
+ * @return false: 한도 초과, 나중에 다시 시도
+ */
+bool lora_p2p_airtime_allow(size_t len);
+
+/**
+ * @brief airtime 장부 (최근 1분/1시간) 조회
+ */
+void lora_get_airtime_stats(lora_airtime_stats_t *stats);
+
+/**
+ * @brief airtime 통계 한 줄
+ *
+ * minute_ms,hour_ms,minute_permille,hour_permille,limit_permille,total_ms,frames,deferred
+ *
+ * @return snprintf 결과
+ */
+int lora_format_airtime_stats(char *buf, size_t size);
+
+/**
+ * @brief P2P 전송 응답 통계 조회
+ */
+void lora_get_tx_stats(lora_tx_stats_t *stats);
+
+/**
+ * @brief P2P 전송 응답 통계 한 줄
+ *
+ * sent,ok,error,timeout,early_ok,ok_ms_avg,ok_ms_max,ok_full_ms_max,ok_excess_ms_max
+ *
+ * @return snprintf 결과
+ */
+int lora_format_tx_stats(char *buf, size_t size);
+
+/**
+ * @brief rover RTCM 재조립 통계 조회
+ */
+void lora_get_rtcm_rx_stats(rtcm_reasm_stats_t *stats);
+
+/**
+ * @brief RTCM 재조립 통계 한 줄
+ *
+ * frames,resyncs,skipped,crc_fail,partial_drops
+ *
+ * @return snprintf 결과
+ */
+int lora_format_rtcm_rx_stats(char *buf, size_t size);
 void lora_instance_deinit(void);
 void lora_start_rover(void);
 #endif
@@ -14,6 +14,8 @@
 #include "gsm_app.h"
 #include "gsm.h"
 #include "lte_init.h"
+#include "capture.h"
+#include "rtcm.h"
 
 #ifndef TAG
 #define TAG "RS485_APP"
@@ -259,8 +261,16 @@ void RS485_Send(uint8_t *data, uint8_t len)
   xSemaphoreTake(rs485_tx_mutex, portMAX_DELAY);
 
   RS485_SetTransmitMode();
-  SoftUartPuts(0, data, len);
-  SoftUartWaitUntilTxComplate(0);
+  // soft UART TX 버퍼보다 긴 응답 (+GPSSTAT 등) 은 나눠서 전송
+  while (len > 0)
+  {
+    uint8_t n = len > SoftUartTxBufferSize ? SoftUartTxBufferSize : len;
+
+    SoftUartPuts(0, data, n);
+    SoftUartWaitUntilTxComplate(0);
+    data += n;
+    len -= n;
+  }
   RS485_SetReceiveMode();
 
   xSemaphoreGive(rs485_tx_mutex);
@@ -389,6 +399,104 @@ static void rs485_task(void *pvParameter)
         RS485_Send((uint8_t *)GPSMANUF_F9P_Response, strlen(GPSMANUF_F9P_Response));
       }
     }
+    else if (strcmp(rx_buffer, "AT+GPSSTAT?\r") == 0)
+    {
+      // GPS 별 파서 통계 (gps_format_parser_stats 포맷) 한 줄씩
+      char stats[224];
+      char resp[240];
+
+      for (gps_id_t id = 0; id < GPS_ID_MAX; id++)
+      {
+        if (gps_format_parser_stats(id, stats, sizeof(stats)) < 0)
+        {
+          continue;
+        }
+
+        snprintf(resp, sizeof(resp), "+GPSSTAT=%s\r", stats);
+        RS485_Send((uint8_t *)resp, strlen(resp));
+      }
+    }
+    else if (strcmp(rx_buffer, "AT+RTCMSTAT?\r") == 0)
+    {
+      // 기지국 RTCM epoch 묶음 전송 통계 (rtcm_format_tx_stats 포맷)
+      char stats[96];
+      char resp[112];
+
+      if (rtcm_format_tx_stats(stats, sizeof(stats)) < 0)
+      {
+        RS485_Send((uint8_t *)ERROR3_Response, strlen(ERROR3_Response));
+      }
+      else
+      {
+        snprintf(resp, sizeof(resp), "+RTCMSTAT=%s\r", stats);
+        RS485_Send((uint8_t *)resp, strlen(resp));
+      }
+    }
+    else if (strcmp(rx_buffer, "AT+LORAAIR?\r") == 0)
+    {
+      // LoRa airtime 장부 최근 1분/1시간 (lora_format_airtime_stats 포맷)
+      char stats[96];
+      char resp[112];
+
+      lora_format_airtime_stats(stats, sizeof(stats));
+      snprintf(resp, sizeof(resp), "+LORAAIR=%s\r", stats);
+      RS485_Send((uint8_t *)resp, strlen(resp));
+    }
+    else if (strcmp(rx_buffer, "AT+LORATX?\r") == 0)
+    {
+      // LoRa P2P 전송 응답 통계 (lora_format_tx_stats 포맷)
+      char stats[112];
+      char resp[128];
+
+      lora_format_tx_stats(stats, sizeof(stats));
+      snprintf(resp, sizeof(resp), "+LORATX=%s\r", stats);
+      RS485_Send((uint8_t *)resp, strlen(resp));
+    }
+    else if (strcmp(rx_buffer, "AT+LORARX?\r") == 0)
+    {
+      // rover RTCM 재조립 통계 (lora_format_rtcm_rx_stats 포맷)
+      char stats[64];
+      char resp[80];
+
+      lora_format_rtcm_rx_stats(stats, sizeof(stats));
+      snprintf(resp, sizeof(resp), "+LORARX=%s\r", stats);
+      RS485_Send((uint8_t *)resp, strlen(resp));
+    }
+    else if (strcmp(rx_buffer, "AT+CAP?\r") == 0)
+    {
+      // 캡처 상태 (capture_format_info 포맷)
+      char info[64];
+
+      capture_format_info(info, sizeof(info));
+      snprintf(buf, sizeof(buf), "+CAP=%s\r", info);
+      RS485_Send((uint8_t *)buf, strlen(buf));
+    }
+    else if (strncmp(rx_buffer, "AT+CAP=", 7) == 0)
+    {
+      // 캡처 시작 (소스 mask, 0: 끔)
+      capture_start((uint16_t)strtoul(rx_buffer + 7, NULL, 0));
+      RS485_Send((uint8_t *)AT_Response, strlen(AT_Response));
+    }
+    else if (strcmp(rx_buffer, "AT+CAPTRIG\r") == 0)
+    {
+      capture_trigger(CAPTURE_REASON_CMD);
+      RS485_Send((uint8_t *)AT_Response, strlen(AT_Response));
+    }
+    else if (strcmp(rx_buffer, "AT+CAPSTOP\r") == 0)
+    {
+      capture_stop();
+      RS485_Send((uint8_t *)AT_Response, strlen(AT_Response));
+    }
+    else if (strncmp(rx_buffer, "AT+CAPREAD=", 11) == 0)
+    {
+      // 멈춘 캡처 한 줄 (offset,hex), 끝이면 hex 가 비어 있음
+      char line[2 * CAPTURE_LINE_BYTES + 12];
+      char resp[2 * CAPTURE_LINE_BYTES + 24];
+
+      capture_format_line(strtoul(rx_buffer + 11, NULL, 10), line, sizeof(line));
+      snprintf(resp, sizeof(resp), "+CAPREAD=%s\r", line);
+      RS485_Send((uint8_t *)resp, strlen(resp));
+    }
     else if (strcmp(rx_buffer, "AT+CONFIG?\r") == 0)
     {
       // RS485_Send((uint8_t*)CONFIG_Response, strlen(CONFIG_Response));